@@ -78,9 +78,14 @@ example1: example1.cpp
 example2: example2.cpp
 	$(CXX) $(CXXFLAGS)  -o $@  $<  $(LIB_FLAGS)
 
+## compares the matrix multiplication used without BLAS against the previous kernel;
+## not built by default; use "make benchmark_gemm"
+benchmark_gemm: benchmark_gemm.cpp
+	$(CXX) $(CXXFLAGS)  -o $@  $<  $(LIB_FLAGS)
+
 
 .PHONY: clean
 
 clean:
-	rm -f example1 example2
+	rm -f example1 example2 benchmark_gemm
 
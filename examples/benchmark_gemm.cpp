@@ -0,0 +1,71 @@
+// Compares the blocked matrix multiplication used when no BLAS library is available
+// (gemm_emul_large::apply_blocked) against the previous dot-product kernel (gemm_emul_large::apply_dot).
+// 
+// Usage: benchmark_gemm [max_size]
+
+#include <iostream>
+#include <cstdlib>
+
+#include "armadillo"
+
+using namespace arma;
+using namespace std;
+
+
+template<typename eT>
+void
+run_benchmark(const char* type_name, const uword max_size)
+  {
+  cout << endl << type_name << endl;
+  cout << "     size     dot (s)   blocked (s)   speedup   max abs diff" << endl;
+  
+  for(uword size = 64; size <= max_size; size *= 2)
+    {
+    const Mat<eT> A = randu< Mat<eT> >(size, size);
+    const Mat<eT> B = randu< Mat<eT> >(size, size);
+    
+    Mat<eT> C_dot(size, size);
+    Mat<eT> C_blocked(size, size);
+    
+    // repeat the smaller multiplications so that each timing covers a similar amount of work
+    const uword n_reps = (std::max)( uword(1), uword( (512*512*512) / (size*size*size) ) );
+    
+    wall_clock timer;
+    
+    timer.tic();
+    for(uword rep=0; rep < n_reps; ++rep)
+      {
+      gemm_emul_large<false, false, false, false>::apply_dot(C_dot, A, B, eT(1), eT(0));
+      }
+    const double t_dot = timer.toc() / double(n_reps);
+    
+    timer.tic();
+    for(uword rep=0; rep < n_reps; ++rep)
+      {
+      gemm_emul_large<false, false, false, false>::apply_blocked(C_blocked, A, B, eT(1), eT(0));
+      }
+    const double t_blocked = timer.toc() / double(n_reps);
+    
+    cout.width(9);   cout << size;
+    cout.width(12);  cout << t_dot;
+    cout.width(14);  cout << t_blocked;
+    cout.width(10);  cout << (t_dot / t_blocked);
+    cout.width(15);  cout << max(max(abs(C_dot - C_blocked)));
+    cout << endl;
+    }
+  }
+
+
+
+int main(int argc, char** argv)
+  {
+  cout << "Armadillo version: " << arma_version::as_string() << endl;
+  
+  const uword max_size = (argc > 1) ? uword( std::atoi(argv[1]) ) : uword(1024);
+  
+  run_benchmark<double>("double", max_size);
+  run_benchmark<float> ("float",  max_size);
+  
+  return 0;
+  }
+
@@ -328,6 +328,7 @@ class Cube : public BaseCube< eT, Cube<eT> >
   inline void create_mat();
   
   friend class glue_join;
+  friend class glue_cube_times;
   friend class op_reshape;
   friend class op_resize;
   
@@ -45,8 +45,8 @@ Gen<T1, gen_type>::generate()
   
        if(is_same_type<gen_type, gen_ones_full>::value == true) { return eT(1);                   }
   else if(is_same_type<gen_type, gen_zeros    >::value == true) { return eT(0);                   }
-  else if(is_same_type<gen_type, gen_randu    >::value == true) { return eT(eop_aux_randu<eT>()); }
-  else if(is_same_type<gen_type, gen_randn    >::value == true) { return eT(eop_aux_randn<eT>()); }
+  else if(is_same_type<gen_type, gen_randu    >::value == true) { return eT(arma_rng::randu<eT>()); }
+  else if(is_same_type<gen_type, gen_randn    >::value == true) { return eT(arma_rng::randn<eT>()); }
   else                                                          { return eT();                    }
   }
 
@@ -37,8 +37,8 @@ class Glue : public Base<typename T1::elem_type, Glue<T1, T2, glue_type> >
   typedef typename T1::elem_type                   elem_type;
   typedef typename get_pod_type<elem_type>::result pod_type;
   
-  static const bool is_row = (is_same_type<glue_type, glue_times>::value) ? T1::is_row : false;
-  static const bool is_col = (is_same_type<glue_type, glue_times>::value) ? T2::is_col : false;
+  static const bool is_row = (is_same_type<glue_type, glue_times>::value || is_same_type<glue_type, glue_times_plus>::value) ? T1::is_row : false;
+  static const bool is_col = (is_same_type<glue_type, glue_times>::value) ? T2::is_col : ( (is_same_type<glue_type, glue_times_plus>::value) ? T1::is_col : false );
   
   arma_inline  Glue(const T1& in_A, const T2& in_B);
   arma_inline  Glue(const T1& in_A, const T2& in_B, const uword in_aux_uword);
@@ -557,6 +557,7 @@ class Mat : public Base< eT, Mat<eT> >
   
   friend class Cube<eT>;
   friend class glue_join;
+  friend class glue_cube_times;
   friend class op_strans;
   friend class op_htrans;
   friend class op_resize;
@@ -4659,24 +4659,7 @@ Mat<eT>::randu()
   {
   arma_extra_debug_sigprint();
   
-  const uword N   = n_elem;
-        eT*   ptr = memptr();
-  
-  uword ii,jj;
-  
-  for(ii=0, jj=1; jj < N; ii+=2, jj+=2)
-    {
-    const eT tmp_ii = eT(eop_aux_randu<eT>());
-    const eT tmp_jj = eT(eop_aux_randu<eT>());
-    
-    ptr[ii] = tmp_ii;
-    ptr[jj] = tmp_jj;
-    }
-  
-  if(ii < N)
-    {
-    ptr[ii] = eT(eop_aux_randu<eT>());
-    }
+  arma_rng::randu<eT>::fill(memptr(), n_elem);
   
   return *this;
   }
@@ -4718,13 +4701,7 @@ Mat<eT>::randn()
   {
   arma_extra_debug_sigprint();
   
-  const uword N   = n_elem;
-        eT*   ptr = memptr();
-  
-  for(uword ii=0; ii<N; ++ii)
-    {
-    ptr[ii] = eT(eop_aux_randn<eT>());
-    }
+  arma_rng::randn<eT>::fill(memptr(), n_elem);
   
   return *this;
   }
@@ -257,6 +257,94 @@ class Proxy< Gen<T1, gen_type > >
 
 
 
+#if defined(ARMA_USE_OPENMP)
+
+//! when OpenMP is enabled, random values are generated into a matrix, so that expressions evaluated by several threads
+//! do not draw values from per-thread generators, and give the same result as a serial evaluation
+template<typename T1>
+class Proxy< Gen<T1, gen_randu > >
+  {
+  public:
+  
+  typedef typename T1::elem_type                   elem_type;
+  typedef typename get_pod_type<elem_type>::result pod_type;
+  typedef Mat<elem_type>                           stored_type;
+  typedef const elem_type*                         ea_type;
+  
+  static const bool prefer_at_accessor = false;
+  static const bool has_subview        = false;
+  static const bool is_fixed           = false;
+  static const bool fake_mat           = false;
+  
+  static const bool is_row = Gen<T1, gen_randu>::is_row;
+  static const bool is_col = Gen<T1, gen_randu>::is_col;
+  
+  arma_aligned const Mat<elem_type> Q;
+  
+  inline explicit Proxy(const Gen<T1, gen_randu>& A)
+    : Q(A)
+    {
+    arma_extra_debug_sigprint();
+    }
+  
+  arma_inline uword get_n_rows() const { return is_row ? 1 : Q.n_rows; }
+  arma_inline uword get_n_cols() const { return is_col ? 1 : Q.n_cols; }
+  arma_inline uword get_n_elem() const { return Q.n_elem;              }
+  
+  arma_inline elem_type operator[] (const uword i)                    const { return Q[i];           }
+  arma_inline elem_type at         (const uword row, const uword col) const { return Q.at(row, col); }
+  
+  arma_inline ea_type get_ea() const { return Q.memptr(); }
+  
+  template<typename eT2>
+  arma_inline bool is_alias(const Mat<eT2>&) const { return false; }
+  };
+
+
+
+template<typename T1>
+class Proxy< Gen<T1, gen_randn > >
+  {
+  public:
+  
+  typedef typename T1::elem_type                   elem_type;
+  typedef typename get_pod_type<elem_type>::result pod_type;
+  typedef Mat<elem_type>                           stored_type;
+  typedef const elem_type*                         ea_type;
+  
+  static const bool prefer_at_accessor = false;
+  static const bool has_subview        = false;
+  static const bool is_fixed           = false;
+  static const bool fake_mat           = false;
+  
+  static const bool is_row = Gen<T1, gen_randn>::is_row;
+  static const bool is_col = Gen<T1, gen_randn>::is_col;
+  
+  arma_aligned const Mat<elem_type> Q;
+  
+  inline explicit Proxy(const Gen<T1, gen_randn>& A)
+    : Q(A)
+    {
+    arma_extra_debug_sigprint();
+    }
+  
+  arma_inline uword get_n_rows() const { return is_row ? 1 : Q.n_rows; }
+  arma_inline uword get_n_cols() const { return is_col ? 1 : Q.n_cols; }
+  arma_inline uword get_n_elem() const { return Q.n_elem;              }
+  
+  arma_inline elem_type operator[] (const uword i)                    const { return Q[i];           }
+  arma_inline elem_type at         (const uword row, const uword col) const { return Q.at(row, col); }
+  
+  arma_inline ea_type get_ea() const { return Q.memptr(); }
+  
+  template<typename eT2>
+  arma_inline bool is_alias(const Mat<eT2>&) const { return false; }
+  };
+
+#endif
+
+
+
 template<typename T1, typename op_type>
 class Proxy< Op<T1, op_type> >
   {
@@ -533,6 +621,12 @@ class Proxy< Glue<T1, T2, glue_type> >
     {
     arma_extra_debug_sigprint();
     }
+  
+  //! used by Proxy_fused, which evaluates the expression only when it can't be fused with an element-wise operation
+  inline Proxy(const Glue<T1, T2, glue_type>&, const arma_fused_indicator&)
+    {
+    arma_extra_debug_sigprint();
+    }
 
   arma_inline uword get_n_rows() const { return is_row ? 1 : Q.n_rows; }
   arma_inline uword get_n_cols() const { return is_col ? 1 : Q.n_cols; }
@@ -820,6 +914,8 @@ class Proxy< eOp<T1, eop_type > >
     : Q(A)
     {
     arma_extra_debug_sigprint();
+    
+    proxy_fused_prepare(Q.P);
     }
   
   arma_inline uword get_n_rows() const { return is_row ? 1 : Q.get_n_rows(); }
@@ -0,0 +1,468 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+
+//! \addtogroup Proxy_fused
+//! @{
+
+
+
+//! Proxy for the product of two matrices (optionally with an added matrix) held by eOp, eg. exp(A*B + C).
+//! The product is not evaluated when the Proxy is constructed:
+//! if the eOp is assigned to a matrix, the element-wise operation is applied by glue_times::apply_fused()
+//! to blocks of the result of the multiplication while they are still in cache;
+//! in all other cases, prepare() evaluates the product into Q before any elements are accessed.
+
+template<typename T1, typename T2>
+class Proxy_fused< Glue<T1, T2, glue_times> > : public Proxy< Glue<T1, T2, glue_times> >
+  {
+  public:
+  
+  typedef typename T1::elem_type elem_type;
+  
+  static const bool has_subview = true;  // the operands of the product are held by reference
+  
+  static const bool do_trans_A = partial_unwrap<T1>::do_trans;
+  static const bool do_trans_B = partial_unwrap<T2>::do_trans;
+  static const bool use_alpha  = partial_unwrap<T1>::do_times || partial_unwrap<T2>::do_times;
+  
+  static const bool is_row = Glue<T1, T2, glue_times>::is_row;
+  static const bool is_col = Glue<T1, T2, glue_times>::is_col;
+  
+  arma_aligned const partial_unwrap<T1> U1;
+  arma_aligned const partial_unwrap<T2> U2;
+  
+  inline explicit Proxy_fused(const Glue<T1, T2, glue_times>& X);
+  
+  arma_inline uword get_n_rows() const { return is_row ? 1 : ( (do_trans_A == false) ? U1.M.n_rows : U1.M.n_cols ); }
+  arma_inline uword get_n_cols() const { return is_col ? 1 : ( (do_trans_B == false) ? U2.M.n_cols : U2.M.n_rows ); }
+  arma_inline uword get_n_elem() const { return get_n_rows() * get_n_cols(); }
+  
+  template<typename eT2>
+  arma_inline bool is_alias(const Mat<eT2>& X) const { return proxy_fused_overlap(U1.M, X) || proxy_fused_overlap(U2.M, X); }
+  
+  inline elem_type operator[] (const uword i)                    const;
+  inline elem_type at         (const uword row, const uword col) const;
+  
+  inline const elem_type* get_ea() const;
+  
+  arma_inline bool is_prepared() const;
+  
+  inline void prepare() const;
+  
+  template<typename eop_type>
+  inline void apply(Mat<elem_type>& out, const elem_type aux) const;
+  
+  
+  private:
+  
+  typedef Proxy< Glue<T1, T2, glue_times> > Proxy_base;
+  
+  //! hides Proxy_base::Q, which holds the product only after prepare(); elements must be accessed via the functions above
+  void Q() const;
+  };
+
+
+
+//! Proxy for A*B + C held by eOp; see above
+template<typename T1, typename T2, typename T3>
+class Proxy_fused< Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus> > : public Proxy< Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus> >
+  {
+  public:
+  
+  typedef typename T1::elem_type elem_type;
+  
+  static const bool has_subview = true;  // the operands are held by reference
+  
+  static const bool do_trans_A = partial_unwrap<T1>::do_trans;
+  static const bool do_trans_B = partial_unwrap<T2>::do_trans;
+  static const bool use_alpha  = partial_unwrap<T1>::do_times || partial_unwrap<T2>::do_times;
+  
+  static const bool is_row = Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus>::is_row;
+  static const bool is_col = Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus>::is_col;
+  
+  arma_aligned const partial_unwrap<T1> U1;
+  arma_aligned const partial_unwrap<T2> U2;
+  arma_aligned const unwrap<T3>         U3;
+  
+  inline explicit Proxy_fused(const Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus>& X);
+  
+  arma_inline uword get_n_rows() const { return is_row ? 1 : U3.M.n_rows; }
+  arma_inline uword get_n_cols() const { return is_col ? 1 : U3.M.n_cols; }
+  arma_inline uword get_n_elem() const { return U3.M.n_elem;              }
+  
+  template<typename eT2>
+  arma_inline bool is_alias(const Mat<eT2>& X) const { return proxy_fused_overlap(U1.M, X) || proxy_fused_overlap(U2.M, X) || proxy_fused_overlap(U3.M, X); }
+  
+  inline elem_type operator[] (const uword i)                    const;
+  inline elem_type at         (const uword row, const uword col) const;
+  
+  inline const elem_type* get_ea() const;
+  
+  arma_inline bool is_prepared() const;
+  
+  inline void prepare() const;
+  
+  template<typename eop_type>
+  inline void apply(Mat<elem_type>& out, const elem_type aux) const;
+  
+  
+  private:
+  
+  typedef Proxy< Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus> > Proxy_base;
+  
+  //! hides Proxy_base::Q, which holds the product only after prepare(); elements must be accessed via the functions above
+  void Q() const;
+  };
+
+
+
+//! eop_proxy<T1,eop_type>::result is the type used by eOp to hold an operand of type T1:
+//! Proxy_fused for products of two matrices (optionally with an added matrix), Proxy for everything else.
+//! Longer chains of multiplications are left to glue_times::apply_chain(), which chooses the order of evaluation,
+//! while eop_scalar_times and eop_neg are excluded as partial_unwrap and as_scalar() access the evaluated product directly.
+
+template<typename T1, bool use_fused>
+struct eop_proxy_redirect {};
+
+template<typename T1>
+struct eop_proxy_redirect<T1, false> { typedef Proxy<T1>       result; };
+
+template<typename T1>
+struct eop_proxy_redirect<T1, true>  { typedef Proxy_fused<T1> result; };
+
+
+
+template<typename T1, typename eop_type>
+struct eop_proxy
+  {
+  typedef Proxy<T1> result;
+  };
+
+
+
+template<typename T1, typename T2, typename eop_type>
+struct eop_proxy< Glue<T1, T2, glue_times>, eop_type >
+  {
+  static const bool use_fused = \
+       (is_glue_times<T1>::value == false)
+    && (is_glue_times<T2>::value == false)
+    && (is_same_type<eop_type, eop_scalar_times>::value == false)
+    && (is_same_type<eop_type, eop_neg>::value == false);
+  
+  typedef typename eop_proxy_redirect< Glue<T1, T2, glue_times>, use_fused >::result result;
+  };
+
+
+
+template<typename T1, typename T2, typename T3, typename eop_type>
+struct eop_proxy< Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus>, eop_type >
+  {
+  static const bool use_fused = \
+       (is_same_type<eop_type, eop_scalar_times>::value == false)
+    && (is_same_type<eop_type, eop_neg>::value == false);
+  
+  typedef typename eop_proxy_redirect< Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus>, use_fused >::result result;
+  };
+
+
+
+//! true if the memory of M overlaps with the memory of X (M may be a view of part of X, see partial_unwrap)
+template<typename eT, typename eT2>
+arma_inline
+bool
+proxy_fused_overlap(const Mat<eT>& M, const Mat<eT2>& X)
+  {
+  const void* M_start = M.memptr();
+  const void* M_end   = M.memptr() + M.n_elem;
+  
+  const void* X_start = X.memptr();
+  const void* X_end   = X.memptr() + X.n_elem;
+  
+  return (void_ptr(&M) == void_ptr(&X)) || ( (M.n_elem > 0) && (X.n_elem > 0) && (M_start < X_end) && (X_start < M_end) );
+  }
+
+
+
+//! evaluate the operand of an eOp, if its evaluation was deferred by Proxy_fused
+template<typename T1>
+arma_inline
+void
+proxy_fused_prepare(const Proxy<T1>&)
+  {
+  }
+
+
+
+template<typename T1>
+inline
+void
+proxy_fused_prepare(const Proxy_fused<T1>& P)
+  {
+  P.prepare();
+  }
+
+
+
+//! out = eop_type(P), with the element-wise operation fused with the evaluation of the product held by P;
+//! returns false if the operand isn't held by Proxy_fused or has already been evaluated
+template<typename eop_type, typename T1>
+arma_inline
+bool
+proxy_fused_apply(Mat<typename T1::elem_type>&, const Proxy<T1>&, const typename T1::elem_type)
+  {
+  return false;
+  }
+
+
+
+template<typename eop_type, typename T1>
+inline
+bool
+proxy_fused_apply(Mat<typename T1::elem_type>& out, const Proxy_fused<T1>& P, const typename T1::elem_type aux)
+  {
+  if(P.is_prepared() == true)
+    {
+    return false;
+    }
+  
+  P.template apply<eop_type>(out, aux);
+  
+  return true;
+  }
+
+
+
+// 
+// Proxy_fused< Glue<T1, T2, glue_times> >
+
+
+
+template<typename T1, typename T2>
+inline
+Proxy_fused< Glue<T1, T2, glue_times> >::Proxy_fused(const Glue<T1, T2, glue_times>& X)
+  : Proxy< Glue<T1, T2, glue_times> >(X, arma_fused_indicator())
+  , U1(X.A)
+  , U2(X.B)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_assert_mul_size(U1.M, U2.M, do_trans_A, do_trans_B, "matrix multiplication");
+  }
+
+
+
+template<typename T1, typename T2>
+inline
+typename T1::elem_type
+Proxy_fused< Glue<T1, T2, glue_times> >::operator[] (const uword i) const
+  {
+  arma_debug_check( (is_prepared() == false), "Proxy_fused: product accessed before it was evaluated" );
+  
+  return Proxy_base::Q[i];
+  }
+
+
+
+template<typename T1, typename T2>
+inline
+typename T1::elem_type
+Proxy_fused< Glue<T1, T2, glue_times> >::at(const uword row, const uword col) const
+  {
+  arma_debug_check( (is_prepared() == false), "Proxy_fused: product accessed before it was evaluated" );
+  
+  return Proxy_base::Q.at(row, col);
+  }
+
+
+
+//! evaluates the product if this hasn't been done yet
+template<typename T1, typename T2>
+inline
+const typename T1::elem_type*
+Proxy_fused< Glue<T1, T2, glue_times> >::get_ea() const
+  {
+  prepare();
+  
+  return Proxy_base::Q.memptr();
+  }
+
+
+
+template<typename T1, typename T2>
+arma_inline
+bool
+Proxy_fused< Glue<T1, T2, glue_times> >::is_prepared() const
+  {
+  return (Proxy_base::Q.n_elem == get_n_elem()) && (Proxy_base::Q.n_elem > 0);
+  }
+
+
+
+template<typename T1, typename T2>
+inline
+void
+Proxy_fused< Glue<T1, T2, glue_times> >::prepare() const
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  if(is_prepared() == false)
+    {
+    Mat<eT>& out = access::rw(Proxy_base::Q);
+    
+    out.set_size(get_n_rows(), get_n_cols());
+    
+    const eT alpha = use_alpha ? (U1.get_val() * U2.get_val()) : eT(0);
+    
+    glue_times::apply_fused<eT, do_trans_A, do_trans_B, use_alpha, false>(out, U1.M, U2.M, alpha, eT(0), glue_times_epilogue<eT>(NULL));
+    }
+  }
+
+
+
+template<typename T1, typename T2>
+template<typename eop_type>
+inline
+void
+Proxy_fused< Glue<T1, T2, glue_times> >::apply(Mat<typename T1::elem_type>& out, const typename T1::elem_type aux) const
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const eT alpha = use_alpha ? (U1.get_val() * U2.get_val()) : eT(0);
+  
+  glue_times::apply_fused<eT, do_trans_A, do_trans_B, use_alpha, false>(out, U1.M, U2.M, alpha, eT(0), glue_times_epilogue_eop<eT, eop_type>(NULL, aux));
+  }
+
+
+
+// 
+// Proxy_fused< Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus> >
+
+
+
+template<typename T1, typename T2, typename T3>
+inline
+Proxy_fused< Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus> >::Proxy_fused(const Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus>& X)
+  : Proxy< Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus> >(X, arma_fused_indicator())
+  , U1(X.A.A)
+  , U2(X.A.B)
+  , U3(X.B)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_assert_mul_size(U1.M, U2.M, do_trans_A, do_trans_B, "matrix multiplication");
+  
+  arma_debug_assert_same_size
+    (
+    (do_trans_A == false) ? U1.M.n_rows : U1.M.n_cols,
+    (do_trans_B == false) ? U2.M.n_cols : U2.M.n_rows,
+    U3.M.n_rows,
+    U3.M.n_cols,
+    "addition"
+    );
+  }
+
+
+
+template<typename T1, typename T2, typename T3>
+inline
+typename T1::elem_type
+Proxy_fused< Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus> >::operator[] (const uword i) const
+  {
+  arma_debug_check( (is_prepared() == false), "Proxy_fused: product accessed before it was evaluated" );
+  
+  return Proxy_base::Q[i];
+  }
+
+
+
+template<typename T1, typename T2, typename T3>
+inline
+typename T1::elem_type
+Proxy_fused< Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus> >::at(const uword row, const uword col) const
+  {
+  arma_debug_check( (is_prepared() == false), "Proxy_fused: product accessed before it was evaluated" );
+  
+  return Proxy_base::Q.at(row, col);
+  }
+
+
+
+//! evaluates the product if this hasn't been done yet
+template<typename T1, typename T2, typename T3>
+inline
+const typename T1::elem_type*
+Proxy_fused< Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus> >::get_ea() const
+  {
+  prepare();
+  
+  return Proxy_base::Q.memptr();
+  }
+
+
+
+template<typename T1, typename T2, typename T3>
+arma_inline
+bool
+Proxy_fused< Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus> >::is_prepared() const
+  {
+  return (Proxy_base::Q.n_elem == get_n_elem()) && (Proxy_base::Q.n_elem > 0);
+  }
+
+
+
+template<typename T1, typename T2, typename T3>
+inline
+void
+Proxy_fused< Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus> >::prepare() const
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  if(is_prepared() == false)
+    {
+    Mat<eT>& out = access::rw(Proxy_base::Q);
+    
+    out.set_size(U3.M.n_rows, U3.M.n_cols);
+    
+    const eT alpha = use_alpha ? (U1.get_val() * U2.get_val()) : eT(0);
+    
+    glue_times::apply_fused<eT, do_trans_A, do_trans_B, use_alpha, false>(out, U1.M, U2.M, alpha, eT(0), glue_times_epilogue<eT>(U3.M.memptr()));
+    }
+  }
+
+
+
+template<typename T1, typename T2, typename T3>
+template<typename eop_type>
+inline
+void
+Proxy_fused< Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus> >::apply(Mat<typename T1::elem_type>& out, const typename T1::elem_type aux) const
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const eT alpha = use_alpha ? (U1.get_val() * U2.get_val()) : eT(0);
+  
+  glue_times::apply_fused<eT, do_trans_A, do_trans_B, use_alpha, false>(out, U1.M, U2.M, alpha, eT(0), glue_times_epilogue_eop<eT, eop_type>(U3.M.memptr(), aux));
+  }
+
+
+
+//! @}
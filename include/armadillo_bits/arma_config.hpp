@@ -1,5 +1,5 @@
-// Copyright (C) 2008-2011 NICTA (www.nicta.com.au)
-// Copyright (C) 2008-2011 Conrad Sanderson
+// Copyright (C) 2008-2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2008-2012 Conrad Sanderson
 // 
 // This file is part of the Armadillo C++ library.
 // It is provided without any warranty of fitness
@@ -24,6 +24,12 @@ struct arma_config
     static const uword mat_prealloc = 16;
   #endif
   
+  #if defined(ARMA_MEM_ALIGNMENT)
+    static const uword mem_alignment = (uword(ARMA_MEM_ALIGNMENT) >= 16) ? uword(ARMA_MEM_ALIGNMENT) : 16;
+  #else
+    static const uword mem_alignment = 64;
+  #endif
+  
   #if defined(ARMA_USE_ATLAS)
     static const bool atlas = true;
   #else
@@ -45,6 +51,20 @@ struct arma_config
   #endif
 
 
+  #if defined(ARMA_USE_OPENMP)
+    static const bool openmp = true;
+  #else
+    static const bool openmp = false;
+  #endif
+  
+  
+  #if defined(ARMA_OPENMP_THRESHOLD)
+    static const uword mp_threshold = (sword(ARMA_OPENMP_THRESHOLD) > 0) ? uword(ARMA_OPENMP_THRESHOLD) : 1;
+  #else
+    static const uword mp_threshold = 65536;
+  #endif
+  
+  
   #if defined(ARMA_USE_BOOST)
     static const bool boost = true;
   #else
@@ -0,0 +1,497 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup arma_dtoa
+//! @{
+
+
+
+//! \brief
+//! Conversion of floating point numbers to text, using the shortest representation
+//! that is read back (eg. via strtod()) as exactly the same number.
+//! The digits are generated by the Grisu2 algorithm (F. Loitsch, "Printing floating-point numbers
+//! quickly and accurately with integers", PLDI 2010), which in rare cases produces one more digit than necessary.
+class arma_dtoa
+  {
+  public:
+  
+  static const uword max_len = 32;  //!< upper bound on the number of characters written by format()
+  
+  template<typename eT> inline static char* format(char* out, const eT val);
+  
+  
+  private:
+  
+  #if ULONG_MAX >= 0xffffffffffffffff
+    typedef unsigned long      u64_type;
+  #else
+    typedef unsigned long long u64_type;
+  #endif
+  
+  //! floating point number without the implied leading bit: value = f * 2^e
+  struct diyfp
+    {
+    u64_type f;
+    int      e;
+    
+    inline diyfp(const u64_type in_f, const int in_e) : f(in_f), e(in_e) {}
+    };
+  
+  //! normalised 64 bit approximation of 10^k, as f * 2^e
+  struct cached_power
+    {
+    u32 f_hi;
+    u32 f_lo;
+    int e;
+    int k;
+    };
+  
+  template<typename eT> inline static u64_type get_bits(const eT val);
+  template<typename eT> inline static void     boundaries(diyfp& w, diyfp& w_minus, diyfp& w_plus, const u64_type F, const int E);
+  
+  inline static diyfp mul(const diyfp& x, const diyfp& y);
+  inline static diyfp normalise(diyfp x);
+  
+  inline static const cached_power& get_cached_power(const int e);
+  
+  inline static void grisu2(char* digits, int& n_digits, int& dec_exp, const diyfp& w, const diyfp& w_minus, const diyfp& w_plus);
+  inline static void round_last(char* digits, const int n_digits, const u64_type dist, const u64_type delta, u64_type rest, const u64_type ten_k);
+  
+  inline static char* format_digits(char* out, const char* digits, const int n_digits, const int dec_exp);
+  };
+
+
+
+template<typename eT>
+inline
+char*
+arma_dtoa::format(char* out, const eT val)
+  {
+  const int n_mantissa = std::numeric_limits<eT>::digits;  // including the implied bit
+  
+  const u64_type bits     = arma_dtoa::get_bits(val);
+  const u64_type mantissa = bits & ( (u64_type(1) << (n_mantissa - 1)) - 1 );
+  const u64_type exponent = (bits >> (n_mantissa - 1)) & u64_type(std::numeric_limits<eT>::max_exponent * 2 - 1);
+  
+  const bool is_neg = ( (bits >> (sizeof(eT)*8 - 1)) != 0 );
+  
+  if( (exponent == u64_type(std::numeric_limits<eT>::max_exponent * 2 - 1)) && (mantissa != 0) )
+    {
+    out[0] = 'n';  out[1] = 'a';  out[2] = 'n';
+    
+    return (out + 3);
+    }
+  
+  if(is_neg)
+    {
+    *out = '-';
+    ++out;
+    }
+  
+  if(exponent == u64_type(std::numeric_limits<eT>::max_exponent * 2 - 1))
+    {
+    out[0] = 'i';  out[1] = 'n';  out[2] = 'f';
+    
+    return (out + 3);
+    }
+  
+  if( (exponent == 0) && (mantissa == 0) )
+    {
+    *out = '0';
+    
+    return (out + 1);
+    }
+  
+  diyfp w(0,0);
+  diyfp w_minus(0,0);
+  diyfp w_plus(0,0);
+  
+  arma_dtoa::boundaries<eT>(w, w_minus, w_plus, mantissa, int(exponent));
+  
+  char digits[20];
+  int  n_digits = 0;
+  int  dec_exp  = 0;
+  
+  arma_dtoa::grisu2(digits, n_digits, dec_exp, w, w_minus, w_plus);
+  
+  return arma_dtoa::format_digits(out, digits, n_digits, dec_exp);
+  }
+
+
+
+//! the binary representation of a float or double
+template<typename eT>
+inline
+arma_dtoa::u64_type
+arma_dtoa::get_bits(const eT val)
+  {
+  if(sizeof(eT) == sizeof(u32))
+    {
+    u32 bits;
+    std::memcpy(&bits, &val, sizeof(u32));
+    
+    return u64_type(bits);
+    }
+  else
+    {
+    u64_type bits;
+    std::memcpy(&bits, &val, sizeof(u64_type));
+    
+    return bits;
+    }
+  }
+
+
+
+//! find the normalised value w of a positive finite non-zero number with the given mantissa field F and exponent field E,
+//! as well as the boundaries of the interval of numbers that are rounded to it;
+//! w_minus and w_plus share the exponent of w
+template<typename eT>
+inline
+void
+arma_dtoa::boundaries(diyfp& w, diyfp& w_minus, diyfp& w_plus, const u64_type F, const int E)
+  {
+  const int      n_mantissa = std::numeric_limits<eT>::digits;
+  const int      bias       = std::numeric_limits<eT>::max_exponent - 1 + (n_mantissa - 1);
+  const u64_type hidden_bit = u64_type(1) << (n_mantissa - 1);
+
+const diyfp v = (E == 0) ? diyfp(F, 1 - bias) : diyfp(F + hidden_bit, E - bias);
+
+  // the interval is asymmetric at powers of two, except for the smallest normal number
+  const bool lower_is_closer = (F == 0) && (E > 1);
+  
+  const diyfp m_plus  = diyfp(2*v.f + 1, v.e - 1);
+  const diyfp m_minus = (lower_is_closer) ? diyfp(4*v.f - 1, v.e - 2) : diyfp(2*v.f - 1, v.e - 1);
+  
+  w_plus  = arma_dtoa::normalise(m_plus);
+  w       = arma_dtoa::normalise(v);
+  w_minus = diyfp(m_minus.f << (m_minus.e - w_plus.e), w_plus.e);
+  }
+
+
+
+//! upper 64 bits of the 128 bit product, rounded
+inline
+arma_dtoa::diyfp
+arma_dtoa::mul(const diyfp& x, const diyfp& y)
+  {
+  const u64_type mask = 0xFFFFFFFF;
+  
+  const u64_type x_lo = x.f & mask;
+  const u64_type x_hi = x.f >> 32;
+  const u64_type y_lo = y.f & mask;
+  const u64_type y_hi = y.f >> 32;
+  
+  const u64_type p0 = x_lo * y_lo;
+  const u64_type p1 = x_lo * y_hi;
+  const u64_type p2 = x_hi * y_lo;
+  const u64_type p3 = x_hi * y_hi;
+  
+  const u64_type mid = (p0 >> 32) + (p1 & mask) + (p2 & mask) + (u64_type(1) << 31);
+  
+  return diyfp( p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32), x.e + y.e + 64 );
+  }
+
+
+
+inline
+arma_dtoa::diyfp
+arma_dtoa::normalise(diyfp x)
+  {
+  const u64_type top_bit = u64_type(1) << 63;
+  
+  while( (x.f & top_bit) == 0 )
+    {
+    x.f <<= 1;
+    x.e  -= 1;
+    }
+  
+  return x;
+  }
+
+
+
+//! find a cached power of ten c = f * 2^e_c, such that the binary exponent of c times a number with binary exponent e
+//! is in the range [-60,-32]; this allows the integer and fractional parts of the product to be split cheaply
+inline
+const arma_dtoa::cached_power&
+arma_dtoa::get_cached_power(const int e)
+  {
+  // 10^k for k = -300, -292, ..., 324
+  static const cached_power table[] =
+    {
+    { 0xAB70FE17, 0xC79AC6CA, -1060, -300 },
+    { 0xFF77B1FC, 0xBEBCDC4F, -1034, -292 },
+    { 0xBE5691EF, 0x416BD60C, -1007, -284 },
+    { 0x8DD01FAD, 0x907FFC3C,  -980, -276 },
+    { 0xD3515C28, 0x31559A83,  -954, -268 },
+    { 0x9D71AC8F, 0xADA6C9B5,  -927, -260 },
+    { 0xEA9C2277, 0x23EE8BCB,  -901, -252 },
+    { 0xAECC4991, 0x4078536D,  -874, -244 },
+    { 0x823C1279, 0x5DB6CE57,  -847, -236 },
+    { 0xC2109436, 0x4DFB5637,  -821, -228 },
+    { 0x9096EA6F, 0x3848984F,  -794, -220 },
+    { 0xD77485CB, 0x25823AC7,  -768, -212 },
+    { 0xA086CFCD, 0x97BF97F4,  -741, -204 },
+    { 0xEF340A98, 0x172AACE5,  -715, -196 },
+    { 0xB23867FB, 0x2A35B28E,  -688, -188 },
+    { 0x84C8D4DF, 0xD2C63F3B,  -661, -180 },
+    { 0xC5DD4427, 0x1AD3CDBA,  -635, -172 },
+    { 0x936B9FCE, 0xBB25C996,  -608, -164 },
+    { 0xDBAC6C24, 0x7D62A584,  -582, -156 },
+    { 0xA3AB6658, 0x0D5FDAF6,  -555, -148 },
+    { 0xF3E2F893, 0xDEC3F126,  -529, -140 },
+    { 0xB5B5ADA8, 0xAAFF80B8,  -502, -132 },
+    { 0x87625F05, 0x6C7C4A8B,  -475, -124 },
+    { 0xC9BCFF60, 0x34C13053,  -449, -116 },
+    { 0x964E858C, 0x91BA2655,  -422, -108 },
+    { 0xDFF97724, 0x70297EBD,  -396, -100 },
+    { 0xA6DFBD9F, 0xB8E5B88F,  -369,  -92 },
+    { 0xF8A95FCF, 0x88747D94,  -343,  -84 },
+    { 0xB9447093, 0x8FA89BCF,  -316,  -76 },
+    { 0x8A08F0F8, 0xBF0F156B,  -289,  -68 },
+    { 0xCDB02555, 0x653131B6,  -263,  -60 },
+    { 0x993FE2C6, 0xD07B7FAC,  -236,  -52 },
+    { 0xE45C10C4, 0x2A2B3B06,  -210,  -44 },
+    { 0xAA242499, 0x697392D3,  -183,  -36 },
+    { 0xFD87B5F2, 0x8300CA0E,  -157,  -28 },
+    { 0xBCE50864, 0x92111AEB,  -130,  -20 },
+    { 0x8CBCCC09, 0x6F5088CC,  -103,  -12 },
+    { 0xD1B71758, 0xE219652C,   -77,   -4 },
+    { 0x9C400000, 0x00000000,   -50,    4 },
+    { 0xE8D4A510, 0x00000000,   -24,   12 },
+    { 0xAD78EBC5, 0xAC620000,     3,   20 },
+    { 0x813F3978, 0xF8940984,    30,   28 },
+    { 0xC097CE7B, 0xC90715B3,    56,   36 },
+    { 0x8F7E32CE, 0x7BEA5C70,    83,   44 },
+    { 0xD5D238A4, 0xABE98068,   109,   52 },
+    { 0x9F4F2726, 0x179A2245,   136,   60 },
+    { 0xED63A231, 0xD4C4FB27,   162,   68 },
+    { 0xB0DE6538, 0x8CC8ADA8,   189,   76 },
+    { 0x83C7088E, 0x1AAB65DB,   216,   84 },
+    { 0xC45D1DF9, 0x42711D9A,   242,   92 },
+    { 0x924D692C, 0xA61BE758,   269,  100 },
+    { 0xDA01EE64, 0x1A708DEA,   295,  108 },
+    { 0xA26DA399, 0x9AEF774A,   322,  116 },
+    { 0xF209787B, 0xB47D6B85,   348,  124 },
+    { 0xB454E4A1, 0x79DD1877,   375,  132 },
+    { 0x865B8692, 0x5B9BC5C2,   402,  140 },
+    { 0xC83553C5, 0xC8965D3D,   428,  148 },
+    { 0x952AB45C, 0xFA97A0B3,   455,  156 },
+    { 0xDE469FBD, 0x99A05FE3,   481,  164 },
+    { 0xA59BC234, 0xDB398C25,   508,  172 },
+    { 0xF6C69A72, 0xA3989F5C,   534,  180 },
+    { 0xB7DCBF53, 0x54E9BECE,   561,  188 },
+    { 0x88FCF317, 0xF22241E2,   588,  196 },
+    { 0xCC20CE9B, 0xD35C78A5,   614,  204 },
+    { 0x98165AF3, 0x7B2153DF,   641,  212 },
+    { 0xE2A0B5DC, 0x971F303A,   667,  220 },
+    { 0xA8D9D153, 0x5CE3B396,   694,  228 },
+    { 0xFB9B7CD9, 0xA4A7443C,   720,  236 },
+    { 0xBB764C4C, 0xA7A44410,   747,  244 },
+    { 0x8BAB8EEF, 0xB6409C1A,   774,  252 },
+    { 0xD01FEF10, 0xA657842C,   800,  260 },
+    { 0x9B10A4E5, 0xE9913129,   827,  268 },
+    { 0xE7109BFB, 0xA19C0C9D,   853,  276 },
+    { 0xAC2820D9, 0x623BF429,   880,  284 },
+    { 0x80444B5E, 0x7AA7CF85,   907,  292 },
+    { 0xBF21E440, 0x03ACDD2D,   933,  300 },
+    { 0x8E679C2F, 0x5E44FF8F,   960,  308 },
+    { 0xD433179D, 0x9C8CB841,   986,  316 },
+    { 0x9E19DB92, 0xB4E31BA9,  1013,  324 },
+    };
+  
+  const int f = -60 - e - 1;
+  const int k = (f * 78913) / (1 << 18) + ( (f > 0) ? 1 : 0 );  // approximately ceil(f * log10(2))
+  
+  return table[ (300 + k + 7) / 8 ];
+  }
+
+
+
+inline
+void
+arma_dtoa::grisu2(char* digits, int& n_digits, int& dec_exp, const diyfp& w, const diyfp& w_minus, const diyfp& w_plus)
+  {
+  const cached_power& cached = arma_dtoa::get_cached_power(w_plus.e);
+  
+  const diyfp c( (u64_type(cached.f_hi) << 32) | u64_type(cached.f_lo), cached.e );
+  
+  const diyfp c_w       = arma_dtoa::mul(w,       c);
+  const diyfp c_w_minus = arma_dtoa::mul(w_minus, c);
+  const diyfp c_w_plus  = arma_dtoa::mul(w_plus,  c);
+  
+  // shrink the interval by one unit on each side, to allow for the rounding error in mul()
+  const u64_type lo = c_w_minus.f + 1;
+  const u64_type hi = c_w_plus.f  - 1;
+  
+  const int shift = -c_w_plus.e;   // in the range [32,60]
+  
+  const u64_type one_f = u64_type(1) << shift;
+  
+  u64_type delta = hi - lo;
+  u64_type dist  = hi - c_w.f;
+  
+  u32      p1 = u32(hi >> shift);       // integer part, non-zero
+  u64_type p2 = hi & (one_f - 1);       // fractional part
+  
+  dec_exp  = -cached.k;
+  n_digits = 0;
+  
+  u32 pow10 = 1;
+  int n     = 1;
+  
+  while( (n < 10) && (p1 >= pow10*10) )
+    {
+    pow10 *= 10;
+    ++n;
+    }
+  
+  while(n > 0)
+    {
+    digits[n_digits] = char('0' + p1 / pow10);
+    ++n_digits;
+    
+    p1 %= pow10;
+    --n;
+    
+    const u64_type rest = (u64_type(p1) << shift) + p2;
+    
+    if(rest <= delta)
+      {
+      dec_exp += n;
+      
+      arma_dtoa::round_last(digits, n_digits, dist, delta, rest, u64_type(pow10) << shift);
+      
+      return;
+      }
+    
+    pow10 /= 10;
+    }
+  
+  int m = 0;
+  
+  for(;;)
+    {
+    p2 *= 10;
+    
+    digits[n_digits] = char('0' + (p2 >> shift));
+    ++n_digits;
+    
+    p2 &= (one_f - 1);
+    ++m;
+    
+    delta *= 10;
+    dist  *= 10;
+    
+    if(p2 <= delta)  { break; }
+    }
+  
+  dec_exp -= m;
+  
+  arma_dtoa::round_last(digits, n_digits, dist, delta, p2, one_f);
+  }
+
+
+
+//! move the generated number towards the exact value, while keeping it within the rounding interval
+inline
+void
+arma_dtoa::round_last(char* digits, const int n_digits, const u64_type dist, const u64_type delta, u64_type rest, const u64_type ten_k)
+  {
+  while( (rest < dist) && (delta - rest >= ten_k) && ( (rest + ten_k < dist) || (dist - rest > rest + ten_k - dist) ) )
+    {
+    digits[n_digits-1]--;
+    rest += ten_k;
+    }
+  }
+
+
+
+//! write the number digits * 10^dec_exp in fixed notation if it is of moderate size, or in scientific notation otherwise
+inline
+char*
+arma_dtoa::format_digits(char* out, const char* digits, const int n_digits, const int dec_exp)
+  {
+  const int point = n_digits + dec_exp;  // position of the decimal point relative to the first digit
+  
+  if( (n_digits <= point) && (point <= 15) )
+    {
+    // integer: 1234000
+    
+    std::memcpy(out, digits, size_t(n_digits));
+    std::memset(out + n_digits, '0', size_t(point - n_digits));
+    
+    return (out + point);
+    }
+  
+  if( (0 < point) && (point <= 15) )
+    {
+    // 1234.567
+    
+    std::memcpy(out, digits, size_t(point));
+    out[point] = '.';
+    std::memcpy(out + point + 1, digits + point, size_t(n_digits - point));
+    
+    return (out + n_digits + 1);
+    }
+  
+  if( (-5 < point) && (point <= 0) )
+    {
+    // 0.001234
+    
+    out[0] = '0';
+    out[1] = '.';
+    std::memset(out + 2, '0', size_t(-point));
+    std::memcpy(out + 2 - point, digits, size_t(n_digits));
+    
+    return (out + 2 - point + n_digits);
+    }
+  
+  // 1.234e+56
+  
+  *out = digits[0];
+  ++out;
+  
+  if(n_digits > 1)
+    {
+    *out = '.';
+    std::memcpy(out + 1, digits + 1, size_t(n_digits - 1));
+    out += n_digits;
+    }
+  
+  int exponent = point - 1;
+  
+  out[0] = 'e';
+  out[1] = (exponent < 0) ? '-' : '+';
+  out += 2;
+  
+  if(exponent < 0)  { exponent = -exponent; }
+  
+  if(exponent >= 100)
+    {
+    *out = char('0' + exponent / 100);
+    ++out;
+    
+    exponent %= 100;
+    }
+  
+  out[0] = char('0' + exponent / 10);
+  out[1] = char('0' + exponent % 10);
+  
+  return (out + 2);
+  }
+
+
+
+//! @}
@@ -0,0 +1,1052 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup arma_rng
+//! @{
+
+
+
+//! xoshiro128** generator:
+//! 128 bits of state, period 2^128 - 1, 32 bit output.
+//! D. Blackman and S. Vigna, "Scrambled linear pseudorandom number generators", 2018.
+//! http://prng.di.unimi.it/
+//!
+//! the state is a plain array, so that the generator can be kept in thread local storage.
+//! a replacement engine (see ARMA_RNG_ALT in config.hpp) must provide the same two functions and also be a plain struct.
+class arma_rng_xoshiro
+  {
+  public:
+  
+  u32 s[4];
+  
+  inline void seed(const u32 seed_val, const u32 stream);
+  
+  arma_inline u32 next();
+  
+  arma_inline static u32 rotl(const u32 x, const int k);
+  arma_inline static u32 mix(u32 x);
+  };
+
+
+
+#if defined(ARMA_RNG_ALT)
+  typedef ::arma_rng_alt arma_rng_engine;
+#else
+  typedef arma_rng_xoshiro arma_rng_engine;
+#endif
+
+
+
+//! Threefry-4x32-20 counter-based generator:
+//! maps a 128 bit counter and a 128 bit key to 128 random bits, using only 32 bit additions, rotations and exclusive-ors.
+//! J.K. Salmon, M.A. Moraes, R.O. Dror, D.E. Shaw, "Parallel random numbers: as easy as 1, 2, 3", SC 2011.
+//!
+//! as any part of the sequence for a given key can be generated without generating the rest,
+//! matrices can be filled by several threads with exactly the same result as a serial fill.
+class arma_rng_threefry
+  {
+  public:
+  
+  inline explicit arma_rng_threefry(const u32* key);
+  
+  arma_inline void generate(u32* out, const u32 c0, const u32 c1, const u32 c2, const u32 c3) const;
+  
+  
+  private:
+  
+  u32 ks[5];  //!< the key, followed by its parity word
+  
+  arma_inline static u32  rotl(const u32 x, const int k);
+  
+  arma_inline static void rounds_a(u32& x0, u32& x1, u32& x2, u32& x3);
+  arma_inline static void rounds_b(u32& x0, u32& x1, u32& x2, u32& x3);
+  
+  arma_inline void inject(u32& x0, u32& x1, u32& x2, u32& x3, const u32 s) const;
+  };
+
+
+
+//! words from the counters (index, index_hi, 1, 1), (index, index_hi, 2, 1), ...
+//! preceded by two given words; provides the interface of an engine for arma_rng::normal()
+class arma_rng_threefry_stream
+  {
+  public:
+  
+  inline arma_rng_threefry_stream(const arma_rng_threefry& in_gen, const uword index, const u32 a, const u32 b);
+  
+  arma_inline u32 next();
+  
+  
+  private:
+  
+  const arma_rng_threefry& gen;
+  
+  u32   c0;
+  u32   c1;
+  u32   c2;
+  u32   buf[4];
+  uword pos;
+  };
+
+
+
+//! tables for the ziggurat method with 128 layers;
+//! x[i] is the right edge of layer i and r[i] = x[i+1] / x[i].
+//! a template is used so that the tables can be defined in a header.
+template<typename junk>
+struct arma_rng_zig
+  {
+  static const double x[129];
+  static const double r[128];
+  };
+
+
+
+//! random number generation for randu(), randn() and related functions.
+//!
+//! each thread has its own engine, which is seeded from the global seed and the stream number of the thread.
+//! the stream number is the OpenMP thread number at the first use of the engine, and 0 outside of OpenMP;
+//! it can be changed via set_stream(), eg. for threads not created by OpenMP.
+//! set_seed() reseeds the engines of all threads (each at its next use), and hence should not be called while other threads use random numbers.
+//!
+//! matrices and cubes are filled via arma_rng_threefry, keyed by words drawn from the engine of the calling thread;
+//! element i is a function of only the key and i, so the fill is parallelised via OpenMP for large matrices,
+//! and the result does not depend on the number of threads.
+class arma_rng
+  {
+  public:
+  
+  typedef u32 seed_type;
+  
+  inline static void set_seed(const seed_type val);
+  inline static void set_seed_random();
+  inline static void set_stream(const u32 stream_id);
+  
+  template<typename eT> struct randu;
+  template<typename eT> struct randn;
+  
+  struct thread_state
+    {
+    arma_rng_engine engine;
+    u32             generation;  //!< value of global_generation() when the engine was last seeded
+    u32             stream;
+    bool            valid;       //!< false until the engine is seeded for the first time
+    };
+  
+  inline static thread_state& get_thread_state();
+  
+  inline static seed_type& global_seed();
+  inline static u32&       global_generation();
+  
+  arma_inline static double to_double(const u32 a, const u32 b);
+  arma_inline static float  to_float(const u32 a);
+  arma_inline static u32    hi_word(const uword i);
+  
+  template<typename engine_type> arma_inline static double uniform(engine_type& engine);
+  template<typename engine_type> arma_inline static double uniform_open(engine_type& engine);
+  template<typename engine_type> inline      static double normal(engine_type& engine);
+  template<typename engine_type> inline      static double normal_tail(engine_type& engine, const bool negative);
+  
+  template<typename engine_type>                arma_inline static void draw_u(engine_type& engine, float&  out);
+  template<typename engine_type>                arma_inline static void draw_u(engine_type& engine, double& out);
+  template<typename engine_type, typename eT>   arma_inline static void draw_u(engine_type& engine, eT&     out);
+  
+  inline static void counter_key(u32* key);
+  
+  template<typename eT> inline static void fill_u(const arma_rng_threefry& gen, eT* mem, const uword N);
+  
+  template<typename eT> inline static void fill_u_blocks(const arma_rng_threefry& gen, eT*    mem, const uword j_start, const uword j_end);
+                        inline static void fill_u_blocks(const arma_rng_threefry& gen, float* mem, const uword j_start, const uword j_end);
+  
+  template<typename eT> inline static uword fill_u_block_size(const eT*   );
+                        inline static uword fill_u_block_size(const float*);
+  template<typename eT> inline static void fill_n(const arma_rng_threefry& gen, eT*    mem, const uword N);
+  
+  arma_inline static double normal_at(const arma_rng_threefry& gen, const uword i, const u32 a, const u32 b);
+  };
+
+
+
+//! uniformly distributed random values in the [0,1) interval;
+//! integer types are generated via double precision values
+template<typename eT>
+struct arma_rng::randu
+  {
+  inline operator eT ();
+  
+  inline static void fill(eT* mem, const uword N);
+  };
+
+
+
+template<typename T>
+struct arma_rng::randu< std::complex<T> >
+  {
+  inline operator std::complex<T> ();
+  
+  inline static void fill(std::complex<T>* mem, const uword N);
+  };
+
+
+
+//! normally distributed random values with zero mean and unit variance
+template<typename eT>
+struct arma_rng::randn
+  {
+  inline operator eT ();
+  
+  inline static void fill(eT* mem, const uword N);
+  };
+
+
+
+template<typename T>
+struct arma_rng::randn< std::complex<T> >
+  {
+  inline operator std::complex<T> ();
+  
+  inline static void fill(std::complex<T>* mem, const uword N);
+  };
+
+
+
+// 
+// arma_rng_xoshiro
+
+
+
+//! the first two words of the state are a bijective function of (seed_val, stream),
+//! hence different seeds or streams always give different (and non-zero) states
+inline
+void
+arma_rng_xoshiro::seed(const u32 seed_val, const u32 stream)
+  {
+  s[0] = mix(seed_val + u32(0x9e3779b9));
+  s[1] = mix( (stream + u32(0x7f4a7c15)) ^ s[0] );
+  s[2] = mix( s[0]    + u32(0x3c6ef372) ) ^ s[1];
+  s[3] = mix( s[1]    + u32(0xdaa66d2b) ) ^ s[0];
+  
+  // discard the first few outputs, so that similar seeds do not give similar initial outputs
+  for(uword i=0; i<8; ++i)
+    {
+    next();
+    }
+  }
+
+
+
+arma_inline
+u32
+arma_rng_xoshiro::next()
+  {
+  const u32 result = rotl(s[1] * u32(5), 7) * u32(9);
+  
+  const u32 t = s[1] << 9;
+  
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  
+  s[2] ^= t;
+  
+  s[3] = rotl(s[3], 11);
+  
+  return result;
+  }
+
+
+
+arma_inline
+u32
+arma_rng_xoshiro::rotl(const u32 x, const int k)
+  {
+  return (x << k) | (x >> (32 - k));
+  }
+
+
+
+//! finalisation step of MurmurHash3
+arma_inline
+u32
+arma_rng_xoshiro::mix(u32 x)
+  {
+  x ^= x >> 16;
+  x *= u32(0x85ebca6b);
+  x ^= x >> 13;
+  x *= u32(0xc2b2ae35);
+  x ^= x >> 16;
+  
+  return x;
+  }
+
+
+
+// 
+// arma_rng_threefry
+
+
+
+inline
+arma_rng_threefry::arma_rng_threefry(const u32* key)
+  {
+  ks[0] = key[0];
+  ks[1] = key[1];
+  ks[2] = key[2];
+  ks[3] = key[3];
+  ks[4] = u32(0x1bd11bda) ^ key[0] ^ key[1] ^ key[2] ^ key[3];
+  }
+
+
+
+arma_inline
+u32
+arma_rng_threefry::rotl(const u32 x, const int k)
+  {
+  return (x << k) | (x >> (32 - k));
+  }
+
+
+
+//! four rounds with the first half of the rotation constants
+arma_inline
+void
+arma_rng_threefry::rounds_a(u32& x0, u32& x1, u32& x2, u32& x3)
+  {
+  x0 += x1;  x1 = rotl(x1,10) ^ x0;  x2 += x3;  x3 = rotl(x3,26) ^ x2;
+  x0 += x3;  x3 = rotl(x3,11) ^ x0;  x2 += x1;  x1 = rotl(x1,21) ^ x2;
+  x0 += x1;  x1 = rotl(x1,13) ^ x0;  x2 += x3;  x3 = rotl(x3,27) ^ x2;
+  x0 += x3;  x3 = rotl(x3,23) ^ x0;  x2 += x1;  x1 = rotl(x1, 5) ^ x2;
+  }
+
+
+
+//! four rounds with the second half of the rotation constants
+arma_inline
+void
+arma_rng_threefry::rounds_b(u32& x0, u32& x1, u32& x2, u32& x3)
+  {
+  x0 += x1;  x1 = rotl(x1, 6) ^ x0;  x2 += x3;  x3 = rotl(x3,20) ^ x2;
+  x0 += x3;  x3 = rotl(x3,17) ^ x0;  x2 += x1;  x1 = rotl(x1,11) ^ x2;
+  x0 += x1;  x1 = rotl(x1,25) ^ x0;  x2 += x3;  x3 = rotl(x3,10) ^ x2;
+  x0 += x3;  x3 = rotl(x3,18) ^ x0;  x2 += x1;  x1 = rotl(x1,20) ^ x2;
+  }
+
+
+
+//! key injection number s
+arma_inline
+void
+arma_rng_threefry::inject(u32& x0, u32& x1, u32& x2, u32& x3, const u32 s) const
+  {
+  x0 += ks[ s    % 5];
+  x1 += ks[(s+1) % 5];
+  x2 += ks[(s+2) % 5];
+  x3 += ks[(s+3) % 5] + s;
+  }
+
+
+
+arma_inline
+void
+arma_rng_threefry::generate(u32* out, const u32 c0, const u32 c1, const u32 c2, const u32 c3) const
+  {
+  u32 x0 = c0 + ks[0];
+  u32 x1 = c1 + ks[1];
+  u32 x2 = c2 + ks[2];
+  u32 x3 = c3 + ks[3];
+  
+  rounds_a(x0,x1,x2,x3);  inject(x0,x1,x2,x3, 1);
+  rounds_b(x0,x1,x2,x3);  inject(x0,x1,x2,x3, 2);
+  rounds_a(x0,x1,x2,x3);  inject(x0,x1,x2,x3, 3);
+  rounds_b(x0,x1,x2,x3);  inject(x0,x1,x2,x3, 4);
+  rounds_a(x0,x1,x2,x3);  inject(x0,x1,x2,x3, 5);
+  
+  out[0] = x0;
+  out[1] = x1;
+  out[2] = x2;
+  out[3] = x3;
+  }
+
+
+
+// 
+// arma_rng_threefry_stream
+
+
+
+inline
+arma_rng_threefry_stream::arma_rng_threefry_stream(const arma_rng_threefry& in_gen, const uword index, const u32 a, const u32 b)
+  : gen(in_gen)
+  , c0 (u32(index))
+  , c1 (arma_rng::hi_word(index))
+  , c2 (0)
+  , pos(2)
+  {
+  buf[2] = a;
+  buf[3] = b;
+  }
+
+
+
+arma_inline
+u32
+arma_rng_threefry_stream::next()
+  {
+  if(pos == 4)
+    {
+    ++c2;
+    
+    gen.generate(buf, c0, c1, c2, 1);
+    
+    pos = 0;
+    }
+  
+  return buf[pos++];
+  }
+
+
+
+// 
+// arma_rng_zig
+
+
+
+template<typename junk>
+const double arma_rng_zig<junk>::x[129] =
+  {
+  3.71308624674255050e+00, 3.44261985589900021e+00, 3.22308498458114157e+00, 3.08322885821686832e+00,
+  2.97869625264778026e+00, 2.89434400702152894e+00, 2.82312535054891045e+00, 2.76116937238717686e+00,
+  2.70611357312181955e+00, 2.65640641126135968e+00, 2.61097224843184739e+00, 2.56903362592493778e+00,
+  2.53000967238882746e+00, 2.49345452209537211e+00, 2.45901817741183049e+00, 2.42642064553374981e+00,
+  2.39543427801106246e+00, 2.36587137011763859e+00, 2.33757524133923678e+00, 2.31041368369876299e+00,
+  2.28427405967747177e+00, 2.25905957386919853e+00, 2.23468639559097948e+00, 2.21108140887870341e+00,
+  2.18818043207604918e+00, 2.16592679374892194e+00, 2.14427018236039535e+00, 2.12316570867397658e+00,
+  2.10257313518923850e+00, 2.08245623799201685e+00, 2.06278227450830842e+00, 2.04352153665506764e+00,
+  2.02464697337738553e+00, 2.00613386996347209e+00, 1.98795957412761992e+00, 1.97010326085432652e+00,
+  1.95254572955355665e+00, 1.93526922829662285e+00, 1.91825730086450985e+00, 1.90149465310515109e+00,
+  1.88496703570775903e+00, 1.86866114099448866e+00, 1.85256451172809111e+00, 1.83666546025844601e+00,
+  1.82095299659612553e+00, 1.80541676421922848e+00, 1.79004698259985862e+00, 1.77483439558606948e+00,
+  1.75977022489959345e+00, 1.74484612811380035e+00, 1.73005416056373051e+00, 1.71538674071366759e+00,
+  1.70083661856991686e+00, 1.68639684677916812e+00, 1.67206075409760091e+00, 1.65782192095402414e+00,
+  1.64367415686286855e+00, 1.62961147947063467e+00, 1.61562809504316096e+00, 1.60171838022137814e+00,
+  1.58787686489057611e+00, 1.57409821602300082e+00, 1.56037722236616894e+00, 1.54670877985991040e+00,
+  1.53308787767404331e+00, 1.51950958476594011e+00, 1.50596903686320327e+00, 1.49246142378135405e+00,
+  1.47898197698992417e+00, 1.46552595734271085e+00, 1.45208864288922457e+00, 1.43866531668456354e+00,
+  1.42525125451406010e+00, 1.41184171244705770e+00, 1.39843191413100532e+00, 1.38501703773265183e+00,
+  1.37159220242734259e+00, 1.35815245433014353e+00, 1.34469275175354697e+00, 1.33120794966562728e+00,
+  1.31769278320941408e+00, 1.30414185012861683e+00, 1.29054959192619645e+00, 1.27691027356015563e+00,
+  1.26321796145462106e+00, 1.24946649957306821e+00, 1.23564948326336266e+00, 1.22176023053999638e+00,
+  1.20779175041594966e+00, 1.19373670783312869e+00, 1.17958738466398816e+00, 1.16533563616475244e+00,
+  1.15097284214886741e+00, 1.13648985201316077e+00, 1.12187692258254224e+00, 1.10712364753403603e+00,
+  1.09221887690727737e+00, 1.07715062489289570e+00, 1.06190596369482426e+00, 1.04647090076404536e+00,
+  1.03083023606819557e+00, 1.01496739525133051e+00, 9.98864233492983589e-01, 9.82500803515429011e-01,
+  9.65855079401149896e-01, 9.48902625511306441e-01, 9.31616196615150827e-01, 9.13965251023032277e-01,
+  8.95915352580937685e-01, 8.77427429112923374e-01, 8.58456843193813213e-01, 8.38952214297577381e-01,
+  8.18853906700357292e-01, 7.98092060644056911e-01, 7.76583987894759908e-01, 7.54230664454055622e-01,
+  7.30911910642488838e-01, 7.06479611335436464e-01, 6.80747918669154628e-01, 6.53478638739975248e-01,
+  6.24358597336050702e-01, 5.92962942471448318e-01, 5.58692178408185192e-01, 5.20656038762060569e-01,
+  4.77437837296689815e-01, 4.26547986355423514e-01, 3.62871431097031960e-01, 2.72320864813964669e-01,
+  0.00000000000000000e+00
+  };
+
+
+
+template<typename junk>
+const double arma_rng_zig<junk>::r[128] =
+  {
+  9.27158602609668092e-01, 9.36230289573889207e-01, 9.56607992952922870e-01, 9.66096384544888220e-01,
+  9.71681487982780978e-01, 9.75393852182102172e-01, 9.78054117168517756e-01, 9.80060694640488950e-01,
+  9.81631531523964540e-01, 9.82896381127186580e-01, 9.83937545666332514e-01, 9.84809870473353444e-01,
+  9.85551379232894376e-01, 9.86189303081973612e-01, 9.86743679986786359e-01, 9.87229597811194348e-01,
+  9.87658643710329631e-01, 9.88039870157017552e-01, 9.88380456312108913e-01, 9.88686171569307826e-01,
+  9.88961707242854482e-01, 9.89210918313024434e-01, 9.89437002543690935e-01, 9.89642635178110464e-01,
+  9.89830071596968786e-01, 9.90001226518352428e-01, 9.90157735783469661e-01, 9.90301005050802541e-01,
+  9.90432248533694382e-01, 9.90552520084321819e-01, 9.90662738335856718e-01, 9.90763707189219578e-01,
+  9.90856132620971941e-01, 9.90940636560718069e-01, 9.91017768416578959e-01, 9.91088014699718745e-01,
+  9.91151807102164994e-01, 9.91209529308184956e-01, 9.91261522762455161e-01, 9.91308091573961381e-01,
+  9.91349506699915395e-01, 9.91386009526675882e-01, 9.91417814943019504e-01, 9.91445113983844717e-01,
+  9.91468076108532936e-01, 9.91486851167012073e-01, 9.91501571097483492e-01, 9.91512351392366598e-01,
+  9.91519292362930682e-01, 9.91522480228064551e-01, 9.91521988048464586e-01, 9.91517876524044217e-01,
+  9.91510194669438683e-01, 9.91498980380005168e-01, 9.91484260898605085e-01, 9.91466053191639496e-01,
+  9.91444364241222842e-01, 9.91419191259001131e-01, 9.91390521825871507e-01, 9.91358333960749682e-01,
+  9.91322596120496558e-01, 9.91283267132149870e-01, 9.91240296057685599e-01, 9.91193621990623996e-01,
+  9.91143173782898956e-01, 9.91088869699480957e-01, 9.91030616997289449e-01, 9.90968311423904069e-01,
+  9.90901836630491251e-01, 9.90831063492146669e-01, 9.90755849327522697e-01, 9.90676037008095478e-01,
+  9.90591453945729450e-01, 9.90501910945236208e-01, 9.90407200906388341e-01, 9.90307097357237986e-01,
+  9.90201352797563050e-01, 9.90089696827713639e-01, 9.89971834033956943e-01, 9.89847441596477862e-01,
+  9.89716166580352552e-01, 9.89577622862819806e-01, 9.89431387641846793e-01, 9.89276997460942220e-01,
+  9.89113943673095242e-01, 9.88941667252041801e-01, 9.88759552841243727e-01, 9.88566921909159735e-01,
+  9.88363024852603411e-01, 9.88147031856945746e-01, 9.87918022280905084e-01, 9.87674972282530983e-01,
+  9.87416740338836418e-01, 9.87142050230599533e-01, 9.86849470961088659e-01, 9.86537392946165492e-01,
+  9.86203999644238993e-01, 9.85847233575538939e-01, 9.85464755394089953e-01, 9.85053894298990707e-01,
+  9.84611587571034730e-01, 9.84134306349457311e-01, 9.83617963854474642e-01, 9.83057801016833710e-01,
+  9.82448242752572809e-01, 9.81782715706112641e-01, 9.81053414854475614e-01, 9.80251001422766666e-01,
+  9.79364207327450553e-01, 9.78379310596331209e-01, 9.77279429885292150e-01, 9.76043560938631538e-01,
+  9.74645237830076394e-01, 9.73050636875224528e-01, 9.71215832686298519e-01, 9.69082729050209202e-01,
+  9.66572853785381825e-01, 9.63577586311879508e-01, 9.59942176565900973e-01, 9.55438418828696179e-01,
+  9.49715347880916272e-01, 9.42204206015937795e-01, 9.31919326748950616e-01, 9.16992797071693122e-01,
+  8.93410519724597618e-01, 8.50716549379434417e-01, 7.50461021388994287e-01, 0.00000000000000000e+00
+  };
+
+
+
+// 
+// arma_rng
+
+
+
+inline
+arma_rng::seed_type&
+arma_rng::global_seed()
+  {
+  static seed_type val;  // zero initialised
+  
+  return val;
+  }
+
+
+
+inline
+u32&
+arma_rng::global_generation()
+  {
+  static u32 val;  // zero initialised
+  
+  return val;
+  }
+
+
+
+inline
+arma_rng::thread_state&
+arma_rng::get_thread_state()
+  {
+  #if defined(arma_thread_local)
+    static arma_thread_local thread_state state;  // zero initialised
+  #else
+    static thread_state state;
+  #endif
+  
+  const u32 generation = global_generation();
+  
+  if( (state.valid == false) || (state.generation != generation) )
+    {
+    if(state.valid == false)
+      {
+      #if defined(ARMA_USE_OPENMP)
+        {
+        state.stream = u32( omp_get_thread_num() );
+        }
+      #else
+        {
+        state.stream = 0;
+        }
+      #endif
+      }
+    
+    state.engine.seed(global_seed(), state.stream);
+    
+    state.generation = generation;
+    state.valid      = true;
+    }
+  
+  return state;
+  }
+
+
+
+//! set the seed used by all threads
+inline
+void
+arma_rng::set_seed(const arma_rng::seed_type val)
+  {
+  global_seed() = val;
+  
+  global_generation()++;
+  }
+
+
+
+//! set the seed from the current time and other sources which vary between runs
+inline
+void
+arma_rng::set_seed_random()
+  {
+  const seed_type seed1 = seed_type( std::time(0) );
+  const seed_type seed2 = seed_type( std::clock() );
+  const seed_type seed3 = seed_type( reinterpret_cast<size_t>(&seed1) );
+  const seed_type seed4 = seed_type( std::rand() );
+  
+  set_seed( arma_rng_xoshiro::mix(seed1) ^ arma_rng_xoshiro::mix(seed2 + u32(0x9e3779b9)) ^ (seed3 >> 4) ^ (seed4 << 16) );
+  }
+
+
+
+//! reseed the engine of the calling thread, using the given stream number and the current global seed
+inline
+void
+arma_rng::set_stream(const u32 stream_id)
+  {
+  thread_state& state = get_thread_state();
+  
+  state.stream = stream_id;
+  
+  state.engine.seed(global_seed(), stream_id);
+  }
+
+
+
+//! uniformly distributed value in the [0,1) interval, with 53 random bits
+arma_inline
+double
+arma_rng::to_double(const u32 a, const u32 b)
+  {
+  return ( double(a >> 5) * 67108864.0 + double(b >> 6) ) * (1.0 / 9007199254740992.0);
+  }
+
+
+
+//! uniformly distributed value in the [0,1) interval, with 24 random bits
+arma_inline
+float
+arma_rng::to_float(const u32 a)
+  {
+  return float(a >> 8) * (1.0f / 16777216.0f);
+  }
+
+
+
+//! upper 32 bits of an index (zero unless ARMA_64BIT_WORD is enabled)
+arma_inline
+u32
+arma_rng::hi_word(const uword i)
+  {
+  return u32( (i >> 16) >> 16 );
+  }
+
+
+
+template<typename engine_type>
+arma_inline
+double
+arma_rng::uniform(engine_type& engine)
+  {
+  const u32 a = engine.next();
+  const u32 b = engine.next();
+  
+  return to_double(a, b);
+  }
+
+
+
+//! uniformly distributed value in the (0,1) interval, suitable for taking logarithms
+template<typename engine_type>
+arma_inline
+double
+arma_rng::uniform_open(engine_type& engine)
+  {
+  const u32 a = engine.next() >> 5;
+  const u32 b = engine.next() >> 6;
+  
+  return ( double(a) * 67108864.0 + double(b) + 0.5 ) * (1.0 / 9007199254740992.0);
+  }
+
+
+
+//! ziggurat method, as described in:
+//! J.A. Doornik, "An Improved Ziggurat Method to Generate Normal Random Samples", 2005.
+//! unlike the original method of Marsaglia and Tsang, the uniform and the layer index are taken from separate bits,
+//! and the uniform has 53 bits of precision.
+template<typename engine_type>
+inline
+double
+arma_rng::normal(engine_type& engine)
+  {
+  const double* x = arma_rng_zig<double>::x;
+  const double* r = arma_rng_zig<double>::r;
+  
+  while(true)
+    {
+    const u32 a = engine.next();
+    const u32 b = engine.next();
+    
+    const u32 i = b & u32(0x7f);
+    
+    // uniform value in the [-1,1) interval, formed from the 28 top bits of a and the 25 bits of b not used by i
+    const double u = ( double(a >> 4) * 33554432.0 + double(b >> 7) ) * (1.0 / 4503599627370496.0) - 1.0;
+    
+    // rectangular part of a layer
+    if(std::abs(u) < r[i])
+      {
+      return u * x[i];
+      }
+    
+    // the bottom layer includes the tail of the distribution
+    if(i == 0)
+      {
+      return normal_tail(engine, (u < 0.0));
+      }
+    
+    // wedge of a layer
+    const double val = u * x[i];
+    
+    const double f0 = std::exp( -0.5 * (x[i  ]*x[i  ] - val*val) );
+    const double f1 = std::exp( -0.5 * (x[i+1]*x[i+1] - val*val) );
+    
+    if( (f1 + uniform(engine) * (f0 - f1)) < 1.0 )
+      {
+      return val;
+      }
+    }
+  }
+
+
+
+//! tail of the normal distribution beyond x[1], via the method of Marsaglia (1964)
+template<typename engine_type>
+inline
+double
+arma_rng::normal_tail(engine_type& engine, const bool negative)
+  {
+  const double edge = arma_rng_zig<double>::x[1];
+  
+  double val;
+  double tmp;
+  
+  do
+    {
+    val = std::log( uniform_open(engine) ) / edge;
+    tmp = std::log( uniform_open(engine) );
+    }
+  while( (-2.0 * tmp) < (val * val) );
+  
+  return (negative) ? (val - edge) : (edge - val);
+  }
+
+
+
+template<typename engine_type>
+arma_inline
+void
+arma_rng::draw_u(engine_type& engine, float& out)
+  {
+  out = to_float(engine.next());
+  }
+
+
+
+template<typename engine_type>
+arma_inline
+void
+arma_rng::draw_u(engine_type& engine, double& out)
+  {
+  out = uniform(engine);
+  }
+
+
+
+template<typename engine_type, typename eT>
+arma_inline
+void
+arma_rng::draw_u(engine_type& engine, eT& out)
+  {
+  out = eT( uniform(engine) );
+  }
+
+
+
+//! key for arma_rng_threefry, drawn from the engine of the calling thread
+inline
+void
+arma_rng::counter_key(u32* key)
+  {
+  arma_rng_engine& engine = get_thread_state().engine;
+  
+  key[0] = engine.next();
+  key[1] = engine.next();
+  key[2] = engine.next();
+  key[3] = engine.next();
+  }
+
+
+
+//! the blocks are processed in chunks, as the compiler does not vectorise loops parallelised via OpenMP
+template<typename eT>
+inline
+void
+arma_rng::fill_u(const arma_rng_threefry& gen, eT* mem, const uword N)
+  {
+  const uword block_size = fill_u_block_size(mem);
+  const uword n_blocks   = N / block_size;
+  const uword chunk_size = 1024;
+  const uword n_chunks   = (n_blocks + chunk_size - 1) / chunk_size;
+  
+  const bool use_mp    = mp_gate::eval(N);
+  const int  n_threads = mp_gate::n_threads();
+  
+  arma_omp_pragma(omp parallel for schedule(static) if(use_mp) num_threads(n_threads))
+  for(uword c=0; c < n_chunks; ++c)
+    {
+    const uword j_start = c * chunk_size;
+    const uword j_end   = (std::min)(j_start + chunk_size, n_blocks);
+    
+    fill_u_blocks(gen, &(mem[j_start * block_size]), j_start, j_end);
+    }
+  
+  const uword n_done = n_blocks * block_size;
+  
+  if(n_done < N)
+    {
+    eT tmp[4];
+    
+    fill_u_blocks(gen, tmp, n_blocks, n_blocks+1);
+    
+    for(uword i=n_done; i < N; ++i)
+      {
+      mem[i] = tmp[i - n_done];
+      }
+    }
+  
+  arma_ignore(use_mp);
+  arma_ignore(n_threads);
+  }
+
+
+
+template<typename eT>
+inline
+uword
+arma_rng::fill_u_block_size(const eT*)
+  {
+  return 2;
+  }
+
+
+
+inline
+uword
+arma_rng::fill_u_block_size(const float*)
+  {
+  return 4;
+  }
+
+
+
+//! each counter gives two elements;
+//! the loop has no branches, so that it can be vectorised by the compiler
+template<typename eT>
+inline
+void
+arma_rng::fill_u_blocks(const arma_rng_threefry& in_gen, eT* mem, const uword j_start, const uword j_end)
+  {
+  const arma_rng_threefry gen(in_gen);
+  
+  for(uword j=j_start; j < j_end; ++j)
+    {
+    u32 w[4];
+    
+    gen.generate(w, u32(j), hi_word(j), 0, 0);
+    
+    const uword i = 2*(j - j_start);
+    
+    mem[i  ] = eT( to_double(w[0], w[1]) );
+    mem[i+1] = eT( to_double(w[2], w[3]) );
+    }
+  }
+
+
+
+//! each counter gives four elements
+inline
+void
+arma_rng::fill_u_blocks(const arma_rng_threefry& gen, float* mem, const uword j_start, const uword j_end)
+  {
+  for(uword j=j_start; j < j_end; ++j)
+    {
+    u32 w[4];
+    
+    gen.generate(w, u32(j), hi_word(j), 0, 0);
+    
+    const uword i = 4*(j - j_start);
+    
+    mem[i  ] = to_float(w[0]);
+    mem[i+1] = to_float(w[1]);
+    mem[i+2] = to_float(w[2]);
+    mem[i+3] = to_float(w[3]);
+    }
+  }
+
+
+
+//! each counter gives the first attempt of the ziggurat method for two elements;
+//! the rarely needed further attempts for element i are taken from counters specific to i (see arma_rng_threefry_stream)
+template<typename eT>
+inline
+void
+arma_rng::fill_n(const arma_rng_threefry& gen, eT* mem, const uword N)
+  {
+  const uword n_blocks  = N / 2;
+  const bool  use_mp    = mp_gate::eval(N);
+  const int   n_threads = mp_gate::n_threads();
+  
+  arma_omp_pragma(omp parallel for schedule(static) if(use_mp) num_threads(n_threads))
+  for(uword j=0; j < n_blocks; ++j)
+    {
+    u32 w[4];
+    
+    gen.generate(w, u32(j), hi_word(j), 0, 0);
+    
+    mem[2*j  ] = eT( normal_at(gen, 2*j,   w[0], w[1]) );
+    mem[2*j+1] = eT( normal_at(gen, 2*j+1, w[2], w[3]) );
+    }
+  
+  if( (2*n_blocks) < N )
+    {
+    u32 w[4];
+    
+    gen.generate(w, u32(n_blocks), hi_word(n_blocks), 0, 0);
+    
+    mem[N-1] = eT( normal_at(gen, N-1, w[0], w[1]) );
+    }
+  
+  arma_ignore(use_mp);
+  arma_ignore(n_threads);
+  }
+
+
+
+//! normal value for element i, with a and b used for the first attempt of the ziggurat method
+arma_inline
+double
+arma_rng::normal_at(const arma_rng_threefry& gen, const uword i, const u32 a, const u32 b)
+  {
+  const double* x = arma_rng_zig<double>::x;
+  const double* r = arma_rng_zig<double>::r;
+  
+  const u32    k = b & u32(0x7f);
+  const double u = ( double(a >> 4) * 33554432.0 + double(b >> 7) ) * (1.0 / 4503599627370496.0) - 1.0;
+  
+  if(std::abs(u) < r[k])
+    {
+    return u * x[k];
+    }
+  
+  // repeat the first attempt in full, then continue with further words
+  arma_rng_threefry_stream stream(gen, i, a, b);
+  
+  return normal(stream);
+  }
+
+
+
+template<typename eT>
+inline
+arma_rng::randu<eT>::operator eT ()
+  {
+  eT out;
+  
+  arma_rng::draw_u(arma_rng::get_thread_state().engine, out);
+  
+  return out;
+  }
+
+
+
+template<typename eT>
+inline
+void
+arma_rng::randu<eT>::fill(eT* mem, const uword N)
+  {
+  u32 key[4];
+  
+  arma_rng::counter_key(key);
+  
+  const arma_rng_threefry gen(key);
+  
+  arma_rng::fill_u(gen, mem, N);
+  }
+
+
+
+template<typename T>
+inline
+arma_rng::randu< std::complex<T> >::operator std::complex<T> ()
+  {
+  const T a = T( arma_rng::randu<T>() );
+  const T b = T( arma_rng::randu<T>() );
+  
+  return std::complex<T>(a, b);
+  }
+
+
+
+//! the real and imaginary parts are stored contiguously, and hence are generated as one array
+template<typename T>
+inline
+void
+arma_rng::randu< std::complex<T> >::fill(std::complex<T>* mem, const uword N)
+  {
+  arma_rng::randu<T>::fill( reinterpret_cast<T*>(mem), 2*N );
+  }
+
+
+
+template<typename eT>
+inline
+arma_rng::randn<eT>::operator eT ()
+  {
+  return eT( arma_rng::normal(arma_rng::get_thread_state().engine) );
+  }
+
+
+
+template<typename eT>
+inline
+void
+arma_rng::randn<eT>::fill(eT* mem, const uword N)
+  {
+  u32 key[4];
+  
+  arma_rng::counter_key(key);
+  
+  const arma_rng_threefry gen(key);
+  
+  arma_rng::fill_n(gen, mem, N);
+  }
+
+
+
+template<typename T>
+inline
+arma_rng::randn< std::complex<T> >::operator std::complex<T> ()
+  {
+  const T a = T( arma_rng::randn<T>() );
+  const T b = T( arma_rng::randn<T>() );
+  
+  return std::complex<T>(a, b);
+  }
+
+
+
+template<typename T>
+inline
+void
+arma_rng::randn< std::complex<T> >::fill(std::complex<T>* mem, const uword N)
+  {
+  arma_rng::randn<T>::fill( reinterpret_cast<T*>(mem), 2*N );
+  }
+
+
+
+//! @}
@@ -118,6 +118,11 @@ class arrayops
   eT
   accumulate(const eT* src, const uword n_elem);
   
+  template<typename eT>
+  arma_hot arma_pure inline static
+  eT
+  accumulate_block(const eT* src, const uword n_elem);
+  
   template<typename eT>
   arma_hot arma_pure inline static
   eT
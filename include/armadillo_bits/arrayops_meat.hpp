@@ -249,6 +249,11 @@ inline
 void
 arrayops::inplace_plus(eT* dest, const eT* src, const uword n_elem)
   {
+  if(simd::array_apply<simd_op_plus>(dest, src, n_elem))
+    {
+    return;
+    }
+  
   uword i,j;
   
   for(i=0, j=1; j<n_elem; i+=2, j+=2)
@@ -274,6 +279,11 @@ inline
 void
 arrayops::inplace_minus(eT* dest, const eT* src, const uword n_elem)
   {
+  if(simd::array_apply<simd_op_minus>(dest, src, n_elem))
+    {
+    return;
+    }
+  
   uword i,j;
   
   for(i=0, j=1; j<n_elem; i+=2, j+=2)
@@ -299,6 +309,11 @@ inline
 void
 arrayops::inplace_mul(eT* dest, const eT* src, const uword n_elem)
   {
+  if(simd::array_apply<simd_op_schur>(dest, src, n_elem))
+    {
+    return;
+    }
+  
   uword i,j;
   
   for(i=0, j=1; j<n_elem; i+=2, j+=2)
@@ -324,6 +339,11 @@ inline
 void
 arrayops::inplace_div(eT* dest, const eT* src, const uword n_elem)
   {
+  if(simd::array_apply<simd_op_div>(dest, src, n_elem))
+    {
+    return;
+    }
+  
   uword i,j;
   
   for(i=0, j=1; j<n_elem; i+=2, j+=2)
@@ -349,6 +369,18 @@ inline
 void
 arrayops::inplace_set(eT* dest, const eT val, const uword n_elem)
   {
+  if( (n_elem >= 8) && memory::is_aligned(dest) )
+    {
+    memory::mark_as_aligned(dest);
+    
+    for(uword i=0; i<n_elem; ++i)
+      {
+      dest[i] = val;
+      }
+    
+    return;
+    }
+  
   uword i,j;
   
   for(i=0, j=1; j<n_elem; i+=2, j+=2)
@@ -385,6 +417,11 @@ inline
 void
 arrayops::inplace_plus(eT* dest, const eT val, const uword n_elem)
   {
+  if(simd::scalar_apply<eop_scalar_plus>(dest, val, n_elem))
+    {
+    return;
+    }
+  
   uword i,j;
   
   for(i=0, j=1; j<n_elem; i+=2, j+=2)
@@ -407,6 +444,11 @@ inline
 void
 arrayops::inplace_minus(eT* dest, const eT val, const uword n_elem)
   {
+  if(simd::scalar_apply<eop_scalar_minus_post>(dest, val, n_elem))
+    {
+    return;
+    }
+  
   uword i,j;
   
   for(i=0, j=1; j<n_elem; i+=2, j+=2)
@@ -429,6 +471,11 @@ inline
 void
 arrayops::inplace_mul(eT* dest, const eT val, const uword n_elem)
   {
+  if(simd::scalar_apply<eop_scalar_times>(dest, val, n_elem))
+    {
+    return;
+    }
+  
   uword i,j;
   
   for(i=0, j=1; j<n_elem; i+=2, j+=2)
@@ -451,6 +498,11 @@ inline
 void
 arrayops::inplace_div(eT* dest, const eT val, const uword n_elem)
   {
+  if(simd::scalar_apply<eop_scalar_div_post>(dest, val, n_elem))
+    {
+    return;
+    }
+  
   uword i,j;
   
   for(i=0, j=1; j<n_elem; i+=2, j+=2)
@@ -474,23 +526,43 @@ inline
 eT
 arrayops::accumulate(const eT* src, const uword n_elem)
   {
-  uword i,j;
+  typedef pairwise_acc<eT> acc_type;
   
-  eT acc1 = eT(0);
-  eT acc2 = eT(0);
+  if(n_elem <= acc_type::block_size)
+    {
+    return arrayops::accumulate_block(src, n_elem);
+    }
   
-  for(i=0, j=1; j<n_elem; i+=2, j+=2)
+  acc_type acc;
+  
+  for(uword i=0; i < n_elem; i += acc_type::block_size)
     {
-    acc1 += src[i];
-    acc2 += src[j];
+    const uword n_remaining = n_elem - i;
+    
+    acc.add( arrayops::accumulate_block(&src[i], (n_remaining < acc_type::block_size) ? n_remaining : uword(acc_type::block_size)) );
     }
   
-  if(i < n_elem)
+  return acc.get();
+  }
+
+
+
+//! sum of a single block (see pairwise_acc)
+template<typename eT>
+arma_hot
+arma_pure
+inline
+eT
+arrayops::accumulate_block(const eT* src, const uword n_elem)
+  {
+  eT acc = eT(0);
+  
+  if(simd::accumulate<pairwise_acc<eT>::compensated>(acc, src, n_elem))
     {
-    acc1 += src[i];
+    return acc;
     }
   
-  return acc1 + acc2;
+  return pairwise_acc<eT>::direct_sum(src, 0, n_elem);
   }
 
 
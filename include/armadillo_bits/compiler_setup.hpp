@@ -159,3 +159,72 @@
   #undef ARMA_HAVE_STD_ISNAN
   #undef ARMA_HAVE_STD_TR1
 #endif
+
+
+#if defined(ARMA_USE_OPENMP)
+  #if !defined(_OPENMP) || (_OPENMP < 200805)
+    #undef ARMA_USE_OPENMP
+    
+    #if defined(__GNUG__)
+      #warning         "ARMA_USE_OPENMP is defined, but OpenMP 3.0 (or later) is not enabled in the compiler; use of OpenMP disabled"
+    #elif defined(_MSC_VER)
+      #pragma message ("ARMA_USE_OPENMP is defined, but OpenMP 3.0 (or later) is not enabled in the compiler; use of OpenMP disabled")
+    #endif
+  #endif
+#endif
+
+
+#if defined(ARMA_USE_SIMD)
+  #if defined(__AVX__)
+    #define ARMA_HAVE_AVX
+  #endif
+  
+  #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define ARMA_HAVE_SSE2
+  #endif
+#endif
+
+
+#if (defined(_POSIX_C_SOURCE) && (_POSIX_C_SOURCE >= 200112L)) || defined(__APPLE__)
+  #define ARMA_HAVE_POSIX_MEMALIGN
+#endif
+
+
+#if defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+  #define ARMA_HAVE_MMAP
+#endif
+
+
+#if defined(__GNUG__) && !defined(__INTEL_COMPILER)
+  #if defined(__clang__)
+    #if defined(__has_builtin)
+      #if __has_builtin(__builtin_assume_aligned)
+        #define ARMA_HAVE_ASSUME_ALIGNED
+      #endif
+    #endif
+  #elif ( (__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 7)) )
+    #define ARMA_HAVE_ASSUME_ALIGNED
+  #endif
+#endif
+
+
+#if defined(__GNUG__) || defined(__INTEL_COMPILER)
+  #define arma_thread_local __thread
+#elif defined(_MSC_VER)
+  #define arma_thread_local __declspec(thread)
+#elif defined(ARMA_USE_CXX11)
+  #define arma_thread_local thread_local
+#endif
+
+
+#if defined(ARMA_USE_MEMPOOL) && !defined(arma_thread_local)
+  #undef ARMA_USE_MEMPOOL
+  
+  #pragma message ("ARMA_USE_MEMPOOL is defined, but thread local storage is not supported by the compiler; use of the pooled allocator disabled")
+#endif
+
+
+// POSIX thread-specific data is used to release the free lists of the pooled allocator when a thread exits
+#if defined(ARMA_USE_MEMPOOL) && ( defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__)) )
+  #define ARMA_HAVE_PTHREAD_KEY
+#endif
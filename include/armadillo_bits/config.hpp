@@ -46,6 +46,14 @@
 // #define ARMA_USE_MKL_ALLOC
 //// Uncomment the above line if you want to use Intel MKL mkl_malloc() and mkl_free() instead of standard new[] and delete[]
 
+// #define ARMA_USE_MEMPOOL
+//// Uncomment the above line if you want to use a pooled allocator instead of standard new[] and delete[].
+//// Released memory is kept in per-thread free lists (one for each power-of-two size class up to 1 MB) and reused by later allocations.
+//// On Unix-like systems the free lists of a thread are returned to the system when the thread exits (this may require linking with -pthread);
+//// on other systems they are kept until the program ends, so creating many short-lived threads that use matrices increases memory use.
+//// This also enables mem_arena, which routes all matrix and cube allocations within a scope to a bump allocator.
+//// If enabled, ARMA_USE_TBB_ALLOC and ARMA_USE_MKL_ALLOC are ignored.
+
 /* #undef ARMA_USE_ATLAS */
 #define ARMA_ATLAS_INCLUDE_DIR /
 //// If you're using ATLAS and the compiler can't find cblas.h and/or clapack.h
@@ -60,6 +68,50 @@
 //// Uncomment the above line if you have a C++ compiler that supports the C++11 standard
 //// This will enable additional features, such as use of initialiser lists
 
+// #define ARMA_USE_OPENMP
+//// Uncomment the above line to allow parallelisation of element-wise expressions (and other operations) via OpenMP.
+//// Your compiler must support OpenMP 3.0 or later, and OpenMP must be enabled when compiling (eg. -fopenmp for GCC).
+
+#if !defined(ARMA_OPENMP_THRESHOLD)
+  #define ARMA_OPENMP_THRESHOLD 65536
+#endif
+//// This is the minimum number of elements an operation must process before it is parallelised via OpenMP;
+//// it must be an integer that is at least 1.
+//// Operations on smaller matrices are always done on a single thread, as the cost of starting threads would dominate.
+
+// #define ARMA_OPENMP_THREADS 8
+//// Uncomment the above line to limit the number of threads used by OpenMP based parallelisation.
+//// By default, the number of threads is determined by the OpenMP runtime (eg. via the OMP_NUM_THREADS environment variable).
+
+// #define ARMA_RNG_ALT my_rng.hpp
+//// Uncomment the above line to replace the default random number engine (xoshiro128**) used by randu(), randn() and shuffle().
+//// The engine generates individual values, and the keys of the counter-based generator used for filling matrices.
+//// The specified header must define a plain struct named arma_rng_alt (in the global namespace),
+//// with the member functions  void seed(unsigned int seed_val, unsigned int stream)  and  unsigned int next(),
+//// where next() returns 32 random bits.  See arma_rng_xoshiro in armadillo_bits/arma_rng.hpp for an example.
+
+#define ARMA_USE_SIMD
+//// Comment out the above line to disable the explicitly vectorised (SSE2 / AVX) loops used for element-wise operations and sums.
+//// The vectorised loops are used only for matrices with float or double elements,
+//// and only if the compiler is generating code for the corresponding instruction set (eg. -msse2 or -mavx for GCC).
+
+// #define ARMA_USE_COMPENSATED_SUM
+//// Uncomment the above line to use Kahan's compensated summation in accu(), sum(), mean(), var(), stddev() and dot()
+//// for matrices with float, double or complex elements.  The sums are always computed in blocks that are combined pairwise,
+//// which keeps the round-off error small; compensation makes it essentially independent of the number of elements,
+//// at the cost of slower sums over data that is already in the cache.
+//// Compensated summation is defeated by compiler options that allow floating point operations to be reordered (eg. -ffast-math for GCC).
+
+// #define ARMA_USE_SIMD_MATH
+//// Uncomment the above line to use vectorised polynomial approximations of exp(), log(), sin(), cos() and tanh()
+//// in element-wise expressions on matrices and cubes with float or double elements (requires ARMA_USE_SIMD; see armadillo_bits/simd_math.hpp).
+//// This is typically several times faster than calling the standard library functions for each element,
+//// but the results are not always identical to those of the standard library: the measured errors are at most
+//// 1.2 ulp for exp(), 0.9 ulp for log(), 1.5 ulp (double) or 2.4 ulp (float) for sin() and cos(), and 3.3 ulp for tanh().
+//// Elements for which the approximations are not valid (eg. exp() that would overflow or underflow, log() of zero, negative or denormal numbers,
+//// sin() and cos() of large arguments, NaN and infinities) are passed to the standard library functions.
+//// sqrt() is always vectorised, as the processor instructions give results identical to std::sqrt().
+
 #if !defined(ARMA_MAT_PREALLOC)
   #define ARMA_MAT_PREALLOC 16
 #endif
@@ -68,6 +120,13 @@
 //// If you mainly use lots of very small vectors (eg. <= 4 elements),
 //// change the number to the size of your vectors.
 
+#if !defined(ARMA_MEM_ALIGNMENT)
+  #define ARMA_MEM_ALIGNMENT 64
+#endif
+//// This is the alignment (in bytes) of memory allocated for matrices, cubes and temporary arrays;
+//// it must be a power of two that is at least 16.  The default of 64 matches the cache line size of most current processors
+//// and is sufficient for aligned AVX loads and stores.
+
 // #define ARMA_NO_DEBUG
 //// Uncomment the above line if you want to disable all run-time checks.
 //// This will result in faster code, but you first need to make sure that your code runs correctly!
@@ -109,6 +168,22 @@
   #undef ARMA_USE_BLAS
 #endif
 
+#if defined(ARMA_DONT_USE_OPENMP)
+  #undef ARMA_USE_OPENMP
+#endif
+
+#if defined(ARMA_DONT_USE_SIMD)
+  #undef ARMA_USE_SIMD
+#endif
+
+#if defined(ARMA_DONT_USE_SIMD_MATH)
+  #undef ARMA_USE_SIMD_MATH
+#endif
+
+#if defined(ARMA_DONT_USE_MEMPOOL)
+  #undef ARMA_USE_MEMPOOL
+#endif
+
 #if defined(ARMA_DONT_USE_ATLAS)
   #undef ARMA_USE_ATLAS
   #undef ARMA_ATLAS_INCLUDE_DIR
@@ -28,6 +28,8 @@ class diskio
   template<typename eT> inline static std::string gen_txt_header(const Cube<eT>& x);
   template<typename eT> inline static std::string gen_bin_header(const Cube<eT>& x);
   
+  inline static void write_bin_header(std::ostream& f, const std::string& header, const std::string& dims);
+  
   inline static file_type guess_file_type(std::istream& f);
   
   inline static char conv_to_hex_char(const u8 x);
@@ -37,6 +39,22 @@ class diskio
   
   inline static bool safe_rename(const std::string& old_name, const std::string& new_name);
   
+  inline static void  read_text(std::istream& f, std::vector<char>& buffer);
+  inline static uword scan_text(const std::vector<char>& buffer, const char sep, uword& max_n_sep, std::vector<uword>& block_start, std::vector<uword>& block_row, const uword n_blocks);
+  
+  template<typename eT> inline static const char* parse_token(eT&               val, const char* str);
+                        inline static const char* parse_token(float&            val, const char* str);
+                        inline static const char* parse_token(double&           val, const char* str);
+                        inline static const char* parse_token_strtod(double&    val, const char* str);
+  template<typename T>  inline static const char* parse_token(std::complex<T>&  val, const char* str);
+  
+  template<typename eT> inline static char* format_token(char* out, const eT               val);
+                        inline static char* format_token(char* out, const float            val);
+                        inline static char* format_token(char* out, const double           val);
+  template<typename T>  inline static char* format_token(char* out, const std::complex<T>& val);
+  
+  template<typename eT> inline static bool save_text(std::ostream& f, const eT* mem, const uword n_rows, const uword n_cols, const char sep);
+  
   
   //
   // matrix saving
@@ -353,6 +353,27 @@ diskio::gen_bin_header(const Cube<eT>& x)
 
 
 
+//! Write the header of a matrix or cube in arma_binary format.
+//! The first line is padded with spaces so that the data starts at a multiple of 64 bytes
+//! from the start of the header; this allows the data to be memory mapped with suitable alignment (see mapped).
+//! The padding is skipped by the usual stream extraction, so the file can be read by older versions.
+inline
+void
+diskio::write_bin_header(std::ostream& f, const std::string& header, const std::string& dims)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword header_alignment = 64;
+  
+  const uword n_chars = uword(header.length() + 1 + dims.length() + 1);
+  const uword n_pad   = (header_alignment - (n_chars % header_alignment)) % header_alignment;
+  
+  f << header << std::string(n_pad, ' ') << '\n';
+  f << dims << '\n';
+  }
+
+
+
 inline
 file_type
 diskio::guess_file_type(std::istream& f)
@@ -562,9 +583,607 @@ diskio::safe_rename(const std::string& old_name, const std::string& new_name)
     {
     std::remove(new_name.c_str());
     
-    const int mv_result = std::rename(old_name.c_str(), new_name.c_str());
+    const int mv_result = std::rename(old_name.c_str(), new_name.c_str());
+    
+    save_okay = (mv_result == 0);
+    }
+  
+  return save_okay;
+  }
+
+
+//! read the text of a matrix from a stream into a buffer, ie. the lines preceding the first empty line (or the end of the stream).
+//! the stream is left just after the data, at the start of the empty line, so that further matrices can be read from the stream.
+//! streams that don't support seeking (eg. std::cin) are read line by line, so that reading stops at the empty line.
+//! a null character is appended, so that numbers at the end of the buffer can be converted in place
+inline
+void
+diskio::read_text(std::istream& f, std::vector<char>& buffer)
+  {
+  arma_extra_debug_sigprint();
+  
+  buffer.clear();
+  
+  std::streambuf* sb = f.rdbuf();
+  
+  const std::streampos pos1 = (sb != 0) ? sb->pubseekoff(0, std::ios::cur, std::ios::in) : std::streampos(-1);
+  
+  if(pos1 == std::streampos(-1))
+    {
+    std::string line_string;
+    
+    while( (f.peek() != '\n') && std::getline(f, line_string) )
+      {
+      buffer.insert(buffer.end(), line_string.begin(), line_string.end());
+      buffer.push_back('\n');
+      }
+    }
+  else
+    {
+    const std::streamsize chunk_size = 1 << 20;
+    
+    std::streamsize n_read   = 0;
+    size_t          data_end = 0;
+    bool            found    = false;
+    
+    do
+      {
+      const size_t old_size = buffer.size();
+      
+      buffer.resize(old_size + size_t(chunk_size));
+      
+      n_read = sb->sgetn( &(buffer[old_size]), chunk_size );
+      
+      buffer.resize( old_size + size_t( (n_read > 0) ? n_read : 0 ) );
+      
+      // look for an empty line in the new text; the search starts one character earlier, in case a newline ends the previous chunk
+      for(size_t i = (old_size > 0) ? (old_size - 1) : 0; i < buffer.size(); ++i)
+        {
+        if( (buffer[i] == '\n') && ( (i == 0) || (buffer[i-1] == '\n') ) )
+          {
+          data_end = i;
+          found    = true;
+          break;
+          }
+        }
+      }
+    while( (found == false) && (n_read == chunk_size) );
+    
+    if(found == true)
+      {
+      buffer.resize(data_end);
+      
+      f.clear();
+      f.seekg( pos1 + std::streamoff(data_end) );
+      }
+    else
+      {
+      f.setstate(std::ios::eofbit);
+      }
+    }
+  
+  buffer.push_back(char(0));
+  }
+
+
+
+//! Find the lines of text preceding the first empty line, and split them into at most n_blocks blocks of similar size,
+//! so that the blocks can be parsed independently.
+//! block_start[i] and block_row[i] are the offset and the row index of the first line in block i;
+//! the extra last element of block_start marks the end of the text.
+//! If sep is not zero, max_n_sep is set to the largest number of occurrences of sep on a line.
+//! Returns the number of lines.
+inline
+uword
+diskio::scan_text(const std::vector<char>& buffer, const char sep, uword& max_n_sep, std::vector<uword>& block_start, std::vector<uword>& block_row, const uword n_blocks)
+  {
+  arma_extra_debug_sigprint();
+  
+  const char* mem = &(buffer[0]);
+  const uword len = uword(buffer.size() - 1);  // excluding the terminating null character
+  
+  block_start.clear();
+  block_row.clear();
+  
+  max_n_sep = 0;
+  
+  uword n_rows      = 0;
+  uword pos         = 0;
+  uword next_target = 0;
+  
+  while(pos < len)
+    {
+    const char* line_end_ptr = (const char*)( std::memchr(mem + pos, '\n', len - pos) );
+    
+    const uword line_end = (line_end_ptr != 0) ? uword(line_end_ptr - mem) : len;
+    
+    if(line_end == pos)
+      {
+      break;
+      }
+    
+    if(pos >= next_target)
+      {
+      block_start.push_back(pos);
+      block_row.push_back(n_rows);
+      
+      next_target = uword( (double(len) * double(block_start.size())) / double(n_blocks) );
+      }
+    
+    if(sep != char(0))
+      {
+      uword n_sep = 0;
+      
+      for(uword i=pos; i < line_end; ++i)
+        {
+        n_sep += (mem[i] == sep) ? uword(1) : uword(0);
+        }
+      
+      max_n_sep = (std::max)(max_n_sep, n_sep);
+      }
+    
+    ++n_rows;
+    
+    pos = (line_end < len) ? (line_end + 1) : len;
+    }
+  
+  block_start.push_back(pos);
+  
+  return n_rows;
+  }
+
+
+
+//! convert the integer at the start of the given string;
+//! returns a pointer to the character following the integer,
+//! or 0 if there is no integer or its value can't be represented by eT
+template<typename eT>
+inline
+const char*
+diskio::parse_token(eT& val, const char* str)
+  {
+  const char* ptr = str;
+  
+  const bool neg = (*ptr == '-');
+  
+  if( (*ptr == '-') || (*ptr == '+') )
+    {
+    ++ptr;
+    }
+  
+  if( (*ptr < '0') || (*ptr > '9') )
+    {
+    return 0;
+    }
+  
+  const eT min_val = std::numeric_limits<eT>::min();
+  const eT max_val = std::numeric_limits<eT>::max();
+  
+  eT acc = eT(0);
+  
+  while( (*ptr >= '0') && (*ptr <= '9') )
+    {
+    const eT digit = eT(*ptr - '0');
+    
+    // negative numbers are accumulated directly, so that the most negative value doesn't overflow
+    if(neg)
+      {
+      if( (acc < eT( (min_val + digit) / eT(10) )) || ( (is_signed<eT>::value == false) && (digit != eT(0)) ) )
+        {
+        return 0;
+        }
+      
+      acc = eT(acc*eT(10) - digit);
+      }
+    else
+      {
+      if( acc > eT( (max_val - digit) / eT(10) ) )
+        {
+        return 0;
+        }
+      
+      acc = eT(acc*eT(10) + digit);
+      }
+    
+    ++ptr;
+    }
+  
+  val = acc;
+  
+  return ptr;
+  }
+
+
+
+inline
+const char*
+diskio::parse_token(float& val, const char* str)
+  {
+  double tmp;
+  
+  const char* ptr = diskio::parse_token(tmp, str);
+  
+  if(ptr != 0)
+    {
+    val = float(tmp);
+    }
+  
+  return ptr;
+  }
+
+
+
+//! convert the real number at the start of the given string, independently of the locale set via setlocale();
+//! numbers with at most 15 significant digits and a decimal exponent of at most 22 in magnitude (ie. most numbers in text files)
+//! are converted exactly by a single multiplication or division, others via parse_token_strtod()
+inline
+const char*
+diskio::parse_token(double& val, const char* str)
+  {
+  static const double pow10[] =
+    {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+  
+  const char* ptr = str;
+  
+  const bool neg = (*ptr == '-');
+  
+  if( (*ptr == '-') || (*ptr == '+') )
+    {
+    ++ptr;
+    }
+  
+  double mantissa   = 0.0;
+  int    n_digits   = 0;     // number of significant digits
+  int    exponent   = 0;
+  bool   have_digit = false;
+  
+  for(; (*ptr >= '0') && (*ptr <= '9'); ++ptr)
+    {
+    have_digit = true;
+    n_digits  += ( (n_digits > 0) || (*ptr != '0') ) ? 1 : 0;
+    mantissa   = mantissa*10.0 + double(*ptr - '0');
+    }
+  
+  if(*ptr == '.')
+    {
+    for(++ptr; (*ptr >= '0') && (*ptr <= '9'); ++ptr)
+      {
+      have_digit = true;
+      n_digits  += ( (n_digits > 0) || (*ptr != '0') ) ? 1 : 0;
+      mantissa   = mantissa*10.0 + double(*ptr - '0');
+      --exponent;
+      }
+    }
+  
+  if( (have_digit == false) || (n_digits > 15) )
+    {
+    return diskio::parse_token_strtod(val, str);
+    }
+  
+  if( (*ptr == 'e') || (*ptr == 'E') )
+    {
+    const char* exp_ptr = ptr + 1;
+    
+    const bool exp_neg = (*exp_ptr == '-');
+    
+    if( (*exp_ptr == '-') || (*exp_ptr == '+') )
+      {
+      ++exp_ptr;
+      }
+    
+    if( (*exp_ptr >= '0') && (*exp_ptr <= '9') )
+      {
+      int exp_val = 0;
+      
+      for(; (*exp_ptr >= '0') && (*exp_ptr <= '9'); ++exp_ptr)
+        {
+        exp_val = (exp_val < 10000) ? (exp_val*10 + int(*exp_ptr - '0')) : exp_val;
+        }
+      
+      exponent = (exp_neg) ? (exponent - exp_val) : (exponent + exp_val);
+      
+      ptr = exp_ptr;
+      }
+    }
+  
+  if( (mantissa != 0.0) && ( (exponent < -22) || (exponent > 22) ) )
+    {
+    return diskio::parse_token_strtod(val, str);
+    }
+  
+  const double tmp = (mantissa == 0.0) ? 0.0 : ( (exponent >= 0) ? (mantissa * pow10[exponent]) : (mantissa / pow10[-exponent]) );
+  
+  val = (neg) ? -tmp : tmp;
+  
+  return ptr;
+  }
+
+
+
+//! convert the real number at the start of the given string via strtod();
+//! if the decimal point of the C locale isn't '.', the number is copied with its decimal point replaced by the one of the locale
+inline
+const char*
+diskio::parse_token_strtod(double& val, const char* str)
+  {
+  const std::lconv* lc = std::localeconv();
+  
+  const char* decimal_point = ( (lc != 0) && (lc->decimal_point != 0) && (lc->decimal_point[0] != char(0)) ) ? lc->decimal_point : ".";
+  
+  const bool plain = (decimal_point[0] == '.') && (decimal_point[1] == char(0));
+  
+  // the characters which may be part of a number understood by strtod() in the "C" locale
+  std::string tmp_str;
+  
+  if(plain == false)
+    {
+    for(const char* ptr = str; (std::isalnum( static_cast<unsigned char>(*ptr) ) != 0) || (*ptr == '+') || (*ptr == '-') || (*ptr == '.'); ++ptr)
+      {
+      if(*ptr == '.')
+        {
+        tmp_str += decimal_point;
+        }
+      else
+        {
+        tmp_str += *ptr;
+        }
+      }
+    }
+  
+  const char* conv_str = (plain) ? str : tmp_str.c_str();
+  
+  char* end = 0;
+  
+  const double tmp = std::strtod(conv_str, &end);
+  
+  if(end == conv_str)
+    {
+    return 0;
+    }
+  
+  val = tmp;
+  
+  if(plain)
+    {
+    return end;
+    }
+  
+  // find the position in str corresponding to the end of the converted number in tmp_str
+  const size_t n_conv          = size_t(end - conv_str);
+  const size_t decimal_point_n = std::strlen(decimal_point);
+  
+  size_t pos = 0;
+  
+  const char* ptr = str;
+  
+  while(pos < n_conv)
+    {
+    pos += (*ptr == '.') ? decimal_point_n : size_t(1);
+    ++ptr;
+    }
+  
+  return ptr;
+  }
+
+
+
+//! convert a complex number written either as a single real value, or as "(real,imag)"
+template<typename T>
+inline
+const char*
+diskio::parse_token(std::complex<T>& val, const char* str)
+  {
+  T val_real = T(0);
+  T val_imag = T(0);
+  
+  if(*str != '(')
+    {
+    const char* ptr = diskio::parse_token(val_real, str);
+    
+    if(ptr != 0)
+      {
+      val = std::complex<T>(val_real, val_imag);
+      }
+    
+    return ptr;
+    }
+  
+  const char* ptr = diskio::parse_token(val_real, str + 1);
+  
+  if( (ptr != 0) && (*ptr == ',') )
+    {
+    ptr = diskio::parse_token(val_imag, ptr + 1);
+    }
+  
+  if( (ptr == 0) || (*ptr != ')') )
+    {
+    return 0;
+    }
+  
+  val = std::complex<T>(val_real, val_imag);
+  
+  return (ptr + 1);
+  }
+
+
+
+//! write an integer in decimal notation; returns a pointer to the character following the last one written
+template<typename eT>
+inline
+char*
+diskio::format_token(char* out, const eT val)
+  {
+  char tmp[24];
+  int  n = 0;
+  
+  eT rem = val;
+  
+  if( (is_signed<eT>::value == true) && (val < eT(0)) )
+    {
+    *out = '-';
+    ++out;
+    
+    // negative numbers are converted directly, so that the most negative value doesn't overflow
+    do
+      {
+      tmp[n] = char( '0' - (rem % eT(10)) );
+      ++n;
+      
+      rem /= eT(10);
+      }
+    while(rem != eT(0));
+    }
+  else
+    {
+    do
+      {
+      tmp[n] = char( '0' + (rem % eT(10)) );
+      ++n;
+      
+      rem /= eT(10);
+      }
+    while(rem != eT(0));
+    }
+  
+  while(n > 0)
+    {
+    --n;
+    
+    *out = tmp[n];
+    ++out;
+    }
+  
+  return out;
+  }
+
+
+
+inline
+char*
+diskio::format_token(char* out, const float val)
+  {
+  return arma_dtoa::format(out, val);
+  }
+
+
+
+inline
+char*
+diskio::format_token(char* out, const double val)
+  {
+  return arma_dtoa::format(out, val);
+  }
+
+
+
+//! write a complex number as "(real,imag)"
+template<typename T>
+inline
+char*
+diskio::format_token(char* out, const std::complex<T>& val)
+  {
+  *out = '(';
+  
+  out = diskio::format_token(out + 1, val.real());
+  
+  *out = ',';
+  
+  out = diskio::format_token(out + 1, val.imag());
+  
+  *out = ')';
+  
+  return (out + 1);
+  }
+
+
+
+//! Write the elements of a column-major matrix as rows of text.
+//! If sep is a space, each element is preceded by a space; otherwise the elements in each row are separated by sep.
+//! The text is formatted in blocks of rows held in memory, which are written in order;
+//! when OpenMP is enabled and the matrix is large enough, the blocks are formatted in parallel.
+template<typename eT>
+inline
+bool
+diskio::save_text(std::ostream& f, const eT* mem, const uword n_rows, const uword n_cols, const char sep)
+  {
+  arma_extra_debug_sigprint();
+  
+  if( (n_rows == 0) || (n_cols == 0) )
+    {
+    return f.good();
+    }
+  
+  const uword token_len  = (is_complex<eT>::value == true) ? uword(2*arma_dtoa::max_len + 3) : uword(arma_dtoa::max_len);
+  const uword row_len    = n_cols * (token_len + 1) + 1;
+  const uword block_rows = (std::max)( uword(1), uword(1048576 / row_len) );
+  
+  const uword n_blocks = ( mp_gate::eval(n_rows*n_cols) ) ? uword(mp_gate::n_threads()) : uword(1);
+  
+  std::vector< std::vector<char> > buffers(n_blocks);
+  std::vector< uword >             lengths(n_blocks);
+  
+  bool save_okay = true;
+  
+  for(uword row_start = 0; (row_start < n_rows) && (save_okay == true); row_start += n_blocks*block_rows)
+    {
+    arma_omp_pragma(omp parallel for schedule(static) num_threads(int(n_blocks)))
+    for(uword block = 0; block < n_blocks; ++block)
+      {
+      const uword block_start = (std::min)( n_rows, row_start + block*block_rows );
+      const uword block_end   = (std::min)( n_rows, block_start + block_rows     );
+      
+      std::vector<char>& buffer = buffers[block];
+      
+      if(buffer.size() < (block_end - block_start) * row_len)
+        {
+        buffer.resize( (block_end - block_start) * row_len );
+        }
+      
+      char* const out_start = (buffer.empty() == false) ? &buffer[0] : 0;
+      char*       out       = out_start;
+      
+      for(uword row = block_start; row < block_end; ++row)
+        {
+        const eT* ptr = &mem[row];
+        
+        for(uword col = 0; col < n_cols; ++col)
+          {
+          if(sep == ' ')
+            {
+            *out = ' ';
+            ++out;
+            }
+          else
+          if(col > 0)
+            {
+            *out = sep;
+            ++out;
+            }
+          
+          out = diskio::format_token(out, *ptr);
+          
+          ptr += n_rows;
+          }
+        
+        *out = '\n';
+        ++out;
+        }
+      
+      lengths[block] = uword(out - out_start);
+      }
+    
+    for(uword block = 0; block < n_blocks; ++block)
+      {
+      if(lengths[block] > 0)
+        {
+        f.write( &(buffers[block][0]), std::streamsize(lengths[block]) );
+        }
+      }
     
-    save_okay = (mv_result == 0);
+    save_okay = f.good();
     }
   
   return save_okay;
@@ -614,35 +1233,7 @@ diskio::save_raw_ascii(const Mat<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  uword cell_width;
-  
-  // TODO: need sane values for complex numbers
-  
-  if( (is_float<eT>::value == true) || (is_double<eT>::value == true) )
-    {
-    f.setf(ios::scientific);
-    f.precision(10);
-    cell_width = 18;
-    }
-  
-  for(uword row=0; row < x.n_rows; ++row)
-    {
-    for(uword col=0; col < x.n_cols; ++col)
-      {
-      f.put(' ');
-      
-      if( (is_float<eT>::value == true) || (is_double<eT>::value == true) )
-        {
-        f.width(cell_width);
-        }
-      
-      f << x.at(row,col);
-      }
-      
-    f.put('\n');
-    }
-  
-  return f.good();
+  return diskio::save_text(f, x.memptr(), x.n_rows, x.n_cols, ' ');
   }
 
 
@@ -817,39 +1408,7 @@ diskio::save_csv_ascii(const Mat<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  const ios::fmtflags orig_flags = f.flags();
-  
-  // TODO: need sane values for complex numbers
-  
-  if( (is_float<eT>::value == true) || (is_double<eT>::value == true) )
-    {
-    f.setf(ios::scientific);
-    f.precision(10);
-    }
-  
-  uword x_n_rows = x.n_rows;
-  uword x_n_cols = x.n_cols;
-  
-  for(uword row=0; row < x_n_rows; ++row)
-    {
-    for(uword col=0; col < x_n_cols; ++col)
-      {
-      f << x.at(row,col);
-      
-      if( col < (x_n_cols-1) )
-        {
-        f.put(',');
-        }
-      }
-    
-    f.put('\n');
-    }
-  
-  const bool save_okay = f.good();
-  
-  f.flags(orig_flags);
-  
-  return save_okay;
+  return diskio::save_text(f, x.memptr(), x.n_rows, x.n_cols, ',');
   }
 
 
@@ -896,8 +1455,10 @@ diskio::save_arma_binary(const Mat<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
 
-  f << diskio::gen_bin_header(x) << '\n';
-  f << x.n_rows << ' ' << x.n_cols << '\n';
+  std::ostringstream dims;
+  dims << x.n_rows << ' ' << x.n_cols;
+  
+  diskio::write_bin_header(f, diskio::gen_bin_header(x), dims.str());
   
   f.write( reinterpret_cast<const char*>(x.mem), std::streamsize(x.n_elem*sizeof(eT)) );
   
@@ -1096,7 +1657,8 @@ diskio::load_raw_ascii(Mat<eT>& x, const std::string& name, std::string& err_msg
 
 //! Load a matrix as raw text (no header, human readable).
 //! Can read matrices saved as text in Matlab and Octave.
-//! NOTE: this is much slower than reading a file with a header.
+//! The text is read into memory in one go and parsed in place;
+//! large files are split into blocks of lines which are parsed in parallel if OpenMP is enabled.
 template<typename eT>
 inline
 bool
@@ -1106,92 +1668,132 @@ diskio::load_raw_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg)
   
   bool load_okay = f.good();
   
-  f.clear();
-  const std::fstream::pos_type pos1 = f.tellg();
+  std::vector<char> buffer;
   
-  //
-  // work out the size
+  diskio::read_text(f, buffer);
   
-  uword f_n_rows = 0;
-  uword f_n_cols = 0;
+  const char* mem = &(buffer[0]);
   
-  bool f_n_cols_found = false;
+  // assume roughly 8 characters per element when deciding whether to parse in parallel
+  const uword n_blocks = ( mp_gate::eval(uword(buffer.size() / 8)) ) ? uword(mp_gate::n_threads()) : uword(1);
   
-  std::string line_string;
-  std::string token;
+  std::vector<uword> block_start;
+  std::vector<uword> block_row;
   
-  while( (f.good() == true) && (load_okay == true) )
+  uword junk;
+  
+  const uword f_n_rows = diskio::scan_text(buffer, char(0), junk, block_start, block_row, n_blocks);
+  
+  // the number of columns is given by the first line
+  
+  uword f_n_cols = 0;
+  
+  for(const char* ptr = mem; (*ptr != '\n') && (*ptr != char(0)); )
     {
-    std::getline(f, line_string);
-    
-    if(line_string.size() == 0)
-      {
-      break;
-      }
-    
-    std::stringstream line_stream(line_string);
-    
-    uword line_n_cols = 0;
-    
-    while (line_stream >> token)
-      {
-      ++line_n_cols;
-      }
-    
-    if(f_n_cols_found == false)
+    if( std::isspace( static_cast<unsigned char>(*ptr) ) )
       {
-      f_n_cols = line_n_cols;
-      f_n_cols_found = true;
+      ++ptr;
       }
     else
       {
-      if(line_n_cols != f_n_cols)
+      ++f_n_cols;
+      
+      while( (*ptr != char(0)) && (std::isspace( static_cast<unsigned char>(*ptr) ) == 0) )
         {
-        err_msg = "inconsistent number of columns in ";
-        load_okay = false;
+        ++ptr;
         }
       }
-    
-    ++f_n_rows;
     }
-    
-  if(load_okay == true)
+  
+  x.set_size(f_n_rows, f_n_cols);
+  
+  const uword n_used_blocks = uword(block_row.size());
+  
+  bool cols_okay = true;
+  bool data_okay = true;
+  
+  arma_omp_pragma(omp parallel for schedule(static) num_threads(int(n_blocks)) reduction(&&:cols_okay,data_okay))
+  for(uword block=0; block < n_used_blocks; ++block)
     {
-    f.clear();
-    f.seekg(pos1);
-    
-    x.set_size(f_n_rows, f_n_cols);
+    const char* ptr = mem + block_start[block];
+    const char* end = mem + block_start[block+1];
     
-    eT val;
+    uword row = block_row[block];
     
-    for(uword row=0; (row < x.n_rows) && (load_okay == true); ++row)
+    while(ptr < end)
       {
-      for(uword col=0; (col < x.n_cols) && (load_okay == true); ++col)
+      uword col = 0;
+      
+      while(true)
         {
-        f >> val;
+        while( (*ptr != '\n') && std::isspace( static_cast<unsigned char>(*ptr) ) )
+          {
+          ++ptr;
+          }
         
-        if(f.fail() == false)
+        if( (*ptr == '\n') || (*ptr == char(0)) )
           {
-          x.at(row,col) = val;
+          break;
+          }
+        
+        eT val = eT(0);
+        
+        const char* next = diskio::parse_token(val, ptr);
+        
+        if( (next == 0) || ( (*next != char(0)) && (std::isspace( static_cast<unsigned char>(*next) ) == 0) ) )
+          {
+          data_okay = false;
+          
+          while( (*ptr != '\n') && (*ptr != char(0)) )
+            {
+            ++ptr;
+            }
+          
+          col = f_n_cols;
+          break;
           }
-        else
+        
+        if(col < f_n_cols)
           {
-          load_okay = false;
-          err_msg = "couldn't interpret data in ";
-          //break;
+          x.at(row,col) = val;
           }
+        
+        ++col;
+        ptr = next;
+        }
+      
+      if(col != f_n_cols)
+        {
+        cols_okay = false;
         }
+      
+      if(*ptr == '\n')
+        {
+        ++ptr;
+        }
+      
+      ++row;
       }
     }
   
+  if(cols_okay == false)
+    {
+    load_okay = false;
+    err_msg = "inconsistent number of columns in ";
+    }
+  else
+  if(data_okay == false)
+    {
+    load_okay = false;
+    err_msg = "couldn't interpret data in ";
+    }
   
   // an empty file indicates an empty matrix
-  if( (f_n_cols_found == false) && (load_okay == true) )
+  if( (f_n_rows == 0) && (load_okay == true) )
     {
     x.reset();
     }
   
-  
   return load_okay;
   }
 
@@ -1347,94 +1949,112 @@ diskio::load_csv_ascii(Mat<eT>& x, const std::string& name, std::string& err_msg
 
 
 
-//! Load a matrix in CSV text format (human readable)
+//! Load a matrix in CSV text format (human readable).
+//! The text is read into memory in one go and parsed in place;
+//! large files are split into blocks of lines which are parsed in parallel if OpenMP is enabled.
+//! Elements which can't be interpreted are set to zero.
 template<typename eT>
 inline
 bool
-diskio::load_csv_ascii(Mat<eT>& x, std::istream& f, std::string&)
+diskio::load_csv_ascii(Mat<eT>& x, std::istream& f, std::string& err_msg)
   {
   arma_extra_debug_sigprint();
   
   bool load_okay = f.good();
   
-  f.clear();
-  const std::fstream::pos_type pos1 = f.tellg();
+  std::vector<char> buffer;
   
-  //
-  // work out the size
+  diskio::read_text(f, buffer);
   
-  uword f_n_rows = 0;
-  uword f_n_cols = 0;
+  const char* mem = &(buffer[0]);
   
-  std::string line_string;
-  std::string token;
+  // assume roughly 8 characters per element when deciding whether to parse in parallel
+  const uword n_blocks = ( mp_gate::eval(uword(buffer.size() / 8)) ) ? uword(mp_gate::n_threads()) : uword(1);
   
-  while( (f.good() == true) && (load_okay == true) )
-    {
-    std::getline(f, line_string);
-    
-    if(line_string.size() == 0)
-      {
-      break;
-      }
-    
-    std::stringstream line_stream(line_string);
-    
-    uword line_n_cols = 0;
-    
-    while(line_stream.good() == true)
-      {
-      getline(line_stream, token, ',');
-      ++line_n_cols;
-      }
-    
-    if(f_n_cols < line_n_cols)
-      {
-      f_n_cols = line_n_cols;
-      }
-    
-    ++f_n_rows;
-    }
+  std::vector<uword> block_start;
+  std::vector<uword> block_row;
   
-  f.clear();
-  f.seekg(pos1);
+  uword max_n_sep;
+  
+  const uword f_n_rows = diskio::scan_text(buffer, ',', max_n_sep, block_start, block_row, n_blocks);
+  const uword f_n_cols = (f_n_rows > 0) ? (max_n_sep + 1) : 0;
   
   x.zeros(f_n_rows, f_n_cols);
   
-  uword row = 0;
+  const uword n_used_blocks = uword(block_row.size());
   
-  while(f.good() == true)
+  bool data_okay = true;
+  
+  arma_omp_pragma(omp parallel for schedule(static) num_threads(int(n_blocks)) reduction(&&:data_okay))
+  for(uword block=0; block < n_used_blocks; ++block)
     {
-    std::getline(f, line_string);
-    
-    if(line_string.size() == 0)
-      {
-      break;
-      }
-    
-    std::stringstream line_stream(line_string);
+    const char* ptr = mem + block_start[block];
+    const char* end = mem + block_start[block+1];
     
-    uword col = 0;
+    uword row = block_row[block];
     
-    while(line_stream.good() == true)
+    while(ptr < end)
       {
-      getline(line_stream, token, ',');
-      
-      eT val;
+      uword col = 0;
       
-      std::stringstream ss(token);
-      
-      ss >> val;
+      while(true)
+        {
+        while( (*ptr == ' ') || (*ptr == '\t') )
+          {
+          ++ptr;
+          }
+        
+        if( (*ptr != ',') && (*ptr != '\n') && (*ptr != char(0)) )
+          {
+          eT val = eT(0);
+          
+          const char* next = diskio::parse_token(val, ptr);
+          
+          if(next != 0)
+            {
+            x.at(row,col) = val;
+            ptr = next;
+            }
+          else
+            {
+            // tokens that aren't numbers are read as zero, but an integer that doesn't fit in eT is an error
+            const char* digits = ( (*ptr == '-') || (*ptr == '+') ) ? (ptr + 1) : ptr;
+            
+            if( (is_non_integral<eT>::value == false) && (*digits >= '0') && (*digits <= '9') )
+              {
+              data_okay = false;
+              }
+            }
+          }
+        
+        // skip anything else in the token
+        while( (*ptr != ',') && (*ptr != '\n') && (*ptr != char(0)) )
+          {
+          ++ptr;
+          }
+        
+        if(*ptr != ',')
+          {
+          break;
+          }
+        
+        ++ptr;
+        ++col;
+        }
       
-      if(ss.fail() == false)
+      if(*ptr == '\n')
         {
-        x.at(row,col) = val;
+        ++ptr;
         }
       
-      ++col;
+      ++row;
       }
-    
-    ++row;
+    }
+  
+  if(data_okay == false)
+    {
+    load_okay = false;
+    err_msg = "couldn't interpret data in ";
     }
   
   return load_okay;
@@ -1911,38 +2531,14 @@ diskio::save_raw_ascii(const Cube<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  uword cell_width;
-  
-  // TODO: need sane values for complex numbers
-  
-  if( (is_float<eT>::value == true) || (is_double<eT>::value == true) )
-    {
-    f.setf(ios::scientific);
-    f.precision(10);
-    cell_width = 18;
-    }
+  bool save_okay = f.good();
   
-  for(uword slice=0; slice < x.n_slices; ++slice)
+  for(uword slice=0; (slice < x.n_slices) && (save_okay == true); ++slice)
     {
-    for(uword row=0; row < x.n_rows; ++row)
-      {
-      for(uword col=0; col < x.n_cols; ++col)
-        {
-        f.put(' ');
-        
-        if( (is_float<eT>::value == true) || (is_double<eT>::value == true) )
-          {
-          f.width(cell_width);
-          }
-        
-        f << x.at(row,col,slice);
-        }
-        
-      f.put('\n');
-      }
+    save_okay = diskio::save_text(f, x.slice_memptr(slice), x.n_rows, x.n_cols, ' ');
     }
   
-  return f.good();
+  return save_okay;
   }
 
 
@@ -2122,8 +2718,10 @@ diskio::save_arma_binary(const Cube<eT>& x, std::ostream& f)
   {
   arma_extra_debug_sigprint();
   
-  f << diskio::gen_bin_header(x) << '\n';
-  f << x.n_rows << ' ' << x.n_cols << ' ' << x.n_slices << '\n';
+  std::ostringstream dims;
+  dims << x.n_rows << ' ' << x.n_cols << ' ' << x.n_slices;
+  
+  diskio::write_bin_header(f, diskio::gen_bin_header(x), dims.str());
   
   f.write( reinterpret_cast<const char*>(x.mem), std::streamsize(x.n_elem*sizeof(eT)) );
   
@@ -23,7 +23,7 @@ class eOp : public Base<typename T1::elem_type, eOp<T1, eop_type> >
   
   typedef typename T1::elem_type                   elem_type;
   typedef typename get_pod_type<elem_type>::result pod_type;
-  typedef          Proxy<T1>                       proxy_type;
+  typedef typename eop_proxy<T1, eop_type>::result proxy_type;
   
   static const bool prefer_at_accessor = Proxy<T1>::prefer_at_accessor;
   static const bool has_subview        = Proxy<T1>::has_subview;
@@ -33,7 +33,7 @@ class eOp : public Base<typename T1::elem_type, eOp<T1, eop_type> >
   static const bool is_row = Proxy<T1>::is_row;
   static const bool is_col = Proxy<T1>::is_col;
   
-  arma_aligned const Proxy<T1> P;
+  arma_aligned const proxy_type P;
   
   arma_aligned       elem_type aux;          //!< storage of auxiliary data, user defined format
   arma_aligned       uword     aux_uword_a;  //!< storage of auxiliary data, uword format
@@ -19,6 +19,9 @@
 #undef arma_applier_1
 #undef arma_applier_2
 #undef arma_applier_3
+#undef arma_applier_1_mp
+#undef arma_applier_2_mp
+#undef arma_applier_3_mp
 #undef operatorA
 #undef operatorB
 
@@ -131,6 +134,61 @@
   }
 
 
+#define arma_applier_1_mp(operatorA, operatorB) \
+  {\
+  arma_omp_pragma(omp parallel for schedule(static) num_threads(mp_gate::n_threads()))\
+  for(uword i=0; i<n_elem; ++i)\
+    {\
+    out_mem[i] operatorA P1[i] operatorB P2[i];\
+    }\
+  }
+
+
+#define arma_applier_2_mp(operatorA, operatorB) \
+  {\
+  if(n_cols == 1)\
+    {\
+    arma_omp_pragma(omp parallel for schedule(static) num_threads(mp_gate::n_threads()))\
+    for(uword count=0; count < n_rows; ++count)\
+      {\
+      out_mem[count] operatorA P1.at(count,0) operatorB P2.at(count,0);\
+      }\
+    }\
+  else\
+    {\
+    arma_omp_pragma(omp parallel for schedule(static) num_threads(mp_gate::n_threads()))\
+    for(uword col=0; col < n_cols; ++col)\
+      {\
+      eT* out_col = &(out_mem[col*n_rows]);\
+      \
+      for(uword row=0; row < n_rows; ++row)\
+        {\
+        out_col[row] operatorA P1.at(row,col) operatorB P2.at(row,col);\
+        }\
+      }\
+    }\
+  }
+
+
+#define arma_applier_3_mp(operatorA, operatorB) \
+  {\
+  arma_omp_pragma(omp parallel for schedule(static) num_threads(mp_gate::n_threads()) collapse(2))\
+  for(uword slice=0; slice < n_slices; ++slice)\
+    {\
+    for(uword col=0; col < n_cols; ++col)\
+      {\
+      eT* out_col = &(out_mem[ (slice*n_cols + col)*n_rows ]);\
+      \
+      for(uword row=0; row < n_rows; ++row)\
+        {\
+        out_col[row] operatorA P1.at(row,col,slice) operatorB P2.at(row,col,slice);\
+        }\
+      }\
+    }\
+  }
+
+
+
 
 //
 // matrices
@@ -164,10 +222,26 @@ eglue_core<eglue_type>::apply(Mat<typename T1::elem_type>& out, const eGlue<T1,
     typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
     typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(=, *); }
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eglue_apply_mp<eglue_type, simd_op_equ>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1_mp(=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1_mp(=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1_mp(=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1_mp(=, *); }
+        }
+      }
+    else
+      {
+      if(simd::eglue_apply<eglue_type, simd_op_equ>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(=, *); }
+        }
+      }
     }
   else
     {
@@ -177,10 +251,20 @@ eglue_core<eglue_type>::apply(Mat<typename T1::elem_type>& out, const eGlue<T1,
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_2(=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_2(=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_2(=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_2(=, *); }
+    if( mp_gate::eval(n_rows*n_cols) )
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_2_mp(=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_2_mp(=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_2_mp(=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_2_mp(=, *); }
+      }
+    else
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_2(=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_2(=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_2(=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_2(=, *); }
+      }
     }
   }
 
@@ -214,20 +298,46 @@ eglue_core<eglue_type>::apply_inplace_plus(Mat<typename T1::elem_type>& out, con
     typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
     typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(+=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(+=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(+=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(+=, *); }
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eglue_apply_mp<eglue_type, simd_op_plus>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1_mp(+=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1_mp(+=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1_mp(+=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1_mp(+=, *); }
+        }
+      }
+    else
+      {
+      if(simd::eglue_apply<eglue_type, simd_op_plus>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(+=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(+=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(+=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(+=, *); }
+        }
+      }
     }
   else
     {
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_2(+=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_2(+=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_2(+=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_2(+=, *); }
+    if( mp_gate::eval(n_rows*n_cols) && ( (Proxy<T1>::has_subview == false) || (P1.is_alias(out) == false) ) && ( (Proxy<T2>::has_subview == false) || (P2.is_alias(out) == false) ) )
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_2_mp(+=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_2_mp(+=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_2_mp(+=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_2_mp(+=, *); }
+      }
+    else
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_2(+=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_2(+=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_2(+=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_2(+=, *); }
+      }
     }
   }
 
@@ -261,20 +371,46 @@ eglue_core<eglue_type>::apply_inplace_minus(Mat<typename T1::elem_type>& out, co
     typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
     typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(-=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(-=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(-=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(-=, *); }
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eglue_apply_mp<eglue_type, simd_op_minus>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1_mp(-=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1_mp(-=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1_mp(-=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1_mp(-=, *); }
+        }
+      }
+    else
+      {
+      if(simd::eglue_apply<eglue_type, simd_op_minus>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(-=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(-=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(-=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(-=, *); }
+        }
+      }
     }
   else
     {
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_2(-=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_2(-=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_2(-=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_2(-=, *); }
+    if( mp_gate::eval(n_rows*n_cols) && ( (Proxy<T1>::has_subview == false) || (P1.is_alias(out) == false) ) && ( (Proxy<T2>::has_subview == false) || (P2.is_alias(out) == false) ) )
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_2_mp(-=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_2_mp(-=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_2_mp(-=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_2_mp(-=, *); }
+      }
+    else
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_2(-=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_2(-=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_2(-=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_2(-=, *); }
+      }
     }
   }
 
@@ -308,20 +444,46 @@ eglue_core<eglue_type>::apply_inplace_schur(Mat<typename T1::elem_type>& out, co
     typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
     typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(*=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(*=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(*=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(*=, *); }
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eglue_apply_mp<eglue_type, simd_op_schur>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1_mp(*=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1_mp(*=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1_mp(*=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1_mp(*=, *); }
+        }
+      }
+    else
+      {
+      if(simd::eglue_apply<eglue_type, simd_op_schur>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(*=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(*=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(*=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(*=, *); }
+        }
+      }
     }
   else
     {
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_2(*=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_2(*=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_2(*=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_2(*=, *); }
+    if( mp_gate::eval(n_rows*n_cols) && ( (Proxy<T1>::has_subview == false) || (P1.is_alias(out) == false) ) && ( (Proxy<T2>::has_subview == false) || (P2.is_alias(out) == false) ) )
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_2_mp(*=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_2_mp(*=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_2_mp(*=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_2_mp(*=, *); }
+      }
+    else
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_2(*=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_2(*=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_2(*=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_2(*=, *); }
+      }
     }
   }
 
@@ -355,20 +517,46 @@ eglue_core<eglue_type>::apply_inplace_div(Mat<typename T1::elem_type>& out, cons
     typename Proxy<T1>::ea_type P1 = x.P1.get_ea();
     typename Proxy<T2>::ea_type P2 = x.P2.get_ea();
   
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(/=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(/=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(/=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(/=, *); }
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eglue_apply_mp<eglue_type, simd_op_div>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1_mp(/=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1_mp(/=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1_mp(/=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1_mp(/=, *); }
+        }
+      }
+    else
+      {
+      if(simd::eglue_apply<eglue_type, simd_op_div>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(/=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(/=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(/=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(/=, *); }
+        }
+      }
     }
   else
     {
     const Proxy<T1>& P1 = x.P1;
     const Proxy<T2>& P2 = x.P2;
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_2(*=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_2(*=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_2(*=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_2(*=, *); }
+    if( mp_gate::eval(n_rows*n_cols) && ( (Proxy<T1>::has_subview == false) || (P1.is_alias(out) == false) ) && ( (Proxy<T2>::has_subview == false) || (P2.is_alias(out) == false) ) )
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_2_mp(*=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_2_mp(*=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_2_mp(*=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_2_mp(*=, *); }
+      }
+    else
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_2(*=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_2(*=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_2(*=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_2(*=, *); }
+      }
     }
   }
 
@@ -405,10 +593,26 @@ eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out, const eGlueCube
     typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
     typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(=, *); }
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eglue_apply_mp<eglue_type, simd_op_equ>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1_mp(=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1_mp(=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1_mp(=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1_mp(=, *); }
+        }
+      }
+    else
+      {
+      if(simd::eglue_apply<eglue_type, simd_op_equ>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(=, *); }
+        }
+      }
     }
   else
     {
@@ -419,10 +623,20 @@ eglue_core<eglue_type>::apply(Cube<typename T1::elem_type>& out, const eGlueCube
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_3(=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_3(=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_3(=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_3(=, *); }
+    if( mp_gate::eval(out.n_elem) )
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_3_mp(=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_3_mp(=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_3_mp(=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_3_mp(=, *); }
+      }
+    else
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_3(=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_3(=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_3(=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_3(=, *); }
+      }
     }
   }
 
@@ -456,20 +670,46 @@ eglue_core<eglue_type>::apply_inplace_plus(Cube<typename T1::elem_type>& out, co
     typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
     typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(+=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(+=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(+=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(+=, *); }
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eglue_apply_mp<eglue_type, simd_op_plus>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1_mp(+=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1_mp(+=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1_mp(+=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1_mp(+=, *); }
+        }
+      }
+    else
+      {
+      if(simd::eglue_apply<eglue_type, simd_op_plus>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(+=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(+=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(+=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(+=, *); }
+        }
+      }
     }
   else
     {
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_3(+=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_3(+=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_3(+=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_3(+=, *); }
+    if( mp_gate::eval(out.n_elem) && ( (ProxyCube<T1>::has_subview == false) || (P1.is_alias(out) == false) ) && ( (ProxyCube<T2>::has_subview == false) || (P2.is_alias(out) == false) ) )
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_3_mp(+=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_3_mp(+=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_3_mp(+=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_3_mp(+=, *); }
+      }
+    else
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_3(+=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_3(+=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_3(+=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_3(+=, *); }
+      }
     }
   }
 
@@ -503,20 +743,46 @@ eglue_core<eglue_type>::apply_inplace_minus(Cube<typename T1::elem_type>& out, c
     typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
     typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(-=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(-=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(-=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(-=, *); }
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eglue_apply_mp<eglue_type, simd_op_minus>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1_mp(-=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1_mp(-=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1_mp(-=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1_mp(-=, *); }
+        }
+      }
+    else
+      {
+      if(simd::eglue_apply<eglue_type, simd_op_minus>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(-=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(-=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(-=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(-=, *); }
+        }
+      }
     }
   else
     {
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_3(-=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_3(-=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_3(-=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_3(-=, *); }
+    if( mp_gate::eval(out.n_elem) && ( (ProxyCube<T1>::has_subview == false) || (P1.is_alias(out) == false) ) && ( (ProxyCube<T2>::has_subview == false) || (P2.is_alias(out) == false) ) )
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_3_mp(-=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_3_mp(-=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_3_mp(-=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_3_mp(-=, *); }
+      }
+    else
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_3(-=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_3(-=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_3(-=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_3(-=, *); }
+      }
     }
   }
 
@@ -550,20 +816,46 @@ eglue_core<eglue_type>::apply_inplace_schur(Cube<typename T1::elem_type>& out, c
     typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
     typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(*=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(*=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(*=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(*=, *); }
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eglue_apply_mp<eglue_type, simd_op_schur>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1_mp(*=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1_mp(*=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1_mp(*=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1_mp(*=, *); }
+        }
+      }
+    else
+      {
+      if(simd::eglue_apply<eglue_type, simd_op_schur>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(*=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(*=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(*=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(*=, *); }
+        }
+      }
     }
   else
     {
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_3(*=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_3(*=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_3(*=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_3(*=, *); }
+    if( mp_gate::eval(out.n_elem) && ( (ProxyCube<T1>::has_subview == false) || (P1.is_alias(out) == false) ) && ( (ProxyCube<T2>::has_subview == false) || (P2.is_alias(out) == false) ) )
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_3_mp(*=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_3_mp(*=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_3_mp(*=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_3_mp(*=, *); }
+      }
+    else
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_3(*=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_3(*=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_3(*=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_3(*=, *); }
+      }
     }
   }
 
@@ -597,20 +889,46 @@ eglue_core<eglue_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, con
     typename ProxyCube<T1>::ea_type P1 = x.P1.get_ea();
     typename ProxyCube<T2>::ea_type P2 = x.P2.get_ea();
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(/=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(/=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(/=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(/=, *); }
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eglue_apply_mp<eglue_type, simd_op_div>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1_mp(/=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1_mp(/=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1_mp(/=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1_mp(/=, *); }
+        }
+      }
+    else
+      {
+      if(simd::eglue_apply<eglue_type, simd_op_div>(out_mem, P1, P2, n_elem) == false)
+        {
+             if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_1(/=, +); }
+        else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_1(/=, -); }
+        else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_1(/=, /); }
+        else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_1(/=, *); }
+        }
+      }
     }
   else
     {
     const ProxyCube<T1>& P1 = x.P1;
     const ProxyCube<T2>& P2 = x.P2;
     
-         if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_3(/=, +); }
-    else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_3(/=, -); }
-    else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_3(/=, /); }
-    else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_3(/=, *); }
+    if( mp_gate::eval(out.n_elem) && ( (ProxyCube<T1>::has_subview == false) || (P1.is_alias(out) == false) ) && ( (ProxyCube<T2>::has_subview == false) || (P2.is_alias(out) == false) ) )
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_3_mp(/=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_3_mp(/=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_3_mp(/=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_3_mp(/=, *); }
+      }
+    else
+      {
+           if(is_same_type<eglue_type, eglue_plus >::value == true) { arma_applier_3(/=, +); }
+      else if(is_same_type<eglue_type, eglue_minus>::value == true) { arma_applier_3(/=, -); }
+      else if(is_same_type<eglue_type, eglue_div  >::value == true) { arma_applier_3(/=, /); }
+      else if(is_same_type<eglue_type, eglue_schur>::value == true) { arma_applier_3(/=, *); }
+      }
     }
   }
 
@@ -619,6 +937,9 @@ eglue_core<eglue_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, con
 #undef arma_applier_1
 #undef arma_applier_2
 #undef arma_applier_3
+#undef arma_applier_1_mp
+#undef arma_applier_2_mp
+#undef arma_applier_3_mp
 
 
 
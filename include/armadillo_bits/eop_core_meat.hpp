@@ -18,6 +18,9 @@
 #undef arma_applier_1
 #undef arma_applier_2
 #undef arma_applier_3
+#undef arma_applier_1_mp
+#undef arma_applier_2_mp
+#undef arma_applier_3_mp
 #undef operatorA
 
 #define arma_applier_1(operatorA) \
@@ -115,6 +118,61 @@
   }
 
 
+#define arma_applier_1_mp(operatorA) \
+  {\
+  arma_omp_pragma(omp parallel for schedule(static) num_threads(mp_gate::n_threads()))\
+  for(uword i=0; i<n_elem; ++i)\
+    {\
+    out_mem[i] operatorA eop_core<eop_type>::process(P[i], k);\
+    }\
+  }
+
+
+#define arma_applier_2_mp(operatorA) \
+  {\
+  if(n_cols == 1)\
+    {\
+    arma_omp_pragma(omp parallel for schedule(static) num_threads(mp_gate::n_threads()))\
+    for(uword count=0; count < n_rows; ++count)\
+      {\
+      out_mem[count] operatorA eop_core<eop_type>::process(P.at(count,0), k);\
+      }\
+    }\
+  else\
+    {\
+    arma_omp_pragma(omp parallel for schedule(static) num_threads(mp_gate::n_threads()))\
+    for(uword col=0; col < n_cols; ++col)\
+      {\
+      eT* out_col = &(out_mem[col*n_rows]);\
+      \
+      for(uword row=0; row < n_rows; ++row)\
+        {\
+        out_col[row] operatorA eop_core<eop_type>::process(P.at(row,col), k);\
+        }\
+      }\
+    }\
+  }
+
+
+#define arma_applier_3_mp(operatorA) \
+  {\
+  arma_omp_pragma(omp parallel for schedule(static) num_threads(mp_gate::n_threads()) collapse(2))\
+  for(uword slice=0; slice < n_slices; ++slice)\
+    {\
+    for(uword col=0; col < n_cols; ++col)\
+      {\
+      eT* out_col = &(out_mem[ (slice*n_cols + col)*n_rows ]);\
+      \
+      for(uword row=0; row < n_rows; ++row)\
+        {\
+        out_col[row] operatorA eop_core<eop_type>::process(P.at(row,col,slice), k);\
+        }\
+      }\
+    }\
+  }
+
+
+
 
 //
 // matrices
@@ -135,6 +193,12 @@ eop_core<eop_type>::apply(Mat<typename T1::elem_type>& out, const eOp<T1, eop_ty
   // NOTE: we're assuming that the matrix has already been set to the correct size and there is no aliasing;
   // size setting and alias checking is done by either the Mat contructor or operator=()
   
+  // a product of matrices held by Proxy_fused is evaluated directly into out, with the operation applied while the result is in cache
+  if(proxy_fused_apply<eop_type>(out, x.P, x.aux) == true)
+    {
+    return;
+    }
+  
   const eT  k       = x.aux;
         eT* out_mem = out.memptr();
   
@@ -145,16 +209,36 @@ eop_core<eop_type>::apply(Mat<typename T1::elem_type>& out, const eOp<T1, eop_ty
     
     typename Proxy<T1>::ea_type P = x.P.get_ea();
     
-    arma_applier_1(=);
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eop_apply_mp<eop_type, simd_op_equ>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1_mp(=);
+        }
+      }
+    else
+      {
+      if(simd::eop_apply<eop_type, simd_op_equ>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1(=);
+        }
+      }
     }
   else
     {
     const uword n_rows = x.get_n_rows();
     const uword n_cols = x.get_n_cols();
     
-    const Proxy<T1>& P = x.P;
+    const typename eOp<T1, eop_type>::proxy_type& P = x.P;
     
-    arma_applier_2(=);
+    if( mp_gate::eval(n_rows*n_cols) )
+      {
+      arma_applier_2_mp(=);
+      }
+    else
+      {
+      arma_applier_2(=);
+      }
     }
   }
 
@@ -171,6 +255,8 @@ eop_core<eop_type>::apply_inplace_plus(Mat<typename T1::elem_type>& out, const e
   
   typedef typename T1::elem_type eT;
   
+  proxy_fused_prepare(x.P);
+  
   const uword n_rows = x.get_n_rows();
   const uword n_cols = x.get_n_cols();
   
@@ -186,13 +272,33 @@ eop_core<eop_type>::apply_inplace_plus(Mat<typename T1::elem_type>& out, const e
     
     typename Proxy<T1>::ea_type P = x.P.get_ea();
     
-    arma_applier_1(+=);
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eop_apply_mp<eop_type, simd_op_plus>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1_mp(+=);
+        }
+      }
+    else
+      {
+      if(simd::eop_apply<eop_type, simd_op_plus>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1(+=);
+        }
+      }
     }
   else
     {
-    const Proxy<T1>& P = x.P;
-    
-    arma_applier_2(+=);
+    const typename eOp<T1, eop_type>::proxy_type& P = x.P;
+    
+    if( mp_gate::eval(n_rows*n_cols) && ( (Proxy<T1>::has_subview == false) || (P.is_alias(out) == false) ) )
+      {
+      arma_applier_2_mp(+=);
+      }
+    else
+      {
+      arma_applier_2(+=);
+      }
     }
   }
 
@@ -209,6 +315,8 @@ eop_core<eop_type>::apply_inplace_minus(Mat<typename T1::elem_type>& out, const
   
   typedef typename T1::elem_type eT;
   
+  proxy_fused_prepare(x.P);
+  
   const uword n_rows = x.get_n_rows();
   const uword n_cols = x.get_n_cols();
   
@@ -224,13 +332,33 @@ eop_core<eop_type>::apply_inplace_minus(Mat<typename T1::elem_type>& out, const
     
     typename Proxy<T1>::ea_type P = x.P.get_ea();
     
-    arma_applier_1(-=);
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eop_apply_mp<eop_type, simd_op_minus>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1_mp(-=);
+        }
+      }
+    else
+      {
+      if(simd::eop_apply<eop_type, simd_op_minus>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1(-=);
+        }
+      }
     }
   else
     {
-    const Proxy<T1>& P = x.P;
-    
-    arma_applier_2(-=);
+    const typename eOp<T1, eop_type>::proxy_type& P = x.P;
+    
+    if( mp_gate::eval(n_rows*n_cols) && ( (Proxy<T1>::has_subview == false) || (P.is_alias(out) == false) ) )
+      {
+      arma_applier_2_mp(-=);
+      }
+    else
+      {
+      arma_applier_2(-=);
+      }
     }
   }
 
@@ -247,6 +375,8 @@ eop_core<eop_type>::apply_inplace_schur(Mat<typename T1::elem_type>& out, const
   
   typedef typename T1::elem_type eT;
   
+  proxy_fused_prepare(x.P);
+  
   const uword n_rows = x.get_n_rows();
   const uword n_cols = x.get_n_cols();
   
@@ -262,13 +392,33 @@ eop_core<eop_type>::apply_inplace_schur(Mat<typename T1::elem_type>& out, const
     
     typename Proxy<T1>::ea_type P = x.P.get_ea();
     
-    arma_applier_1(*=);
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eop_apply_mp<eop_type, simd_op_schur>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1_mp(*=);
+        }
+      }
+    else
+      {
+      if(simd::eop_apply<eop_type, simd_op_schur>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1(*=);
+        }
+      }
     }
   else
     {
-    const Proxy<T1>& P = x.P;
-    
-    arma_applier_2(*=);
+    const typename eOp<T1, eop_type>::proxy_type& P = x.P;
+    
+    if( mp_gate::eval(n_rows*n_cols) && ( (Proxy<T1>::has_subview == false) || (P.is_alias(out) == false) ) )
+      {
+      arma_applier_2_mp(*=);
+      }
+    else
+      {
+      arma_applier_2(*=);
+      }
     }
   }
 
@@ -285,6 +435,8 @@ eop_core<eop_type>::apply_inplace_div(Mat<typename T1::elem_type>& out, const eO
   
   typedef typename T1::elem_type eT;
   
+  proxy_fused_prepare(x.P);
+  
   const uword n_rows = x.get_n_rows();
   const uword n_cols = x.get_n_cols();
   
@@ -300,13 +452,33 @@ eop_core<eop_type>::apply_inplace_div(Mat<typename T1::elem_type>& out, const eO
     
     typename Proxy<T1>::ea_type P = x.P.get_ea();
     
-    arma_applier_1(/=);
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eop_apply_mp<eop_type, simd_op_div>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1_mp(/=);
+        }
+      }
+    else
+      {
+      if(simd::eop_apply<eop_type, simd_op_div>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1(/=);
+        }
+      }
     }
   else
     {
-    const Proxy<T1>& P = x.P;
-    
-    arma_applier_2(/=);
+    const typename eOp<T1, eop_type>::proxy_type& P = x.P;
+    
+    if( mp_gate::eval(n_rows*n_cols) && ( (Proxy<T1>::has_subview == false) || (P.is_alias(out) == false) ) )
+      {
+      arma_applier_2_mp(/=);
+      }
+    else
+      {
+      arma_applier_2(/=);
+      }
     }
   }
 
@@ -340,7 +512,20 @@ eop_core<eop_type>::apply(Cube<typename T1::elem_type>& out, const eOpCube<T1, e
     
     typename ProxyCube<T1>::ea_type P = x.P.get_ea();
     
-    arma_applier_1(=);
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eop_apply_mp<eop_type, simd_op_equ>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1_mp(=);
+        }
+      }
+    else
+      {
+      if(simd::eop_apply<eop_type, simd_op_equ>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1(=);
+        }
+      }
     }
   else
     {
@@ -350,7 +535,14 @@ eop_core<eop_type>::apply(Cube<typename T1::elem_type>& out, const eOpCube<T1, e
     
     const ProxyCube<T1>& P = x.P;
     
-    arma_applier_3(=);
+    if( mp_gate::eval(out.n_elem) )
+      {
+      arma_applier_3_mp(=);
+      }
+    else
+      {
+      arma_applier_3(=);
+      }
     }
   }
 
@@ -382,13 +574,33 @@ eop_core<eop_type>::apply_inplace_plus(Cube<typename T1::elem_type>& out, const
     
     typename ProxyCube<T1>::ea_type P = x.P.get_ea();
     
-    arma_applier_1(+=);
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eop_apply_mp<eop_type, simd_op_plus>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1_mp(+=);
+        }
+      }
+    else
+      {
+      if(simd::eop_apply<eop_type, simd_op_plus>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1(+=);
+        }
+      }
     }
   else
     {
     const ProxyCube<T1>& P = x.P;
     
-    arma_applier_3(+=);
+    if( mp_gate::eval(out.n_elem) && ( (ProxyCube<T1>::has_subview == false) || (P.is_alias(out) == false) ) )
+      {
+      arma_applier_3_mp(+=);
+      }
+    else
+      {
+      arma_applier_3(+=);
+      }
     }
   }
 
@@ -420,13 +632,33 @@ eop_core<eop_type>::apply_inplace_minus(Cube<typename T1::elem_type>& out, const
     
     typename ProxyCube<T1>::ea_type P = x.P.get_ea();
     
-    arma_applier_1(-=);
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eop_apply_mp<eop_type, simd_op_minus>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1_mp(-=);
+        }
+      }
+    else
+      {
+      if(simd::eop_apply<eop_type, simd_op_minus>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1(-=);
+        }
+      }
     }
   else
     {
     const ProxyCube<T1>& P = x.P;
     
-    arma_applier_3(-=);
+    if( mp_gate::eval(out.n_elem) && ( (ProxyCube<T1>::has_subview == false) || (P.is_alias(out) == false) ) )
+      {
+      arma_applier_3_mp(-=);
+      }
+    else
+      {
+      arma_applier_3(-=);
+      }
     }
   }
 
@@ -458,13 +690,33 @@ eop_core<eop_type>::apply_inplace_schur(Cube<typename T1::elem_type>& out, const
     
     typename ProxyCube<T1>::ea_type P = x.P.get_ea();
     
-    arma_applier_1(*=);
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eop_apply_mp<eop_type, simd_op_schur>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1_mp(*=);
+        }
+      }
+    else
+      {
+      if(simd::eop_apply<eop_type, simd_op_schur>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1(*=);
+        }
+      }
     }
   else
     {
     const ProxyCube<T1>& P = x.P;
     
-    arma_applier_3(*=);
+    if( mp_gate::eval(out.n_elem) && ( (ProxyCube<T1>::has_subview == false) || (P.is_alias(out) == false) ) )
+      {
+      arma_applier_3_mp(*=);
+      }
+    else
+      {
+      arma_applier_3(*=);
+      }
     }
   }
 
@@ -496,13 +748,33 @@ eop_core<eop_type>::apply_inplace_div(Cube<typename T1::elem_type>& out, const e
     
     typename ProxyCube<T1>::ea_type P = x.P.get_ea();
     
-    arma_applier_1(/=);
+    if( mp_gate::eval(n_elem) )
+      {
+      if(simd::eop_apply_mp<eop_type, simd_op_div>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1_mp(/=);
+        }
+      }
+    else
+      {
+      if(simd::eop_apply<eop_type, simd_op_div>(out_mem, P, k, n_elem) == false)
+        {
+        arma_applier_1(/=);
+        }
+      }
     }
   else
     {
     const ProxyCube<T1>& P = x.P;
     
-    arma_applier_3(/=);
+    if( mp_gate::eval(out.n_elem) && ( (ProxyCube<T1>::has_subview == false) || (P.is_alias(out) == false) ) )
+      {
+      arma_applier_3_mp(/=);
+      }
+    else
+      {
+      arma_applier_3(/=);
+      }
     }
   }
 
@@ -637,6 +909,9 @@ eop_core<eop_ceil             >::process(const eT val, const eT  ) { return eop_
 #undef arma_applier_1
 #undef arma_applier_2
 #undef arma_applier_3
+#undef arma_applier_1_mp
+#undef arma_applier_2_mp
+#undef arma_applier_3_mp
 
 
 
@@ -0,0 +1,467 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup fft_engine
+//! @{
+
+
+
+//! \brief
+//! Built-in engine for the discrete Fourier transform of length N,
+//! using the mixed-radix decimation-in-time Cooley-Tukey algorithm.
+//! N is split into factors of 4, 2, 3 and 5, which have specialised butterflies;
+//! any remaining prime factors are handled by a generic (quadratic) butterfly.
+//! The twiddle factors are computed once, in the constructor;
+//! run() does not modify the engine, so one engine can be shared by several threads.
+//! The inverse transform (fwd == false) is not scaled.
+template<typename cx_type, bool fwd>
+class fft_engine
+  {
+  public:
+  
+  typedef typename get_pod_type<cx_type>::result T;
+  
+  const uword N;
+  
+  //! sub-transforms at least this long have their input de-interleaved into contiguous parts before recursing,
+  //! so that large transforms read memory sequentially rather than with large strides
+  static const uword gather_threshold = 16384;
+  
+  inline explicit fft_engine(const uword in_N);
+  
+  inline void run(cx_type* Y, const cx_type* X) const;
+  
+  arma_inline static cx_type mul(const cx_type& a, const cx_type& b);
+  
+  inline static void roots(cx_type* out, const uword n_out, const uword in_N);
+  
+  
+  private:
+  
+  podarray<uword>   radix;      //!< radix of each stage
+  podarray<uword>   residue;    //!< length of the sub-transforms below each stage
+  podarray<uword>   tw_offset;  //!< start of the twiddle factors of each stage
+  podarray<cx_type> twiddles;   //!< twiddle factors of each stage, in the order they are used by the butterflies
+  podarray<cx_type> coeffs;     //!< all twiddle factors: exp(-2 pi i k / N) for the forward transform
+  
+  uword n_stages;
+  uword max_generic;            //!< largest radix handled by the generic butterfly
+  
+  inline void run_stage(const uword stage, cx_type* Y, const cx_type* X, const uword in_stride, const uword stride, cx_type* scratch, cx_type* work) const;
+  
+  inline void butterfly_2(cx_type* Y, const cx_type* tw, const uword m) const;
+  inline void butterfly_3(cx_type* Y, const cx_type* tw, const uword m) const;
+  inline void butterfly_4(cx_type* Y, const cx_type* tw, const uword m) const;
+  inline void butterfly_5(cx_type* Y, const cx_type* tw, const uword m) const;
+  
+  inline void butterfly_generic(cx_type* Y, const uword stride, const uword m, const uword p, cx_type* scratch) const;
+  };
+
+
+
+template<typename cx_type, bool fwd>
+inline
+fft_engine<cx_type,fwd>::fft_engine(const uword in_N)
+  : N(in_N)
+  , n_stages(0)
+  , max_generic(0)
+  {
+  arma_extra_debug_sigprint();
+  
+  // factorise N, preferring the radices with specialised butterflies
+  
+  uword n_radix[64];
+  uword remaining = N;
+  
+  while( (remaining > 1) && (n_stages < 64) )
+    {
+    uword p;
+    
+         if( (remaining % 4) == 0 )  { p = 4; }
+    else if( (remaining % 2) == 0 )  { p = 2; }
+    else if( (remaining % 3) == 0 )  { p = 3; }
+    else if( (remaining % 5) == 0 )  { p = 5; }
+    else
+      {
+      p = 7;
+      
+      while( (remaining % p) != 0 )
+        {
+        p += 2;
+        
+        if( (p*p) > remaining )  { p = remaining; }
+        }
+      
+      max_generic = (std::max)(max_generic, p);
+      }
+    
+    n_radix[n_stages] = p;
+    ++n_stages;
+    
+    remaining /= p;
+    }
+  
+  radix.set_size(n_stages);
+  residue.set_size(n_stages);
+  
+  remaining = N;
+  
+  for(uword i=0; i < n_stages; ++i)
+    {
+    radix[i]   = n_radix[i];
+    remaining /= n_radix[i];
+    residue[i] = remaining;
+    }
+  
+  coeffs.set_size(N);
+  
+  roots(coeffs.memptr(), N, N);
+  
+  // copy the twiddle factors used by each stage into a contiguous block,
+  // so that the butterflies read them sequentially instead of with a stride
+  
+  tw_offset.set_size(n_stages);
+  
+  uword n_tw = 0;
+  
+  for(uword i=0; i < n_stages; ++i)
+    {
+    tw_offset[i] = n_tw;
+    n_tw        += residue[i] * (radix[i] - 1);
+    }
+  
+  twiddles.set_size(n_tw);
+  
+  uword stride = 1;
+  
+  for(uword i=0; i < n_stages; ++i)
+    {
+    const uword p = radix[i];
+    const uword m = residue[i];
+    
+    cx_type* tw = twiddles.memptr() + tw_offset[i];
+    
+    for(uword j=0; j < m; ++j)
+      {
+      for(uword q=1; q < p; ++q)
+        {
+        *tw = coeffs[q*j*stride];
+        ++tw;
+        }
+      }
+    
+    stride *= p;
+    }
+  }
+
+
+
+//! complex multiplication, without the checks for infinities and NaNs
+//! that some compilers add to the generic operator*
+template<typename cx_type, bool fwd>
+arma_inline
+cx_type
+fft_engine<cx_type,fwd>::mul(const cx_type& a, const cx_type& b)
+  {
+  const T a_re = a.real();
+  const T a_im = a.imag();
+  const T b_re = b.real();
+  const T b_im = b.imag();
+  
+  return cx_type( (a_re*b_re - a_im*b_im), (a_re*b_im + a_im*b_re) );
+  }
+
+
+
+//! the first n_out powers of the N-th root of unity used by the transform, ie. exp(-+ 2 pi i k / N);
+//! only the first quarter (or half) of a period is evaluated directly, in double precision,
+//! and the remainder is obtained by symmetry
+template<typename cx_type, bool fwd>
+inline
+void
+fft_engine<cx_type,fwd>::roots(cx_type* out, const uword n_out, const uword in_N)
+  {
+  arma_extra_debug_sigprint();
+  
+  const double theta = ( (fwd) ? double(-2) : double(2) ) * Datum<double>::pi / double(in_N);
+  
+  const bool  use_quarter = ( (in_N % 4) == 0 );
+  const uword n_direct    = (std::min)( n_out, ((use_quarter) ? (in_N/4) : (in_N/2)) + 1 );
+  
+  for(uword k=0; k < n_direct; ++k)
+    {
+    const double phase = theta * double(k);
+    
+    out[k] = cx_type( T(std::cos(phase)), T(std::sin(phase)) );
+    }
+  
+  for(uword k=n_direct; k < n_out; ++k)
+    {
+    if( use_quarter && (k <= in_N/2) )
+      {
+      // multiply by exp(-+ i pi/2), ie. by -i or +i
+      const cx_type& a = out[k - in_N/4];
+      
+      out[k] = (fwd) ? cx_type(a.imag(), -a.real()) : cx_type(-a.imag(), a.real());
+      }
+    else
+      {
+      out[k] = std::conj( out[in_N - k] );
+      }
+    }
+  }
+
+
+
+//! transform the N elements of X and store the result in Y; X and Y must not overlap
+template<typename cx_type, bool fwd>
+inline
+void
+fft_engine<cx_type,fwd>::run(cx_type* Y, const cx_type* X) const
+  {
+  arma_extra_debug_sigprint();
+  
+  if(N <= 1)
+    {
+    if(N == 1)  { Y[0] = X[0]; }
+    
+    return;
+    }
+  
+  podarray<cx_type> scratch(max_generic);
+  
+  // each de-interleaving level needs as many elements as its sub-transform; the levels add up to less than 2N
+  podarray<cx_type> work( (N >= uword(gather_threshold)) ? 2*N : uword(0) );
+  
+  run_stage(0, Y, X, 1, 1, scratch.memptr(), work.memptr());
+  }
+
+
+
+//! the sub-transform at the given stage reads its input from X, with elements in_stride apart;
+//! the sub-transform is N/stride long
+template<typename cx_type, bool fwd>
+inline
+void
+fft_engine<cx_type,fwd>::run_stage(const uword stage, cx_type* Y, const cx_type* X, const uword in_stride, const uword stride, cx_type* scratch, cx_type* work) const
+  {
+  const uword p = radix[stage];
+  const uword m = residue[stage];
+  
+  if( (in_stride == 1) && (m > 1) && ((p*m) >= uword(gather_threshold)) )
+    {
+    // the p sub-transforms of length m use every p-th element;
+    // copy them into contiguous parts of the work area, reading X sequentially
+    
+    for(uword j=0; j < m; ++j)
+      {
+      const cx_type* X_j = &X[j*p];
+      
+      for(uword i=0; i < p; ++i)
+        {
+        work[i*m + j] = X_j[i];
+        }
+      }
+    
+    for(uword i=0; i < p; ++i)
+      {
+      run_stage(stage+1, &Y[i*m], &work[i*m], 1, stride*p, scratch, &work[p*m]);
+      }
+    }
+  else
+  if(m == 1)
+    {
+    for(uword i=0; i < p; ++i)
+      {
+      Y[i] = X[i*in_stride];
+      }
+    }
+  else
+    {
+    // the p sub-transforms of length m use every p-th element, starting at each of the first p elements
+    
+    for(uword i=0; i < p; ++i)
+      {
+      run_stage(stage+1, &Y[i*m], &X[i*in_stride], in_stride*p, stride*p, scratch, work);
+      }
+    }
+  
+  const cx_type* tw = twiddles.memptr() + tw_offset[stage];
+  
+  switch(p)
+    {
+    case 2:  butterfly_2(Y, tw, m);  break;
+    case 3:  butterfly_3(Y, tw, m);  break;
+    case 4:  butterfly_4(Y, tw, m);  break;
+    case 5:  butterfly_5(Y, tw, m);  break;
+    
+    default:  butterfly_generic(Y, stride, m, p, scratch);
+    }
+  }
+
+
+
+template<typename cx_type, bool fwd>
+inline
+void
+fft_engine<cx_type,fwd>::butterfly_2(cx_type* Y, const cx_type* tw, const uword m) const
+  {
+  for(uword i=0; i < m; ++i)
+    {
+    const cx_type t = mul(Y[i+m], tw[i]);
+    
+    Y[i+m]  = Y[i] - t;
+    Y[i]   += t;
+    }
+  }
+
+
+
+template<typename cx_type, bool fwd>
+inline
+void
+fft_engine<cx_type,fwd>::butterfly_3(cx_type* Y, const cx_type* tw, const uword m) const
+  {
+  const T w_imag = coeffs[N/3].imag();  // imaginary part of exp(-+ 2 pi i / 3)
+  
+  for(uword i=0; i < m; ++i)
+    {
+    const cx_type t1 = mul(Y[i+m],   tw[2*i  ]);
+    const cx_type t2 = mul(Y[i+2*m], tw[2*i+1]);
+    
+    const cx_type s = t1 + t2;
+    const cx_type d = (t1 - t2) * w_imag;
+    
+    const cx_type base = Y[i] - s * T(0.5);
+    
+    Y[i]    += s;
+    Y[i+m]   = cx_type( base.real() - d.imag(), base.imag() + d.real() );
+    Y[i+2*m] = cx_type( base.real() + d.imag(), base.imag() - d.real() );
+    }
+  }
+
+
+
+template<typename cx_type, bool fwd>
+inline
+void
+fft_engine<cx_type,fwd>::butterfly_4(cx_type* Y, const cx_type* tw, const uword m) const
+  {
+  for(uword i=0; i < m; ++i)
+    {
+    const cx_type t1 = mul(Y[i+m],   tw[3*i  ]);
+    const cx_type t2 = mul(Y[i+2*m], tw[3*i+1]);
+    const cx_type t3 = mul(Y[i+3*m], tw[3*i+2]);
+    
+    const cx_type a = Y[i] + t2;
+    const cx_type b = Y[i] - t2;
+    const cx_type s = t1 + t3;
+    const cx_type d = t1 - t3;
+    
+    Y[i]     = a + s;
+    Y[i+2*m] = a - s;
+    
+    if(fwd)
+      {
+      Y[i+m]   = cx_type( b.real() + d.imag(), b.imag() - d.real() );
+      Y[i+3*m] = cx_type( b.real() - d.imag(), b.imag() + d.real() );
+      }
+    else
+      {
+      Y[i+m]   = cx_type( b.real() - d.imag(), b.imag() + d.real() );
+      Y[i+3*m] = cx_type( b.real() + d.imag(), b.imag() - d.real() );
+      }
+    }
+  }
+
+
+
+template<typename cx_type, bool fwd>
+inline
+void
+fft_engine<cx_type,fwd>::butterfly_5(cx_type* Y, const cx_type* tw, const uword m) const
+  {
+  const cx_type wa = coeffs[N/5];       // exp(-+ 2 pi i / 5)
+  const cx_type wb = coeffs[(2*N)/5];   // exp(-+ 4 pi i / 5)
+  
+  for(uword i=0; i < m; ++i)
+    {
+    const cx_type s0 = Y[i];
+    const cx_type s1 = mul(Y[i+m],   tw[4*i  ]);
+    const cx_type s2 = mul(Y[i+2*m], tw[4*i+1]);
+    const cx_type s3 = mul(Y[i+3*m], tw[4*i+2]);
+    const cx_type s4 = mul(Y[i+4*m], tw[4*i+3]);
+    
+    const cx_type p14 = s1 + s4;
+    const cx_type m14 = s1 - s4;
+    const cx_type p23 = s2 + s3;
+    const cx_type m23 = s2 - s3;
+    
+    Y[i] = s0 + p14 + p23;
+    
+    const cx_type e1 = s0 + p14 * wa.real() + p23 * wb.real();
+    const cx_type f1 = cx_type( m14.imag() * wa.imag() + m23.imag() * wb.imag(), -(m14.real() * wa.imag()) - m23.real() * wb.imag() );
+    
+    Y[i+m]   = e1 - f1;
+    Y[i+4*m] = e1 + f1;
+    
+    const cx_type e2 = s0 + p14 * wb.real() + p23 * wa.real();
+    const cx_type f2 = cx_type( m23.imag() * wa.imag() - m14.imag() * wb.imag(), m14.real() * wb.imag() - m23.real() * wa.imag() );
+    
+    Y[i+2*m] = e2 + f2;
+    Y[i+3*m] = e2 - f2;
+    }
+  }
+
+
+
+//! direct evaluation of a butterfly with an arbitrary radix p; takes O(p^2) operations
+template<typename cx_type, bool fwd>
+inline
+void
+fft_engine<cx_type,fwd>::butterfly_generic(cx_type* Y, const uword stride, const uword m, const uword p, cx_type* scratch) const
+  {
+  const cx_type* c = coeffs.memptr();
+  
+  for(uword i=0; i < m; ++i)
+    {
+    for(uword q=0; q < p; ++q)
+      {
+      scratch[q] = Y[i + q*m];
+      }
+    
+    for(uword k=0; k < p; ++k)
+      {
+      const uword index = i + k*m;
+      const uword step  = (stride * index) % N;
+      
+      cx_type acc = scratch[0];
+      uword   pos = 0;
+      
+      for(uword q=1; q < p; ++q)
+        {
+        pos += step;
+        
+        if(pos >= N)  { pos -= N; }
+        
+        acc += mul(scratch[q], c[pos]);
+        }
+      
+      Y[index] = acc;
+      }
+    }
+  }
+
+
+
+//! @}
@@ -28,22 +28,7 @@ accu_proxy_linear(const Proxy<T1>& P)
         ea_type A      = P.get_ea();
   const uword   n_elem = P.get_n_elem();
   
-  eT val1 = eT(0);
-  eT val2 = eT(0);
-  
-  uword i,j;
-  for(i=0, j=1; j < n_elem; i+=2, j+=2)
-    {
-    val1 += A[i];
-    val2 += A[j];
-    }
-  
-  if(i < n_elem)
-    {
-    val1 += A[i];   // equivalent to: val1 += A[n_elem-1];
-    }
-  
-  return (val1 + val2);
+  return pairwise_acc<eT>::accumulate(A, n_elem);
   }
 
 
@@ -198,10 +183,15 @@ accu(const subview<eT>& X)
     }
   else
     {
+    // the column sums are combined pairwise, so that the result does not drift for subviews with many columns
+    pairwise_acc<eT> acc;
+    
     for(uword col=0; col < X_n_cols; ++col)
       {
-      val += arrayops::accumulate( X.colptr(col), X_n_rows );
+      acc.add( arrayops::accumulate( X.colptr(col), X_n_rows ) );
       }
+    
+    val = acc.get();
     }
   
   return val;
@@ -244,23 +234,7 @@ accu(const BaseCube<typename T1::elem_type,T1>& X)
           ea_type P      = A.get_ea();
     const uword   n_elem = A.get_n_elem();
     
-    eT val1 = eT(0);
-    eT val2 = eT(0);
-    
-    uword i,j;
-    
-    for(i=0, j=1; j<n_elem; i+=2, j+=2)
-      {
-      val1 += P[i];
-      val2 += P[j];
-      }
-    
-    if(i < n_elem)
-      {
-      val1 += P[i];
-      }
-    
-    return val1 + val2;
+    return pairwise_acc<eT>::accumulate(P, n_elem);
     }
   else
     {
@@ -0,0 +1,34 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup fn_cube_times
+//! @{
+
+
+
+//! slice-wise matrix multiplication of two cubes: slice i of the result is A.slice(i) * B.slice(i).
+//! if A or B has only one slice, the slice is used with each slice of the other cube.
+//! this is meant for many independent products of small matrices (eg. 3x3, 4x4 and 6x6)
+template<typename T1, typename T2>
+arma_inline
+const GlueCube<T1, T2, glue_cube_times>
+cube_times(const BaseCube<typename T1::elem_type,T1>& A, const BaseCube<typename T1::elem_type,T2>& B)
+  {
+  arma_extra_debug_sigprint();
+  
+  return GlueCube<T1, T2, glue_cube_times>(A.get_ref(), B.get_ref());
+  }
+
+
+
+//! @}
@@ -0,0 +1,96 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup fn_fft
+//! @{
+
+
+
+//! FFT of a real vector, or of each column of a real matrix
+template<typename T1>
+inline
+const mtOp<std::complex<typename T1::pod_type>, T1, op_fft_real>
+fft(const Base<typename T1::pod_type, T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  return mtOp<std::complex<typename T1::pod_type>, T1, op_fft_real>(X.get_ref(), uword(0), uword(0));
+  }
+
+
+
+//! N-point FFT of a real vector, or of each column of a real matrix;
+//! the input is truncated or zero padded to have N elements (or rows)
+template<typename T1>
+inline
+const mtOp<std::complex<typename T1::pod_type>, T1, op_fft_real>
+fft(const Base<typename T1::pod_type, T1>& X, const uword N)
+  {
+  arma_extra_debug_sigprint();
+  
+  return mtOp<std::complex<typename T1::pod_type>, T1, op_fft_real>(X.get_ref(), N, uword(1));
+  }
+
+
+
+//! FFT of a complex vector, or of each column of a complex matrix
+template<typename T1>
+inline
+const Op<T1, op_fft_cx>
+fft(const Base<std::complex<typename T1::pod_type>, T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  return Op<T1, op_fft_cx>(X.get_ref(), uword(0), uword(0));
+  }
+
+
+
+template<typename T1>
+inline
+const Op<T1, op_fft_cx>
+fft(const Base<std::complex<typename T1::pod_type>, T1>& X, const uword N)
+  {
+  arma_extra_debug_sigprint();
+  
+  return Op<T1, op_fft_cx>(X.get_ref(), N, uword(1));
+  }
+
+
+
+//! inverse FFT of a complex vector, or of each column of a complex matrix
+template<typename T1>
+inline
+const Op<T1, op_ifft_cx>
+ifft(const Base<std::complex<typename T1::pod_type>, T1>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  return Op<T1, op_ifft_cx>(X.get_ref(), uword(0), uword(0));
+  }
+
+
+
+template<typename T1>
+inline
+const Op<T1, op_ifft_cx>
+ifft(const Base<std::complex<typename T1::pod_type>, T1>& X, const uword N)
+  {
+  arma_extra_debug_sigprint();
+  
+  return Op<T1, op_ifft_cx>(X.get_ref(), N, uword(1));
+  }
+
+
+
+//! @}
@@ -0,0 +1,58 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup fn_inplace_strans
+//! @{
+
+
+
+//! in-place simple transpose of X (the conjugate of complex elements is not taken).
+//! square matrices are always transposed without a copy.
+//! for non-square matrices, method = "fast" transposes via a temporary matrix,
+//! while method = "lowmem" uses scratch memory proportional to n_rows + n_cols, at the cost of speed.
+template<typename eT>
+inline
+void
+inplace_strans(Mat<eT>& X, const char* method = "fast")
+  {
+  arma_extra_debug_sigprint();
+  
+  const char sig = method[0];
+  
+  arma_debug_check
+    (
+    (sig != 'f' && sig != 'F' && sig != 'l' && sig != 'L'),
+    "inplace_strans(): 2nd input argument must be \"fast\" or \"lowmem\""
+    );
+  
+  if(X.n_rows == X.n_cols)
+    {
+    op_strans::apply_inplace_square(X);
+    }
+  else
+  if( (sig == 'l') || (sig == 'L') )
+    {
+    op_strans::apply_inplace_lowmem(X);
+    }
+  else
+    {
+    Mat<eT> tmp;
+    op_strans::apply_noalias(tmp, X);
+    
+    X.steal_mem(tmp);
+    }
+  }
+
+
+
+//! @}
@@ -0,0 +1,59 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup fn_inplace_trans
+//! @{
+
+
+
+//! in-place transpose of X; see inplace_strans() for the meaning of method
+template<typename eT>
+inline
+void
+inplace_trans
+  (
+  Mat<eT>&    X,
+  const char* method = "fast",
+  const typename arma_not_cx<eT>::result* junk = 0
+  )
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  inplace_strans(X, method);
+  }
+
+
+
+//! in-place hermitian transpose of X; see inplace_strans() for the meaning of method
+template<typename eT>
+inline
+void
+inplace_trans
+  (
+  Mat<eT>&    X,
+  const char* method = "fast",
+  const typename arma_cx_only<eT>::result* junk = 0
+  )
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  inplace_strans(X, method);
+  
+  op_htrans::inplace_conj( X.memptr(), X.n_elem );
+  }
+
+
+
+//! @}
@@ -19,7 +19,7 @@ inline
 double
 randu()
   {
-  return double(eop_aux_randu<double>());
+  return double(arma_rng::randu<double>());
   }
 
 
@@ -28,7 +28,7 @@ inline
 typename arma_scalar_only<eT>::result
 randu()
   {
-  return eT(eop_aux_randu<eT>());
+  return eT(arma_rng::randu<eT>());
   }
 
 
@@ -70,7 +70,7 @@ sort_index_helper(umat_elem_type* out_mem, std::vector<packet_type>& packet_vec,
     packet_vec[i].index = i;
     }
   
-  std::sort( packet_vec.begin(), packet_vec.end() );
+  op_sort::generic_sort( &packet_vec[0], n_elem, std::less<packet_type>() );
   
   for(uword i=0; i<n_elem; ++i)
     {
@@ -57,6 +57,7 @@ class eop_conj;
 
 class glue_times;
 class glue_times_diag;
+class glue_times_plus;
 
 class glue_rel_lt;
 class glue_rel_gt;
@@ -134,10 +135,21 @@ template<typename out_eT, typename T1, typename T2, typename  glue_type> class m
 
 template<typename T1> class Proxy;
 template<typename T1> class ProxyCube;
+template<typename T1> class Proxy_fused;
+
+template<typename T1, typename eop_type> struct eop_proxy;
+
+
+template<typename eT> class arma_ascend_sort_helper;
+template<typename eT> class arma_descend_sort_helper;
+
+template<typename T1, typename T2> struct arma_sort_index_packet_ascend;
+template<typename T1, typename T2> struct arma_sort_index_packet_descend;
 
 
 struct arma_vec_indicator   {};
 struct arma_fixed_indicator {};
+struct arma_fused_indicator {};
 
 
 //! \addtogroup injector
@@ -62,6 +62,117 @@ class gemm_emul_tinysq
 
 
 
+//! cache block sizes used by gemm_emul_large
+struct gemm_emul_block
+  {
+  static const uword n_depth = 256;   //!< number of columns of A (and rows of B) held in each packed panel
+  static const uword n_rows  = 128;   //!< number of rows of A packed at a time; the packed block is meant to stay in the L2 cache
+  static const uword n_cols  = 2048;  //!< number of columns of B packed at a time; the packed block is meant to stay in the L3 cache
+  
+  static const uword min_work    = 32*32*32;     //!< smaller multiplications are done directly with dot products, as packing would cost more than it saves
+  static const uword mp_min_work = 128*128*128;  //!< smaller multiplications are not worth splitting across threads
+  };
+
+
+
+//! register tile used by gemm_emul_large:
+//! computes the (n_rows x n_cols) product of a packed panel of A and a packed panel of B.
+//! the generic version holds a 4x4 tile in sixteen scalar accumulators
+template<typename eT, const bool use_simd = simd_pack<eT>::available>
+struct gemm_emul_tile
+  {
+  static const uword n_rows = 4;
+  static const uword n_cols = 4;
+  
+  arma_hot
+  inline
+  static
+  void
+  apply(eT* out, const eT* A_panel, const eT* B_panel, const uword n_depth)
+    {
+    eT c00 = eT(0);  eT c01 = eT(0);  eT c02 = eT(0);  eT c03 = eT(0);
+    eT c10 = eT(0);  eT c11 = eT(0);  eT c12 = eT(0);  eT c13 = eT(0);
+    eT c20 = eT(0);  eT c21 = eT(0);  eT c22 = eT(0);  eT c23 = eT(0);
+    eT c30 = eT(0);  eT c31 = eT(0);  eT c32 = eT(0);  eT c33 = eT(0);
+    
+    for(uword k=0; k < n_depth; ++k)
+      {
+      const eT a0 = A_panel[0];  const eT a1 = A_panel[1];  const eT a2 = A_panel[2];  const eT a3 = A_panel[3];
+      
+      eT b;
+      
+      b = B_panel[0];  c00 += a0*b;  c10 += a1*b;  c20 += a2*b;  c30 += a3*b;
+      b = B_panel[1];  c01 += a0*b;  c11 += a1*b;  c21 += a2*b;  c31 += a3*b;
+      b = B_panel[2];  c02 += a0*b;  c12 += a1*b;  c22 += a2*b;  c32 += a3*b;
+      b = B_panel[3];  c03 += a0*b;  c13 += a1*b;  c23 += a2*b;  c33 += a3*b;
+      
+      A_panel += n_rows;
+      B_panel += n_cols;
+      }
+    
+    out[ 0] = c00;  out[ 1] = c10;  out[ 2] = c20;  out[ 3] = c30;
+    out[ 4] = c01;  out[ 5] = c11;  out[ 6] = c21;  out[ 7] = c31;
+    out[ 8] = c02;  out[ 9] = c12;  out[10] = c22;  out[11] = c32;
+    out[12] = c03;  out[13] = c13;  out[14] = c23;  out[15] = c33;
+    }
+  };
+
+
+
+//! register tile for element types with vector instructions (float and double):
+//! eight vector registers hold a tile with two vectors worth of rows and four columns
+template<typename eT>
+struct gemm_emul_tile<eT, true>
+  {
+  typedef simd_pack<eT>           pack;
+  typedef typename pack::vec_type vec_type;
+  
+  static const uword n_rows = 2*pack::width;
+  static const uword n_cols = 4;
+  
+  arma_hot
+  inline
+  static
+  void
+  apply(eT* out, const eT* A_panel, const eT* B_panel, const uword n_depth)
+    {
+    vec_type c00 = pack::zeros();  vec_type c10 = pack::zeros();
+    vec_type c01 = pack::zeros();  vec_type c11 = pack::zeros();
+    vec_type c02 = pack::zeros();  vec_type c12 = pack::zeros();
+    vec_type c03 = pack::zeros();  vec_type c13 = pack::zeros();
+    
+    for(uword k=0; k < n_depth; ++k)
+      {
+      const vec_type a0 = pack::loadu(&A_panel[0          ]);
+      const vec_type a1 = pack::loadu(&A_panel[pack::width]);
+      
+      vec_type b;
+      
+      b = pack::fill(B_panel[0]);  c00 = pack::add(c00, pack::mul(a0, b));  c10 = pack::add(c10, pack::mul(a1, b));
+      b = pack::fill(B_panel[1]);  c01 = pack::add(c01, pack::mul(a0, b));  c11 = pack::add(c11, pack::mul(a1, b));
+      b = pack::fill(B_panel[2]);  c02 = pack::add(c02, pack::mul(a0, b));  c12 = pack::add(c12, pack::mul(a1, b));
+      b = pack::fill(B_panel[3]);  c03 = pack::add(c03, pack::mul(a0, b));  c13 = pack::add(c13, pack::mul(a1, b));
+      
+      A_panel += n_rows;
+      B_panel += n_cols;
+      }
+    
+    pack::storeu(&out[0*n_rows], c00);  pack::storeu(&out[0*n_rows + pack::width], c10);
+    pack::storeu(&out[1*n_rows], c01);  pack::storeu(&out[1*n_rows + pack::width], c11);
+    pack::storeu(&out[2*n_rows], c02);  pack::storeu(&out[2*n_rows + pack::width], c12);
+    pack::storeu(&out[3*n_rows], c03);  pack::storeu(&out[3*n_rows + pack::width], c13);
+    }
+  };
+
+
+
+//! \brief
+//! multiplication of matrices that are not tiny.
+//! large multiplications use the packed and cache blocked scheme popularised by GotoBLAS:
+//! a block of B and a block of A are copied (packed) into contiguous panels that match the register tile,
+//! so that the innermost kernel (gemm_emul_tile) streams through memory sequentially and stays in cache.
+//! transposes of A and B are handled during packing.
+
 template<const bool do_trans_A=false, const bool do_trans_B=false, const bool use_alpha=false, const bool use_beta=false>
 class gemm_emul_large
   {
@@ -82,6 +193,196 @@ class gemm_emul_large
     )
     {
     arma_extra_debug_sigprint();
+    
+    const uword n_depth = (do_trans_A) ? A.n_rows : A.n_cols;
+    
+    if( (double(C.n_rows) * double(C.n_cols) * double(n_depth)) < double(gemm_emul_block::min_work) )
+      {
+      gemm_emul_large<do_trans_A, do_trans_B, use_alpha, use_beta>::apply_dot(C, A, B, alpha, beta);
+      }
+    else
+      {
+      gemm_emul_large<do_trans_A, do_trans_B, use_alpha, use_beta>::apply_blocked(C, A, B, alpha, beta);
+      }
+    }
+  
+  
+  
+  //! C = alpha*op(A)*op(B) + beta*C, using packed panels of A and B.
+  //! if the multiplication is large enough, C is split into blocks of columns (or rows, if C is tall)
+  //! which are computed by separate threads
+  template<typename eT>
+  inline
+  static
+  void
+  apply_blocked
+    (
+          Mat<eT>& C,
+    const Mat<eT>& A,
+    const Mat<eT>& B,
+    const eT alpha,
+    const eT beta
+    )
+    {
+    arma_extra_debug_sigprint();
+    
+    typedef gemm_emul_tile<eT> tile;
+    
+    const uword C_n_rows = C.n_rows;
+    const uword C_n_cols = C.n_cols;
+    const uword n_depth  = (do_trans_A) ? A.n_rows : A.n_cols;
+    
+    const bool use_mp = ( (double(C_n_rows) * double(C_n_cols) * double(n_depth)) >= double(gemm_emul_block::mp_min_work) ) && mp_gate::available();
+    
+    if(use_mp == false)
+      {
+      gemm_emul_large<do_trans_A, do_trans_B, use_alpha, use_beta>::apply_blocked_part(C, A, B, alpha, beta, 0, C_n_rows, 0, C_n_cols);
+      }
+    else
+      {
+      // each thread owns a contiguous range of whole tiles, so that no two threads write to the same element of C
+      
+      const bool  split_cols = (C_n_cols >= C_n_rows);
+      const uword n_span     = (split_cols) ? C_n_cols     : C_n_rows;
+      const uword unit       = (split_cols) ? uword(tile::n_cols) : uword(tile::n_rows);
+      const uword n_units    = (n_span + unit - 1) / unit;
+      
+      const int   n_threads  = mp_gate::n_threads();
+      const uword n_parts    = (std::min)( n_units, uword(n_threads) );
+      
+      arma_omp_pragma(omp parallel for schedule(static) num_threads(n_threads))
+      for(uword part=0; part < n_parts; ++part)
+        {
+        const uword start = ( (n_units * part) / n_parts ) * unit;
+        const uword end   = (std::min)( ( (n_units * (part+1)) / n_parts ) * unit, n_span );
+        
+        if(split_cols)
+          {
+          gemm_emul_large<do_trans_A, do_trans_B, use_alpha, use_beta>::apply_blocked_part(C, A, B, alpha, beta, 0, C_n_rows, start, end - start);
+          }
+        else
+          {
+          gemm_emul_large<do_trans_A, do_trans_B, use_alpha, use_beta>::apply_blocked_part(C, A, B, alpha, beta, start, end - start, 0, C_n_cols);
+          }
+        }
+      }
+    }
+  
+  
+  
+  //! C(rows,cols) = alpha*op(A)(rows,:)*op(B)(:,cols) + beta*C(rows,cols), for the given block of C
+  template<typename eT>
+  arma_hot
+  inline
+  static
+  void
+  apply_blocked_part
+    (
+          Mat<eT>& C,
+    const Mat<eT>& A,
+    const Mat<eT>& B,
+    const eT alpha,
+    const eT beta,
+    const uword C_row_start,
+    const uword C_n_rows,
+    const uword C_col_start,
+    const uword C_n_cols
+    )
+    {
+    arma_extra_debug_sigprint();
+    
+    typedef gemm_emul_tile<eT> tile;
+    
+    const uword n_depth = (do_trans_A) ? A.n_rows : A.n_cols;
+    
+    for(uword col=0; col < C_n_cols; ++col)
+      {
+      eT* C_col_mem = C.colptr(C_col_start + col) + C_row_start;
+      
+      if(use_beta == false)
+        {
+        arrayops::inplace_set(C_col_mem, eT(0), C_n_rows);
+        }
+      else
+        {
+        arrayops::inplace_mul(C_col_mem, beta, C_n_rows);
+        }
+      }
+    
+    const uword A_block_n_rows = (std::min)(C_n_rows, uword(gemm_emul_block::n_rows));
+    const uword B_block_n_cols = (std::min)(C_n_cols, uword(gemm_emul_block::n_cols));
+    const uword block_n_depth  = (std::min)(n_depth,  uword(gemm_emul_block::n_depth));
+    
+    podarray<eT> A_packed( round_up(A_block_n_rows, tile::n_rows) * block_n_depth );
+    podarray<eT> B_packed( round_up(B_block_n_cols, tile::n_cols) * block_n_depth );
+    
+    eT tile_out[tile::n_rows * tile::n_cols];
+    
+    for(uword col_offset=0; col_offset < C_n_cols; col_offset += gemm_emul_block::n_cols)
+      {
+      const uword col_start    = C_col_start + col_offset;
+      const uword block_n_cols = (std::min)(uword(gemm_emul_block::n_cols), C_n_cols - col_offset);
+      
+      for(uword depth_start=0; depth_start < n_depth; depth_start += gemm_emul_block::n_depth)
+        {
+        const uword block_depth = (std::min)(uword(gemm_emul_block::n_depth), n_depth - depth_start);
+        
+        pack_B<eT, tile::n_cols>(B_packed.memptr(), B, depth_start, block_depth, col_start, block_n_cols);
+        
+        for(uword row_offset=0; row_offset < C_n_rows; row_offset += gemm_emul_block::n_rows)
+          {
+          const uword row_start    = C_row_start + row_offset;
+          const uword block_n_rows = (std::min)(uword(gemm_emul_block::n_rows), C_n_rows - row_offset);
+          
+          pack_A<eT, tile::n_rows>(A_packed.memptr(), A, row_start, block_n_rows, depth_start, block_depth);
+          
+          for(uword tile_col=0; tile_col < block_n_cols; tile_col += tile::n_cols)
+            {
+            const eT*   B_panel      = &(B_packed[tile_col * block_depth]);
+            const uword tile_n_cols  = (std::min)(uword(tile::n_cols), block_n_cols - tile_col);
+            
+            for(uword tile_row=0; tile_row < block_n_rows; tile_row += tile::n_rows)
+              {
+              const eT*   A_panel     = &(A_packed[tile_row * block_depth]);
+              const uword tile_n_rows = (std::min)(uword(tile::n_rows), block_n_rows - tile_row);
+              
+              tile::apply(tile_out, A_panel, B_panel, block_depth);
+              
+              for(uword col=0; col < tile_n_cols; ++col)
+                {
+                const eT* tile_col_mem = &(tile_out[col * tile::n_rows]);
+                      eT* C_col_mem    = C.colptr(col_start + tile_col + col) + row_start + tile_row;
+                
+                for(uword row=0; row < tile_n_rows; ++row)
+                  {
+                  C_col_mem[row] += (use_alpha) ? alpha * tile_col_mem[row] : tile_col_mem[row];
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  
+  
+  
+  //! C = alpha*op(A)*op(B) + beta*C, using dot products of the rows of op(A) and the columns of op(B)
+  template<typename eT>
+  arma_hot
+  inline
+  static
+  void
+  apply_dot
+    (
+          Mat<eT>& C,
+    const Mat<eT>& A,
+    const Mat<eT>& B,
+    const eT alpha = eT(1),
+    const eT beta  = eT(0)
+    )
+    {
+    arma_extra_debug_sigprint();
 
     const uword A_n_rows = A.n_rows;
     const uword A_n_cols = A.n_cols;
@@ -167,7 +468,7 @@ class gemm_emul_large
       Mat<eT> BB;
       op_strans::apply_noalias(BB, B);
       
-      gemm_emul_large<false, false, use_alpha, use_beta>::apply(C, A, BB, alpha, beta);
+      gemm_emul_large<false, false, use_alpha, use_beta>::apply_dot(C, A, BB, alpha, beta);
       }
     else
     if( (do_trans_A == true) && (do_trans_B == true) )
@@ -216,6 +517,93 @@ class gemm_emul_large
       }
     }
   
+  
+  
+  private:
+  
+  arma_inline
+  static
+  uword
+  round_up(const uword n, const uword multiple)
+    {
+    return ( (n + multiple - 1) / multiple ) * multiple;
+    }
+  
+  
+  
+  //! copy a block of op(A) into panels of n_tile_rows rows each;
+  //! within a panel the rows for each depth index are contiguous, and a partial last panel is padded with zeros
+  template<typename eT, const uword n_tile_rows>
+  inline
+  static
+  void
+  pack_A(eT* out, const Mat<eT>& A, const uword row_start, const uword n_rows, const uword depth_start, const uword n_depth)
+    {
+    for(uword tile_row=0; tile_row < n_rows; tile_row += n_tile_rows)
+      {
+      const uword n_valid = (std::min)(n_tile_rows, n_rows - tile_row);
+      const uword row_0   = row_start + tile_row;
+      
+      for(uword k=0; k < n_depth; ++k)
+        {
+        const uword depth = depth_start + k;
+        
+        if(do_trans_A == false)
+          {
+          const eT* A_mem = A.colptr(depth) + row_0;
+          
+          for(uword i=0; i < n_valid; ++i)  { out[i] = A_mem[i]; }
+          }
+        else
+          {
+          for(uword i=0; i < n_valid; ++i)  { out[i] = A.at(depth, row_0 + i); }
+          }
+        
+        for(uword i=n_valid; i < n_tile_rows; ++i)  { out[i] = eT(0); }
+        
+        out += n_tile_rows;
+        }
+      }
+    }
+  
+  
+  
+  //! copy a block of op(B) into panels of n_tile_cols columns each;
+  //! within a panel the columns for each depth index are contiguous, and a partial last panel is padded with zeros
+  template<typename eT, const uword n_tile_cols>
+  inline
+  static
+  void
+  pack_B(eT* out, const Mat<eT>& B, const uword depth_start, const uword n_depth, const uword col_start, const uword n_cols)
+    {
+    for(uword tile_col=0; tile_col < n_cols; tile_col += n_tile_cols)
+      {
+      const uword n_valid = (std::min)(n_tile_cols, n_cols - tile_col);
+      const uword col_0   = col_start + tile_col;
+      
+      for(uword k=0; k < n_depth; ++k)
+        {
+        const uword depth = depth_start + k;
+        
+        if(do_trans_B == false)
+          {
+          for(uword j=0; j < n_valid; ++j)  { out[j] = B.at(depth, col_0 + j); }
+          }
+        else
+          {
+          const eT* B_mem = B.colptr(depth) + col_0;
+          
+          for(uword j=0; j < n_valid; ++j)  { out[j] = B_mem[j]; }
+          }
+        
+        for(uword j=n_valid; j < n_tile_cols; ++j)  { out[j] = eT(0); }
+        
+        out += n_tile_cols;
+        }
+      }
+    }
+  
+  
   };
     
   
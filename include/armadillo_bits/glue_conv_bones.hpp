@@ -21,7 +21,18 @@ class glue_conv
   {
   public:
 
+  //! the shorter vector must have at least this many elements before FFT based convolution is considered
+  static const uword fft_min_len = 32;
+  
   template<typename T1, typename T2> inline static void apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2,glue_conv>& X);
+  
+  template<typename eT> inline static void apply_direct(eT* out_mem, const eT* h_mem, const uword h_n_elem, const eT* x_mem, const uword x_n_elem);
+  
+  template<typename eT> inline static bool apply_fft(eT* out_mem, const eT* h_mem, const uword h_n_elem, const eT* x_mem, const uword x_n_elem, const typename arma_not_blas_type<eT>::result* junk = 0);
+  template<typename eT> inline static bool apply_fft(eT* out_mem, const eT* h_mem, const uword h_n_elem, const eT* x_mem, const uword x_n_elem, const typename arma_float_only<eT>::result*    junk = 0);
+  template<typename eT> inline static bool apply_fft(eT* out_mem, const eT* h_mem, const uword h_n_elem, const eT* x_mem, const uword x_n_elem, const typename arma_cx_only<eT>::result*       junk = 0);
+  
+  inline static uword fft_len(const uword h_n_elem, const uword out_n_elem, const bool is_cx);
   };
 
 
@@ -15,7 +15,9 @@
 //! @{
 
 
-//! rudimentary implementation of the convolution operation
+//! Convolution of two vectors.
+//! Short convolutions are evaluated directly;
+//! longer ones use the FFT via the overlap-save method (see apply_fft())
 
 template<typename T1, typename T2>
 inline
@@ -59,6 +61,26 @@ glue_conv::apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2,glue_conv>&
         eT* out_mem = out.memptr();
   
   
+  if( glue_conv::apply_fft(out_mem, h_mem, h_n_elem, x_mem, x_n_elem) == false )
+    {
+    glue_conv::apply_direct(out_mem, h_mem, h_n_elem, x_mem, x_n_elem);
+    }
+  }
+
+
+
+//! rudimentary implementation of the convolution operation
+
+template<typename eT>
+inline
+void
+glue_conv::apply_direct(eT* out_mem, const eT* h_mem, const uword h_n_elem, const eT* x_mem, const uword x_n_elem)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword out_n_elem = h_n_elem + x_n_elem - 1;
+  
+  
   for(uword out_i = 0; out_i < (h_n_elem-1); ++out_i)
     {
     eT acc = eT(0);
@@ -102,8 +124,269 @@ glue_conv::apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2,glue_conv>&
     
     out_mem[out_i] = acc;
     }
+  }
+
+
+
+//! FFT based convolution is not used for integer elements
+
+template<typename eT>
+inline
+bool
+glue_conv::apply_fft(eT*, const eT*, const uword, const eT*, const uword, const typename arma_not_blas_type<eT>::result* junk)
+  {
+  arma_ignore(junk);
+  
+  return false;
+  }
+
+
+
+//! \brief
+//! FFT based convolution of real vectors, using the overlap-save method.
+//! The output is split into blocks of L-h_n_elem+1 elements;
+//! each block is the valid part of the circular convolution (of length L) of h with a segment of x.
+//! Two segments are transformed at once, as the real and imaginary parts of one complex vector;
+//! as h is real, the two convolutions end up in the real and imaginary parts of the result.
+//! The blocks are independent, and are processed in parallel if OpenMP is enabled.
+//! Returns false if the direct method is expected to be faster.
+
+template<typename eT>
+inline
+bool
+glue_conv::apply_fft(eT* out_mem, const eT* h_mem, const uword h_n_elem, const eT* x_mem, const uword x_n_elem, const typename arma_float_only<eT>::result* junk)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef std::complex<eT> cx_type;
+  
+  const uword out_n_elem = h_n_elem + x_n_elem - 1;
+  
+  const uword L = glue_conv::fft_len(h_n_elem, out_n_elem, false);
+  
+  if(L == 0)
+    {
+    return false;
+    }
+  
+  const fft_engine<cx_type,true > fwd_engine(L);
+  const fft_engine<cx_type,false> inv_engine(L);
+  
+  const uword offset   = h_n_elem - 1;
+  const uword B        = L - offset;
+  const uword n_blocks = (out_n_elem + B - 1) / B;
+  const uword n_pairs  = (n_blocks + 1) / 2;
+  
+  // spectrum of h; the normalisation of the inverse transform is folded in
+  
+  podarray<cx_type> H(L);
+  
+    {
+    podarray<cx_type> tmp(L);
+    
+    const eT scale = eT(1) / eT(L);
+    
+    for(uword i=0; i < L; ++i)
+      {
+      tmp[i] = cx_type( ((i < h_n_elem) ? (h_mem[i] * scale) : eT(0)), eT(0) );
+      }
+    
+    fwd_engine.run(H.memptr(), tmp.memptr());
+    }
+  
+  const bool use_mp = (n_pairs > 1) && mp_gate::eval(L * n_pairs);
+  
+  arma_omp_pragma(omp parallel if(use_mp))
+    {
+    podarray<cx_type> seg(L);
+    podarray<cx_type> spec(L);
+    
+    arma_omp_pragma(omp for schedule(static))
+    for(uword pair=0; pair < n_pairs; ++pair)
+      {
+      // block j produces out[j*B ... j*B+B-1], and reads x[j*B-offset ... j*B-offset+L-1], zero padded
+      
+      const uword start_a = (2*pair    ) * B;
+      const uword start_b = (2*pair + 1) * B;
+      
+      for(uword i=0; i < L; ++i)
+        {
+        const uword pos_a = start_a + i;
+        const uword pos_b = start_b + i;
+        
+        const eT val_a = ( (pos_a >= offset) && ((pos_a - offset) < x_n_elem) ) ? x_mem[pos_a - offset] : eT(0);
+        const eT val_b = ( (pos_b >= offset) && ((pos_b - offset) < x_n_elem) ) ? x_mem[pos_b - offset] : eT(0);
+        
+        seg[i] = cx_type(val_a, val_b);
+        }
+      
+      fwd_engine.run(spec.memptr(), seg.memptr());
+      
+      for(uword i=0; i < L; ++i)
+        {
+        spec[i] = fft_engine<cx_type,true>::mul(spec[i], H[i]);
+        }
+      
+      inv_engine.run(seg.memptr(), spec.memptr());
+      
+      // the first offset elements of each circular convolution are wrapped around, and are discarded
+      
+      for(uword i=0; i < B; ++i)
+        {
+        const cx_type val = seg[offset + i];
+        
+        if( (start_a + i) < out_n_elem )  { out_mem[start_a + i] = val.real(); }
+        if( (start_b + i) < out_n_elem )  { out_mem[start_b + i] = val.imag(); }
+        }
+      }
+    }
+  
+  arma_ignore(use_mp);
+  
+  return true;
+  }
+
+
+
+//! FFT based convolution of complex vectors, using the overlap-save method
+
+template<typename eT>
+inline
+bool
+glue_conv::apply_fft(eT* out_mem, const eT* h_mem, const uword h_n_elem, const eT* x_mem, const uword x_n_elem, const typename arma_cx_only<eT>::result* junk)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  const uword out_n_elem = h_n_elem + x_n_elem - 1;
+  
+  const uword L = glue_conv::fft_len(h_n_elem, out_n_elem, true);
+  
+  if(L == 0)
+    {
+    return false;
+    }
+  
+  const fft_engine<eT,true > fwd_engine(L);
+  const fft_engine<eT,false> inv_engine(L);
+  
+  const uword offset   = h_n_elem - 1;
+  const uword B        = L - offset;
+  const uword n_blocks = (out_n_elem + B - 1) / B;
+  
+  podarray<eT> H(L);
+  
+    {
+    podarray<eT> tmp(L);
+    
+    const T scale = T(1) / T(L);
+    
+    for(uword i=0; i < L; ++i)
+      {
+      tmp[i] = (i < h_n_elem) ? (h_mem[i] * scale) : eT(0);
+      }
+    
+    fwd_engine.run(H.memptr(), tmp.memptr());
+    }
+  
+  const bool use_mp = (n_blocks > 1) && mp_gate::eval(L * n_blocks);
   
+  arma_omp_pragma(omp parallel if(use_mp))
+    {
+    podarray<eT> seg(L);
+    podarray<eT> spec(L);
+    
+    arma_omp_pragma(omp for schedule(static))
+    for(uword block=0; block < n_blocks; ++block)
+      {
+      const uword start = block * B;
+      
+      for(uword i=0; i < L; ++i)
+        {
+        const uword pos = start + i;
+        
+        seg[i] = ( (pos >= offset) && ((pos - offset) < x_n_elem) ) ? x_mem[pos - offset] : eT(0);
+        }
+      
+      fwd_engine.run(spec.memptr(), seg.memptr());
+      
+      for(uword i=0; i < L; ++i)
+        {
+        spec[i] = fft_engine<eT,true>::mul(spec[i], H[i]);
+        }
+      
+      inv_engine.run(seg.memptr(), spec.memptr());
+      
+      for(uword i=0; i < B; ++i)
+        {
+        if( (start + i) < out_n_elem )  { out_mem[start + i] = seg[offset + i]; }
+        }
+      }
+    }
+  
+  arma_ignore(use_mp);
+  
+  return true;
+  }
+
+
+
+//! Length of the transforms for FFT based convolution, chosen to minimise the estimated cost;
+//! returns zero if the direct method is estimated to be cheaper.
+//! For real elements, two blocks are processed by each pair of transforms;
+//! for complex elements, each multiply-add of the direct method is counted as four.
+
+inline
+uword
+glue_conv::fft_len(const uword h_n_elem, const uword out_n_elem, const bool is_cx)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(h_n_elem < uword(fft_min_len))
+    {
+    return 0;
+    }
+  
+  // costs are in units of one multiply-add of the direct method;
+  // a length L block takes two transforms of about L*log2(L) butterfly operations each, plus the product of the spectra
+  
+  const double direct_cost = double(h_n_elem) * double(out_n_elem) * ( (is_cx) ? double(4) : double(1) );
+  
+  double best_cost = direct_cost;
+  uword  best_L    = 0;
+  
+  uword L      = 1;
+  uword log2_L = 0;
+  
+  while(L < 2*h_n_elem)  { L *= 2; ++log2_L; }
+  
+  while(true)
+    {
+    const uword  B        = L - h_n_elem + 1;
+    const uword  n_blocks = (out_n_elem + B - 1) / B;
+    const double n_fft    = (is_cx) ? double(n_blocks) : double((n_blocks + 1) / 2);
+    
+    const double fft_cost = n_fft * double(L) * ( double(2*log2_L) + double(2) );
+    
+    if(fft_cost < best_cost)
+      {
+      best_cost = fft_cost;
+      best_L    = L;
+      }
+    
+    if( (B >= out_n_elem) || (log2_L >= 30) )
+      {
+      break;
+      }
+    
+    L *= 2;
+    ++log2_L;
+    }
   
+  return best_L;
   }
 
 
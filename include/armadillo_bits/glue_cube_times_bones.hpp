@@ -0,0 +1,47 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup glue_cube_times
+//! @{
+
+
+
+//! slice-wise matrix multiplication of two cubes, ie. out.slice(i) = A.slice(i) * B.slice(i)
+class glue_cube_times
+  {
+  public:
+  
+  static const uword max_fixed_size = 6;  //!< products of square slices up to this size use kernels with sizes known at compile time
+  
+  template<typename T1, typename T2>
+  inline static void apply(Cube<typename T1::elem_type>& out, const GlueCube<T1,T2,glue_cube_times>& X);
+  
+  template<typename eT>
+  inline static void apply_noalias(Cube<eT>& out, const Cube<eT>& A, const Cube<eT>& B);
+  
+  template<uword N, typename eT>
+  inline static void apply_square(Cube<eT>& out, const Cube<eT>& A, const Cube<eT>& B, const uword A_stride, const uword B_stride);
+  
+  template<uword n_rows, uword n_inner, uword n_cols, typename eT>
+  inline static void apply_fixed(eT* out, const eT* A, const uword A_stride, const eT* B, const uword B_stride, const uword n_slices);
+  
+  template<uword n_rows, uword n_inner, uword n_cols, typename eT>
+  arma_inline static void apply_fixed_slice(eT* out, const eT* A, const eT* B);
+  
+  template<typename eT>
+  inline static void apply_generic(Cube<eT>& out, const Cube<eT>& A, const uword A_stride, const Cube<eT>& B, const uword B_stride);
+  };
+
+
+
+//! @}
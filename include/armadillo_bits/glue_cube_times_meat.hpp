@@ -0,0 +1,226 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup glue_cube_times
+//! @{
+
+
+
+template<typename T1, typename T2>
+inline
+void
+glue_cube_times::apply(Cube<typename T1::elem_type>& out, const GlueCube<T1,T2,glue_cube_times>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const unwrap_cube<T1> A_tmp(X.A);
+  const unwrap_cube<T2> B_tmp(X.B);
+  
+  const Cube<eT>& A = A_tmp.M;
+  const Cube<eT>& B = B_tmp.M;
+  
+  if( (&out != &A) && (&out != &B) )
+    {
+    glue_cube_times::apply_noalias(out, A, B);
+    }
+  else  // we have aliasing
+    {
+    Cube<eT> C;
+    
+    glue_cube_times::apply_noalias(C, A, B);
+    
+    out.steal_mem(C);
+    }
+  }
+
+
+
+//! a cube with one slice is used with each slice of the other cube
+template<typename eT>
+inline
+void
+glue_cube_times::apply_noalias(Cube<eT>& out, const Cube<eT>& A, const Cube<eT>& B)
+  {
+  arma_extra_debug_sigprint();
+  
+  arma_debug_check
+    (
+    ( (A.n_slices != B.n_slices) && (A.n_slices != 1) && (B.n_slices != 1) ),
+    "cube_times(): number of slices must be the same"
+    );
+  
+  arma_debug_assert_mul_size(A.n_rows, A.n_cols, B.n_rows, B.n_cols, "cube_times()");
+  
+  const uword n_slices = (A.n_slices == 1) ? B.n_slices : A.n_slices;
+  
+  out.set_size(A.n_rows, B.n_cols, n_slices);
+  
+  if(out.n_elem == 0)
+    {
+    return;
+    }
+  
+  if(A.n_cols == 0)
+    {
+    out.zeros();
+    return;
+    }
+  
+  const uword A_stride = (A.n_slices == 1) ? uword(0) : A.n_elem_slice;
+  const uword B_stride = (B.n_slices == 1) ? uword(0) : B.n_elem_slice;
+  
+  if( (A.n_rows == A.n_cols) && (A.n_rows <= max_fixed_size) && ( (B.n_cols == A.n_rows) || (B.n_cols == 1) ) )
+    {
+    switch(A.n_rows)
+      {
+      case 1:  glue_cube_times::apply_square<1>(out, A, B, A_stride, B_stride);  break;
+      case 2:  glue_cube_times::apply_square<2>(out, A, B, A_stride, B_stride);  break;
+      case 3:  glue_cube_times::apply_square<3>(out, A, B, A_stride, B_stride);  break;
+      case 4:  glue_cube_times::apply_square<4>(out, A, B, A_stride, B_stride);  break;
+      case 5:  glue_cube_times::apply_square<5>(out, A, B, A_stride, B_stride);  break;
+      case 6:  glue_cube_times::apply_square<6>(out, A, B, A_stride, B_stride);  break;
+      
+      default:
+        ;
+      }
+    }
+  else
+    {
+    glue_cube_times::apply_generic(out, A, A_stride, B, B_stride);
+    }
+  }
+
+
+
+//! slices of A are NxN matrices; slices of B are either NxN matrices or column vectors of length N
+template<uword N, typename eT>
+inline
+void
+glue_cube_times::apply_square(Cube<eT>& out, const Cube<eT>& A, const Cube<eT>& B, const uword A_stride, const uword B_stride)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(B.n_cols == N)
+    {
+    glue_cube_times::apply_fixed<N,N,N>(out.memptr(), A.memptr(), A_stride, B.memptr(), B_stride, out.n_slices);
+    }
+  else
+    {
+    glue_cube_times::apply_fixed<N,N,1>(out.memptr(), A.memptr(), A_stride, B.memptr(), B_stride, out.n_slices);
+    }
+  }
+
+
+
+//! the slices are processed in parallel if the total amount of work is large enough
+template<uword n_rows, uword n_inner, uword n_cols, typename eT>
+arma_hot
+inline
+void
+glue_cube_times::apply_fixed(eT* out, const eT* A, const uword A_stride, const eT* B, const uword B_stride, const uword n_slices)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword out_stride = n_rows * n_cols;
+  
+  const bool use_mp    = (double(n_slices) * double(n_rows * n_inner * n_cols) >= double(arma_config::mp_threshold)) && mp_gate::available();
+  const int  n_threads = mp_gate::n_threads();
+  
+  arma_omp_pragma(omp parallel for schedule(static) if(use_mp) num_threads(n_threads))
+  for(uword s=0; s < n_slices; ++s)
+    {
+    glue_cube_times::apply_fixed_slice<n_rows, n_inner, n_cols>( &(out[s*out_stride]), &(A[s*A_stride]), &(B[s*B_stride]) );
+    }
+  
+  arma_ignore(use_mp);
+  arma_ignore(n_threads);
+  }
+
+
+
+//! out = A*B, where the sizes of all matrices are known at compile time, allowing the compiler to fully unroll and vectorise the loops
+template<uword n_rows, uword n_inner, uword n_cols, typename eT>
+arma_hot
+arma_inline
+void
+glue_cube_times::apply_fixed_slice(eT* out, const eT* A, const eT* B)
+  {
+  for(uword col=0; col < n_cols; ++col)
+    {
+    const eT* B_col = &(B[col*n_inner]);
+    
+    eT acc[n_rows];
+    
+    for(uword row=0; row < n_rows; ++row)
+      {
+      acc[row] = A[row] * B_col[0];
+      }
+    
+    for(uword k=1; k < n_inner; ++k)
+      {
+      const eT* A_col = &(A[k*n_rows]);
+      const eT  val   = B_col[k];
+      
+      for(uword row=0; row < n_rows; ++row)
+        {
+        acc[row] += A_col[row] * val;
+        }
+      }
+    
+    eT* out_col = &(out[col*n_rows]);
+    
+    for(uword row=0; row < n_rows; ++row)
+      {
+      out_col[row] = acc[row];
+      }
+    }
+  }
+
+
+
+//! slices of any size; each product is done by glue_times, using matrices which refer to the memory of the slices.
+//! many small products are processed in parallel, while large products are parallelised by glue_times itself
+template<typename eT>
+inline
+void
+glue_cube_times::apply_generic(Cube<eT>& out, const Cube<eT>& A, const uword A_stride, const Cube<eT>& B, const uword B_stride)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_slices = out.n_slices;
+  
+  const double slice_work = double(A.n_rows) * double(A.n_cols) * double(B.n_cols);
+  
+  const bool use_mp    = (slice_work < double(gemm_emul_block::mp_min_work)) && (double(n_slices) * slice_work >= double(arma_config::mp_threshold)) && mp_gate::available();
+  const int  n_threads = mp_gate::n_threads();
+  
+  arma_omp_pragma(omp parallel for schedule(static) if(use_mp) num_threads(n_threads))
+  for(uword s=0; s < n_slices; ++s)
+    {
+    const Mat<eT> A_slice('j', &(A.mem[s*A_stride]), A.n_rows, A.n_cols);
+    const Mat<eT> B_slice('j', &(B.mem[s*B_stride]), B.n_rows, B.n_cols);
+    
+    Mat<eT> out_slice(out.slice_memptr(s), out.n_rows, out.n_cols, false, true);
+    
+    glue_times::apply<eT, false, false, false>(out_slice, A_slice, B_slice, eT(0));
+    }
+  
+  arma_ignore(use_mp);
+  arma_ignore(n_threads);
+  }
+
+
+
+//! @}
@@ -68,19 +68,39 @@ struct glue_times_redirect<2>
   };
 
 
-template<>
-struct glue_times_redirect<3>
+
+//! Epilogue for glue_times::apply_fused(): adds a matrix to each block of the result of a matrix multiplication.
+//! The matrix has the same size as the result; offset is the position of the block within the result.
+template<typename eT>
+class glue_times_epilogue
   {
-  template<typename T1, typename T2, typename T3>
-  arma_hot inline static void apply(Mat<typename T1::elem_type>& out, const Glue< Glue<T1,T2,glue_times>,T3,glue_times>& X);
+  public:
+  
+  arma_aligned const eT* bias_mem;  //!< memory of the matrix to add, or NULL if there is nothing to do
+  
+  inline explicit glue_times_epilogue(const eT* in_bias_mem);
+  
+  arma_inline bool is_active() const;
+  
+  arma_hot inline void apply(eT* mem, const uword offset, const uword n_elem) const;
   };
 
 
-template<>
-struct glue_times_redirect<4>
+
+//! Epilogue for glue_times::apply_fused(): as glue_times_epilogue, followed by the element-wise operation eop_type (eg. exp(), tanh())
+template<typename eT, typename eop_type>
+class glue_times_epilogue_eop
   {
-  template<typename T1, typename T2, typename T3, typename T4>
-  arma_hot inline static void apply(Mat<typename T1::elem_type>& out, const Glue< Glue< Glue<T1,T2,glue_times>, T3, glue_times>, T4, glue_times>& X);
+  public:
+  
+  arma_aligned const eT* bias_mem;  //!< memory of the matrix to add, or NULL if there is no matrix to add
+  arma_aligned const eT  aux;       //!< auxiliary data for eop_type
+  
+  inline glue_times_epilogue_eop(const eT* in_bias_mem, const eT in_aux);
+  
+  arma_inline bool is_active() const;
+  
+  arma_hot inline void apply(eT* mem, const uword offset, const uword n_elem) const;
   };
 
 
@@ -90,6 +110,10 @@ class glue_times
   {
   public:
   
+  static const uword chain_scratch_local_n_elem = 64;  //!< intermediate products in a chain of multiplications which fit in this many elements are stored on the stack
+  
+  static const uword fused_panel_n_bytes = 256*1024;   //!< when a product has an epilogue, the result is evaluated in panels of columns which fit in this many bytes (ie. in the L2 cache)
+  
   
   template<typename T1, typename T2>
   arma_hot inline static void apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2,glue_times>& X);
@@ -101,6 +125,9 @@ class glue_times
   template<typename T1, typename T2>
   arma_hot inline static void apply_inplace_plus(Mat<typename T1::elem_type>& out, const Glue<T1, T2, glue_times>& X, const sword sign);
   
+  template<typename T1, typename T2, typename epilogue_type>
+  arma_hot inline static void apply_inplace_plus(Mat<typename T1::elem_type>& out, const Glue<T1, T2, glue_times>& X, const sword sign, const typename T1::elem_type beta, const epilogue_type& epilogue);
+  
   template<typename eT1, typename eT2>
   inline static void apply_mixed(Mat<typename promote_type<eT1,eT2>::result>& out, const Mat<eT1>& X, const Mat<eT2>& Y);
   
@@ -117,6 +144,35 @@ class glue_times
   template<typename eT, const bool do_trans_A, const bool do_trans_B, const bool do_trans_C, const bool do_trans_D, const bool do_scalar_times>
   arma_hot inline static void apply(Mat<eT>& out, const Mat<eT>& A, const Mat<eT>& B, const Mat<eT>& C, const Mat<eT>& D, const eT val);
   
+  
+  template<uword N, typename eT>
+  arma_hot inline static void apply_chain(Mat<eT>& out, const Mat<eT>** mats, const bool* do_trans, const eT val, const bool use_val);
+  
+  template<typename eT>
+  arma_hot inline static void apply_chain_node(Mat<eT>& out, const Mat<eT>** mats, const bool* do_trans, const uword* dims, const uword* split, const uword N, const uword i, const uword j, eT* scratch, const eT val, const bool use_val);
+  
+  inline static uword apply_chain_scratch_size(const uword* dims, const uword* split, const uword N, const uword i, const uword j);
+  
+  template<typename eT>
+  arma_hot inline static void apply_runtime(Mat<eT>& out, const Mat<eT>& A, const bool do_trans_A, const Mat<eT>& B, const bool do_trans_B, const eT val, const bool use_val);
+  
+  
+  template<typename eT, const bool do_trans_A, const bool do_trans_B, const bool use_alpha, const bool use_beta, typename epilogue_type>
+  arma_hot inline static void apply_fused(Mat<eT>& out, const Mat<eT>& A, const Mat<eT>& B, const eT alpha, const eT beta, const epilogue_type& epilogue);
+  
+  };
+
+
+
+//! Class which implements the immediate evaluation of A*B + C,
+//! where C is added to the result of the multiplication while it is still in cache (see operator+)
+class glue_times_plus
+  {
+  public:
+  
+  template<typename T1, typename T2, typename T3>
+  arma_hot inline static void apply(Mat<typename T1::elem_type>& out, const Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus>& X);
+  
   };
 
 
@@ -16,6 +16,95 @@
 
 
 
+//! Holds the operands of a chain of matrix multiplications, eg. A*B*C*D.
+//! Sub-chains grouped by parentheses, eg. A*(B*C), are included as individual operands,
+//! so that the order of evaluation of the entire chain can be chosen by glue_times::apply_chain().
+//! Each operand is held by partial_unwrap_check, which detects transposes, scalar multipliers and aliasing with the output.
+
+template<typename T1>
+struct glue_times_chain
+  {
+  typedef typename T1::elem_type eT;
+  
+  static const uword n_mat    = 1;
+  static const bool  do_times = partial_unwrap_check<T1>::do_times;
+  
+  inline glue_times_chain(const T1& X, const Mat<eT>& out);
+  
+  inline void extract(const Mat<eT>** mats, bool* do_trans, eT& val) const;
+  
+  const partial_unwrap_check<T1> tmp;
+  };
+
+
+template<typename T1, typename T2>
+struct glue_times_chain< Glue<T1,T2,glue_times> >
+  {
+  typedef typename T1::elem_type eT;
+  
+  static const uword n_mat    = glue_times_chain<T1>::n_mat    + glue_times_chain<T2>::n_mat;
+  static const bool  do_times = glue_times_chain<T1>::do_times || glue_times_chain<T2>::do_times;
+  
+  inline glue_times_chain(const Glue<T1,T2,glue_times>& X, const Mat<eT>& out);
+  
+  inline void extract(const Mat<eT>** mats, bool* do_trans, eT& val) const;
+  
+  const glue_times_chain<T1> lhs;
+  const glue_times_chain<T2> rhs;
+  };
+
+
+
+template<typename T1>
+inline
+glue_times_chain<T1>::glue_times_chain(const T1& X, const Mat<eT>& out)
+  : tmp(X, out)
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+template<typename T1>
+inline
+void
+glue_times_chain<T1>::extract(const Mat<eT>** mats, bool* do_trans, eT& val) const
+  {
+  mats[0]     = &(tmp.M);
+  do_trans[0] = partial_unwrap_check<T1>::do_trans;
+  
+  if(partial_unwrap_check<T1>::do_times)
+    {
+    val *= tmp.get_val();
+    }
+  }
+
+
+
+template<typename T1, typename T2>
+inline
+glue_times_chain< Glue<T1,T2,glue_times> >::glue_times_chain(const Glue<T1,T2,glue_times>& X, const Mat<eT>& out)
+  : lhs(X.A, out)
+  , rhs(X.B, out)
+  {
+  arma_extra_debug_sigprint();
+  }
+
+
+
+template<typename T1, typename T2>
+inline
+void
+glue_times_chain< Glue<T1,T2,glue_times> >::extract(const Mat<eT>** mats, bool* do_trans, eT& val) const
+  {
+  const uword lhs_n_mat = glue_times_chain<T1>::n_mat;
+  
+  lhs.extract(mats,             do_trans,             val);
+  rhs.extract(mats + lhs_n_mat, do_trans + lhs_n_mat, val);
+  }
+
+
+
 template<bool is_eT_blas_type>
 template<typename T1, typename T2>
 arma_hot
@@ -99,6 +188,7 @@ glue_times_redirect2_helper<true>::apply(Mat<typename T1::elem_type>& out, const
 
 
 
+//! three or more matrices; the order of the multiplications is chosen by glue_times::apply_chain()
 template<uword N>
 template<typename T1, typename T2>
 arma_hot
@@ -110,23 +200,17 @@ glue_times_redirect<N>::apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2
   
   typedef typename T1::elem_type eT;
   
-  const partial_unwrap_check<T1> tmp1(X.A, out);
-  const partial_unwrap_check<T2> tmp2(X.B, out);
+  typedef glue_times_chain< Glue<T1,T2,glue_times> > chain_type;
   
-  const Mat<eT>& A = tmp1.M;
-  const Mat<eT>& B = tmp2.M;
+  const chain_type chain(X, out);
   
-  const bool use_alpha = partial_unwrap_check<T1>::do_times || partial_unwrap_check<T2>::do_times;
-  const eT       alpha = use_alpha ? (tmp1.get_val() * tmp2.get_val()) : eT(0);
+  const Mat<eT>* mats[N];
+  bool           do_trans[N];
+  eT             val = eT(1);
   
-  glue_times::apply
-    <
-    eT,
-    partial_unwrap_check<T1>::do_trans,
-    partial_unwrap_check<T2>::do_trans,
-    (partial_unwrap_check<T1>::do_times || partial_unwrap_check<T2>::do_times)
-    >
-    (out, A, B, alpha);
+  chain.extract(mats, do_trans, val);
+  
+  glue_times::apply_chain<N>(out, mats, do_trans, val, chain_type::do_times);
   }
 
 
@@ -146,86 +230,6 @@ glue_times_redirect<2>::apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2
 
 
 
-template<typename T1, typename T2, typename T3>
-arma_hot
-inline
-void
-glue_times_redirect<3>::apply(Mat<typename T1::elem_type>& out, const Glue< Glue<T1,T2,glue_times>, T3, glue_times>& X)
-  {
-  arma_extra_debug_sigprint();
-  
-  typedef typename T1::elem_type eT;
-  
-  // TODO: investigate detecting inv(A)*B*C and replacing with solve(A,B)*C
-  // TODO: investigate detecting A*inv(B)*C and replacing with A*solve(B,C)
-  
-  // there is exactly 3 objects
-  // hence we can safely expand X as X.A.A, X.A.B and X.B
-  
-  const partial_unwrap_check<T1> tmp1(X.A.A, out);
-  const partial_unwrap_check<T2> tmp2(X.A.B, out);
-  const partial_unwrap_check<T3> tmp3(X.B,   out);
-  
-  const Mat<eT>& A = tmp1.M;
-  const Mat<eT>& B = tmp2.M;
-  const Mat<eT>& C = tmp3.M;
-  
-  const bool use_alpha = partial_unwrap_check<T1>::do_times || partial_unwrap_check<T2>::do_times || partial_unwrap_check<T3>::do_times;
-  const eT       alpha = use_alpha ? (tmp1.get_val() * tmp2.get_val() * tmp3.get_val()) : eT(0);
-  
-  glue_times::apply
-    <
-    eT,
-    partial_unwrap_check<T1>::do_trans,
-    partial_unwrap_check<T2>::do_trans,
-    partial_unwrap_check<T3>::do_trans,
-    (partial_unwrap_check<T1>::do_times || partial_unwrap_check<T2>::do_times || partial_unwrap_check<T3>::do_times)
-    >
-    (out, A, B, C, alpha);
-  }
-
-
-
-template<typename T1, typename T2, typename T3, typename T4>
-arma_hot
-inline
-void
-glue_times_redirect<4>::apply(Mat<typename T1::elem_type>& out, const Glue< Glue< Glue<T1,T2,glue_times>, T3, glue_times>, T4, glue_times>& X)
-  {
-  arma_extra_debug_sigprint();
-  
-  typedef typename T1::elem_type eT;
-  
-  // there is exactly 4 objects
-  // hence we can safely expand X as X.A.A.A, X.A.A.B, X.A.B and X.B
-  
-  const partial_unwrap_check<T1> tmp1(X.A.A.A, out);
-  const partial_unwrap_check<T2> tmp2(X.A.A.B, out);
-  const partial_unwrap_check<T3> tmp3(X.A.B,   out);
-  const partial_unwrap_check<T4> tmp4(X.B,     out);
-  
-  const Mat<eT>& A = tmp1.M;
-  const Mat<eT>& B = tmp2.M;
-  const Mat<eT>& C = tmp3.M;
-  const Mat<eT>& D = tmp4.M;
-  
-  const bool use_alpha = partial_unwrap_check<T1>::do_times || partial_unwrap_check<T2>::do_times || partial_unwrap_check<T3>::do_times || partial_unwrap_check<T4>::do_times;
-  const eT       alpha = use_alpha ? (tmp1.get_val() * tmp2.get_val() * tmp3.get_val() * tmp4.get_val()) : eT(0);
-  
-  glue_times::apply
-    <
-    eT,
-    partial_unwrap_check<T1>::do_trans,
-    partial_unwrap_check<T2>::do_trans,
-    partial_unwrap_check<T3>::do_trans,
-    partial_unwrap_check<T4>::do_trans,
-    (partial_unwrap_check<T1>::do_times || partial_unwrap_check<T2>::do_times || partial_unwrap_check<T3>::do_times || partial_unwrap_check<T4>::do_times)
-    >
-    (out, A, B, C, D, alpha);
-  }
-
-
-
 template<typename T1, typename T2>
 arma_hot
 inline
@@ -236,7 +240,7 @@ glue_times::apply(Mat<typename T1::elem_type>& out, const Glue<T1,T2,glue_times>
 
   typedef typename T1::elem_type eT;
 
-  const sword N_mat = 1 + depth_lhs< glue_times, Glue<T1,T2,glue_times> >::num;
+  const uword N_mat = glue_times_chain< Glue<T1,T2,glue_times> >::n_mat;
 
   arma_extra_debug_print(arma_boost::format("N_mat = %d") % N_mat);
 
@@ -303,6 +307,23 @@ glue_times::apply_inplace_plus(Mat<typename T1::elem_type>& out, const Glue<T1,
   
   typedef typename T1::elem_type eT;
   
+  glue_times::apply_inplace_plus(out, X, sign, eT(1), glue_times_epilogue<eT>(NULL));
+  }
+
+
+
+//! out = epilogue(beta*out + sign*X), where X is a product of two matrices;
+//! the epilogue is applied to each block of the result while the block is still in cache (see apply_fused())
+template<typename T1, typename T2, typename epilogue_type>
+arma_hot
+inline
+void
+glue_times::apply_inplace_plus(Mat<typename T1::elem_type>& out, const Glue<T1, T2, glue_times>& X, const sword sign, const typename T1::elem_type beta, const epilogue_type& epilogue)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
   const partial_unwrap_check<T1> tmp1(X.A, out);
   const partial_unwrap_check<T2> tmp2(X.B, out);
   
@@ -322,146 +343,14 @@ glue_times::apply_inplace_plus(Mat<typename T1::elem_type>& out, const Glue<T1,
   
   arma_assert_same_size(out.n_rows, out.n_cols, result_n_rows, result_n_cols, "addition");
   
-  if(out.n_elem > 0)
+  if(use_alpha == false)
     {
-    if( (do_trans_A == false) && (do_trans_B == false) && (use_alpha == false) )
-      {
-      if( (A.n_rows == 1) && (is_complex<eT>::value == false) )
-        {
-        gemv<true,         false, true>::apply(out.memptr(), B, A.memptr(), alpha, eT(1));
-        }
-      else
-      if(B.n_cols == 1)
-        {
-        gemv<false,        false, true>::apply(out.memptr(), A, B.memptr(), alpha, eT(1));
-        }
-      else
-        {
-        gemm<false, false, false, true>::apply(out, A, B, alpha, eT(1));
-        }
-      }
-    else
-    if( (do_trans_A == false) && (do_trans_B == false) && (use_alpha == true) )
-      {
-      if( (A.n_rows == 1) && (is_complex<eT>::value == false) )
-        {
-        gemv<true,         true, true>::apply(out.memptr(), B, A.memptr(), alpha, eT(1));
-        }
-      else
-      if(B.n_cols == 1)
-        {
-        gemv<false,        true, true>::apply(out.memptr(), A, B.memptr(), alpha, eT(1));
-        }
-      else
-        {
-        gemm<false, false, true, true>::apply(out, A, B, alpha, eT(1));
-        }
-      }
-    else
-    if( (do_trans_A == true) && (do_trans_B == false) && (use_alpha == false) )
-      {
-      if( (A.n_cols == 1) && (is_complex<eT>::value == false) )
-        {
-        gemv<true,        false, true>::apply(out.memptr(), B, A.memptr(), alpha, eT(1));
-        }
-      else
-      if(B.n_cols == 1)
-        {
-        gemv<true,        false, true>::apply(out.memptr(), A, B.memptr(), alpha, eT(1));
-        }
-      else
-        {
-        gemm<true, false, false, true>::apply(out, A, B, alpha, eT(1));
-        }
-      }
-    else
-    if( (do_trans_A == true) && (do_trans_B == false) && (use_alpha == true) )
-      {
-      if( (A.n_cols == 1) && (is_complex<eT>::value == false) )
-        {
-        gemv<true,        true, true>::apply(out.memptr(), B, A.memptr(), alpha, eT(1));
-        }
-      else
-      if(B.n_cols == 1)
-        {
-        gemv<true,        true, true>::apply(out.memptr(), A, B.memptr(), alpha, eT(1));
-        }
-      else
-        {
-        gemm<true, false, true, true>::apply(out, A, B, alpha, eT(1));
-        }
-      }
-    else
-    if( (do_trans_A == false) && (do_trans_B == true) && (use_alpha == false) )
-      {
-      if( (A.n_rows == 1) && (is_complex<eT>::value == false) )
-        {
-        gemv<false,       false, true>::apply(out.memptr(), B, A.memptr(), alpha, eT(1));
-        }
-      else
-      if( (B.n_rows == 1) && (is_complex<eT>::value == false) )
-        {
-        gemv<false,       false, true>::apply(out.memptr(), A, B.memptr(), alpha, eT(1));
-        }
-      else
-        {
-        gemm<false, true, false, true>::apply(out, A, B, alpha, eT(1));
-        }
-      }
-    else
-    if( (do_trans_A == false) && (do_trans_B == true) && (use_alpha == true) )
-      {
-      if( (A.n_rows == 1) && (is_complex<eT>::value == false) )
-        {
-        gemv<false,       true, true>::apply(out.memptr(), B, A.memptr(), alpha, eT(1));
-        }
-      else
-      if( (B.n_rows == 1) && (is_complex<eT>::value == false) )
-        {
-        gemv<false,       true, true>::apply(out.memptr(), A, B.memptr(), alpha, eT(1));
-        }
-      else
-        {
-        gemm<false, true, true, true>::apply(out, A, B, alpha, eT(1));
-        }
-      }
-    else
-    if( (do_trans_A == true) && (do_trans_B == true) && (use_alpha == false) )
-      {
-      if( (A.n_cols == 1) && (is_complex<eT>::value == false) )
-        {
-        gemv<false,      false, true>::apply(out.memptr(), B, A.memptr(), alpha, eT(1));
-        }
-      else
-      if( (B.n_rows == 1) && (is_complex<eT>::value == false) )
-        {
-        gemv<true,       false, true>::apply(out.memptr(), A, B.memptr(), alpha, eT(1));
-        }
-      else
-        {
-        gemm<true, true, false, true>::apply(out, A, B, alpha, eT(1));
-        }
-      }
-    else
-    if( (do_trans_A == true) && (do_trans_B == true) && (use_alpha == true) )
-      {
-      if( (A.n_cols == 1) && (is_complex<eT>::value == false) )
-        {
-        gemv<false,      true, true>::apply(out.memptr(), B, A.memptr(), alpha, eT(1));
-        }
-      else
-      if( (B.n_rows == 1) && (is_complex<eT>::value == false) )
-        {
-        gemv<true,       true, true>::apply(out.memptr(), A, B.memptr(), alpha, eT(1));
-        }
-      else
-        {
-        gemm<true, true, true, true>::apply(out, A, B, alpha, eT(1));
-        }
-      }
+    glue_times::apply_fused<eT, do_trans_A, do_trans_B, false, true>(out, A, B, alpha, beta, epilogue);
+    }
+  else
+    {
+    glue_times::apply_fused<eT, do_trans_A, do_trans_B, true,  true>(out, A, B, alpha, beta, epilogue);
     }
-  
-  
   }
 
 
@@ -740,6 +629,473 @@ glue_times::apply
 
 
 
+//! multiply a chain of N matrices, where N >= 3.
+//! the order of the multiplications is chosen via dynamic programming, so that the total number of scalar multiplications is minimised.
+//! eg. for A*B*C*x, where x is a vector, the chain is evaluated as A*(B*(C*x)), using only matrix-vector multiplications.
+//! all intermediate products are stored in a single block of scratch memory.
+template<uword N, typename eT>
+arma_hot
+inline
+void
+glue_times::apply_chain(Mat<eT>& out, const Mat<eT>** mats, const bool* do_trans, const eT val, const bool use_val)
+  {
+  arma_extra_debug_sigprint();
+  
+  // operand k has dims[k] rows and dims[k+1] columns (after transposition, if required)
+  
+  uword dims[N+1];
+  
+  for(uword k=0; k < N; ++k)
+    {
+    const Mat<eT>& A = *(mats[k]);
+    
+    if(k > 0)
+      {
+      arma_debug_assert_mul_size(*(mats[k-1]), A, do_trans[k-1], do_trans[k], "matrix multiplication");
+      }
+    
+    dims[k]   = (do_trans[k] == false) ? A.n_rows : A.n_cols;
+    dims[k+1] = (do_trans[k] == false) ? A.n_cols : A.n_rows;
+    }
+  
+  // cost[i*N + j] is the lowest number of scalar multiplications required to evaluate the product of operands i to j;
+  // split[i*N + j] = k indicates that the product is best evaluated as (operands i to k) * (operands k+1 to j)
+  
+  double cost[N*N];
+  uword  split[N*N];
+  
+  bool all_same_size = true;
+  
+  for(uword k=1; k <= N; ++k)
+    {
+    all_same_size = all_same_size && (dims[k] == dims[0]);
+    }
+  
+  if(all_same_size)
+    {
+    // square matrices of the same size: all orders have the same cost, hence evaluate from left to right
+    for(uword j=1; j < N; ++j)
+      {
+      split[j] = j-1;
+      }
+    }
+  else
+    {
+    for(uword i=0; i < N; ++i)
+      {
+      cost[i*N + i] = 0.0;
+      }
+    
+    for(uword len=2; len <= N; ++len)
+    for(uword i=0; (i + len) <= N; ++i)
+      {
+      const uword j = i + len - 1;
+      
+      double best_cost  = 0.0;
+      uword  best_split = i;
+      
+      for(uword k=i; k < j; ++k)
+        {
+        const double c = cost[i*N + k] + cost[(k+1)*N + j] + double(dims[i]) * double(dims[k+1]) * double(dims[j+1]);
+        
+        // ties are resolved in favour of the rightmost split, ie. evaluation from left to right
+        if( (k == i) || (c <= best_cost) )
+          {
+          best_cost  = c;
+          best_split = k;
+          }
+        }
+      
+      cost[i*N + j]  = best_cost;
+      split[i*N + j] = best_split;
+      }
+    }
+  
+  const uword n_scratch = glue_times::apply_chain_scratch_size(dims, split, N, 0, N-1);
+  
+  const bool use_local = (n_scratch <= uword(chain_scratch_local_n_elem));
+  
+  eT           scratch_local[chain_scratch_local_n_elem];
+  podarray<eT> scratch_heap( (use_local) ? uword(0) : n_scratch );
+  
+  eT* scratch = (use_local) ? scratch_local : scratch_heap.memptr();
+  
+  glue_times::apply_chain_node(out, mats, do_trans, dims, split, N, 0, N-1, scratch, val, use_val);
+  }
+
+
+
+//! evaluate the product of operands i to j into out;
+//! intermediate products are stored in scratch, in the order given by apply_chain_scratch_size()
+template<typename eT>
+arma_hot
+inline
+void
+glue_times::apply_chain_node
+  (
+        Mat<eT>& out,
+  const Mat<eT>** mats,
+  const bool*     do_trans,
+  const uword*    dims,
+  const uword*    split,
+  const uword     N,
+  const uword     i,
+  const uword     j,
+        eT*       scratch,
+  const eT        val,
+  const bool      use_val
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword k = split[i*N + j];
+  
+  const bool A_is_product = (i   < k);
+  const bool B_is_product = (k+1 < j);
+  
+  const uword A_n_rows = (A_is_product) ? dims[i]   : 0;
+  const uword A_n_cols = (A_is_product) ? dims[k+1] : 0;
+  const uword B_n_rows = (B_is_product) ? dims[k+1] : 0;
+  const uword B_n_cols = (B_is_product) ? dims[j+1] : 0;
+  
+  // the left product is stored at the start of the scratch memory, followed by the right product;
+  // the memory after each product is used while evaluating it
+  
+  Mat<eT> A_tmp(scratch,                        A_n_rows, A_n_cols, false, true);
+  Mat<eT> B_tmp(scratch + A_n_rows*A_n_cols,    B_n_rows, B_n_cols, false, true);
+  
+  if(A_is_product)
+    {
+    glue_times::apply_chain_node(A_tmp, mats, do_trans, dims, split, N, i, k, scratch + A_tmp.n_elem, eT(0), false);
+    }
+  
+  if(B_is_product)
+    {
+    glue_times::apply_chain_node(B_tmp, mats, do_trans, dims, split, N, k+1, j, scratch + A_tmp.n_elem + B_tmp.n_elem, eT(0), false);
+    }
+  
+  const Mat<eT>& A = (A_is_product) ? A_tmp : *(mats[i]);
+  const Mat<eT>& B = (B_is_product) ? B_tmp : *(mats[j]);
+  
+  glue_times::apply_runtime(out, A, ( (A_is_product) ? false : do_trans[i] ), B, ( (B_is_product) ? false : do_trans[j] ), val, use_val);
+  }
+
+
+
+//! amount of scratch memory required by apply_chain_node() to evaluate the product of operands i to j
+inline
+uword
+glue_times::apply_chain_scratch_size(const uword* dims, const uword* split, const uword N, const uword i, const uword j)
+  {
+  const uword k = split[i*N + j];
+  
+  const uword A_n_elem = (i   < k) ? dims[i]*dims[k+1]   : 0;
+  const uword B_n_elem = (k+1 < j) ? dims[k+1]*dims[j+1] : 0;
+  
+  const uword A_extra = (i   < k) ? glue_times::apply_chain_scratch_size(dims, split, N, i,   k) : 0;
+  const uword B_extra = (k+1 < j) ? glue_times::apply_chain_scratch_size(dims, split, N, k+1, j) : 0;
+  
+  return A_n_elem + (std::max)(A_extra, B_n_elem + B_extra);
+  }
+
+
+
+//! out = A*B, where the use of transposes and the scalar multiplier is only known at run time
+template<typename eT>
+arma_hot
+inline
+void
+glue_times::apply_runtime(Mat<eT>& out, const Mat<eT>& A, const bool do_trans_A, const Mat<eT>& B, const bool do_trans_B, const eT val, const bool use_val)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(use_val == false)
+    {
+         if( (do_trans_A == false) && (do_trans_B == false) )  { glue_times::apply<eT, false, false, false>(out, A, B, val); }
+    else if( (do_trans_A == true ) && (do_trans_B == false) )  { glue_times::apply<eT, true,  false, false>(out, A, B, val); }
+    else if( (do_trans_A == false) && (do_trans_B == true ) )  { glue_times::apply<eT, false, true,  false>(out, A, B, val); }
+    else                                                       { glue_times::apply<eT, true,  true,  false>(out, A, B, val); }
+    }
+  else
+    {
+         if( (do_trans_A == false) && (do_trans_B == false) )  { glue_times::apply<eT, false, false, true >(out, A, B, val); }
+    else if( (do_trans_A == true ) && (do_trans_B == false) )  { glue_times::apply<eT, true,  false, true >(out, A, B, val); }
+    else if( (do_trans_A == false) && (do_trans_B == true ) )  { glue_times::apply<eT, false, true,  true >(out, A, B, val); }
+    else                                                       { glue_times::apply<eT, true,  true,  true >(out, A, B, val); }
+    }
+  }
+
+
+
+template<typename eT>
+inline
+glue_times_epilogue<eT>::glue_times_epilogue(const eT* in_bias_mem)
+  : bias_mem(in_bias_mem)
+  {
+  }
+
+
+
+template<typename eT>
+arma_inline
+bool
+glue_times_epilogue<eT>::is_active() const
+  {
+  return (bias_mem != NULL);
+  }
+
+
+
+template<typename eT>
+arma_hot
+inline
+void
+glue_times_epilogue<eT>::apply(eT* mem, const uword offset, const uword n_elem) const
+  {
+  if(bias_mem != NULL)
+    {
+    arrayops::inplace_plus(mem, &(bias_mem[offset]), n_elem);
+    }
+  }
+
+
+
+template<typename eT, typename eop_type>
+inline
+glue_times_epilogue_eop<eT, eop_type>::glue_times_epilogue_eop(const eT* in_bias_mem, const eT in_aux)
+  : bias_mem(in_bias_mem)
+  , aux(in_aux)
+  {
+  }
+
+
+
+template<typename eT, typename eop_type>
+arma_inline
+bool
+glue_times_epilogue_eop<eT, eop_type>::is_active() const
+  {
+  return true;
+  }
+
+
+
+template<typename eT, typename eop_type>
+arma_hot
+inline
+void
+glue_times_epilogue_eop<eT, eop_type>::apply(eT* mem, const uword offset, const uword n_elem) const
+  {
+  if(bias_mem != NULL)
+    {
+    const eT* bias = &(bias_mem[offset]);
+    
+    uword i,j;
+    for(i=0, j=1; j < n_elem; i+=2, j+=2)
+      {
+      const eT tmp_i = eop_core<eop_type>::process(mem[i] + bias[i], aux);
+      const eT tmp_j = eop_core<eop_type>::process(mem[j] + bias[j], aux);
+      
+      mem[i] = tmp_i;
+      mem[j] = tmp_j;
+      }
+    
+    if(i < n_elem)
+      {
+      mem[i] = eop_core<eop_type>::process(mem[i] + bias[i], aux);
+      }
+    }
+  else
+    {
+    const eT* src = mem;
+    
+    if(simd::eop_apply<eop_type, simd_op_equ>(mem, src, aux, n_elem) == false)
+      {
+      uword i,j;
+      for(i=0, j=1; j < n_elem; i+=2, j+=2)
+        {
+        const eT tmp_i = eop_core<eop_type>::process(mem[i], aux);
+        const eT tmp_j = eop_core<eop_type>::process(mem[j], aux);
+        
+        mem[i] = tmp_i;
+        mem[j] = tmp_j;
+        }
+      
+      if(i < n_elem)
+        {
+        mem[i] = eop_core<eop_type>::process(mem[i], aux);
+        }
+      }
+    }
+  }
+
+
+
+//! out = epilogue(alpha*A*B + beta*out), where out has already been set to the size of the product.
+//! The epilogue is applied to blocks of the result while they are still in cache:
+//! if the result is larger than fused_panel_n_bytes, it is evaluated in panels of columns,
+//! with one call to gemm per panel, followed by the epilogue for that panel.
+//! Each call to gemm goes through all of A, so panels are at least twice as wide as the inner dimension of the product;
+//! products with a large inner dimension are therefore evaluated in one go, with the epilogue as a separate pass.
+template
+  <
+  typename   eT,
+  const bool do_trans_A,
+  const bool do_trans_B,
+  const bool use_alpha,
+  const bool use_beta,
+  typename   epilogue_type
+  >
+arma_hot
+inline
+void
+glue_times::apply_fused
+  (
+        Mat<eT>&       out,
+  const Mat<eT>&       A,
+  const Mat<eT>&       B,
+  const eT             alpha,
+  const eT             beta,
+  const epilogue_type& epilogue
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  if(out.n_elem == 0)
+    {
+    return;
+    }
+  
+  if( (A.n_elem == 0) || (B.n_elem == 0) )
+    {
+    if(use_beta == false)
+      {
+      out.zeros();
+      }
+    else
+    if(beta != eT(1))
+      {
+      arrayops::inplace_mul(out.memptr(), beta, out.n_elem);
+      }
+    
+    epilogue.apply(out.memptr(), 0, out.n_elem);
+    
+    return;
+    }
+  
+  const bool A_is_row = (do_trans_A == false) ? (A.n_rows == 1) : (A.n_cols == 1);
+  const bool B_is_col = (do_trans_B == false) ? (B.n_cols == 1) : (B.n_rows == 1);
+  
+  if( A_is_row && (is_complex<eT>::value == false) )
+    {
+    gemv<(do_trans_B == false), use_alpha, use_beta>::apply(out.memptr(), B, A.memptr(), alpha, beta);
+    
+    epilogue.apply(out.memptr(), 0, out.n_elem);
+    }
+  else
+  if( B_is_col && ( (do_trans_B == false) || (is_complex<eT>::value == false) ) )
+    {
+    gemv<do_trans_A, use_alpha, use_beta>::apply(out.memptr(), A, B.memptr(), alpha, beta);
+    
+    epilogue.apply(out.memptr(), 0, out.n_elem);
+    }
+  else
+    {
+    const uword out_n_rows = out.n_rows;
+    const uword out_n_cols = out.n_cols;
+    const uword inner      = (do_trans_A == false) ? A.n_cols : A.n_rows;
+    
+    const uword panel_n_cols = (std::max)( uword(glue_times::fused_panel_n_bytes) / (out_n_rows * uword(sizeof(eT))), 2*inner );
+    
+    if( (epilogue.is_active() == false) || (panel_n_cols >= out_n_cols) )
+      {
+      gemm<do_trans_A, do_trans_B, use_alpha, use_beta>::apply(out, A, B, alpha, beta);
+      
+      epilogue.apply(out.memptr(), 0, out.n_elem);
+      }
+    else
+      {
+      Mat<eT> B_rows;
+      
+      for(uword col=0; col < out_n_cols; col += panel_n_cols)
+        {
+        const uword n_cols = (std::min)(panel_n_cols, out_n_cols - col);
+        
+        Mat<eT> out_panel(out.colptr(col), out_n_rows, n_cols, false, true);
+        
+        if(do_trans_B == false)
+          {
+          const Mat<eT> B_panel(const_cast<eT*>(B.colptr(col)), B.n_rows, n_cols, false, true);
+          
+          gemm<do_trans_A, false, use_alpha, use_beta>::apply(out_panel, A, B_panel, alpha, beta);
+          }
+        else
+          {
+          // gemm requires the rows of B used by the panel to be stored contiguously
+          B_rows = B.rows(col, col + n_cols - 1);
+          
+          gemm<do_trans_A, true, use_alpha, use_beta>::apply(out_panel, A, B_rows, alpha, beta);
+          }
+        
+        epilogue.apply(out_panel.memptr(), col*out_n_rows, out_panel.n_elem);
+        }
+      }
+    }
+  }
+
+
+
+// 
+// glue_times_plus
+
+
+
+template<typename T1, typename T2, typename T3>
+arma_hot
+inline
+void
+glue_times_plus::apply(Mat<typename T1::elem_type>& out, const Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::elem_type eT;
+  
+  const partial_unwrap_check<T1> tmp1(X.A.A, out);
+  const partial_unwrap_check<T2> tmp2(X.A.B, out);
+  const unwrap<T3>               tmp3(X.B);
+  
+  const Mat<eT>& A = tmp1.M;
+  const Mat<eT>& B = tmp2.M;
+  const Mat<eT>& C = tmp3.M;
+  
+  const bool do_trans_A = partial_unwrap_check<T1>::do_trans;
+  const bool do_trans_B = partial_unwrap_check<T2>::do_trans;
+  const bool use_alpha  = partial_unwrap_check<T1>::do_times || partial_unwrap_check<T2>::do_times;
+  
+  const eT alpha = use_alpha ? (tmp1.get_val() * tmp2.get_val()) : eT(0);
+  
+  arma_debug_assert_mul_size(A, B, do_trans_A, do_trans_B, "matrix multiplication");
+  
+  const uword result_n_rows = (do_trans_A == false) ? A.n_rows : A.n_cols;
+  const uword result_n_cols = (do_trans_B == false) ? B.n_cols : B.n_rows;
+  
+  arma_debug_assert_same_size(result_n_rows, result_n_cols, C.n_rows, C.n_cols, "addition");
+  
+  if(&C == &out)
+    {
+    // eg. X = A*B + X; the product is accumulated directly into X
+    glue_times::apply_fused<eT, do_trans_A, do_trans_B, use_alpha, true>(out, A, B, alpha, eT(1), glue_times_epilogue<eT>(NULL));
+    }
+  else
+    {
+    out.set_size(result_n_rows, result_n_cols);
+    
+    glue_times::apply_fused<eT, do_trans_A, do_trans_B, use_alpha, false>(out, A, B, alpha, eT(0), glue_times_epilogue<eT>(C.memptr()));
+    }
+  }
+
+
+
 //
 // glue_times_diag
 
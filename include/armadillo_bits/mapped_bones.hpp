@@ -0,0 +1,64 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup mapped
+//! @{
+
+
+
+//! \brief
+//! Matrix or cube (obj_type is Mat<eT> or Cube<eT>) loaded from a file in arma_binary format via memory mapping.
+//! No data is read when the file is loaded; elements are paged in from disk on first access.
+//! The mapping is private: elements can be modified, but changes are not written back to the file (copy-on-write).
+//! The underlying object (accessible via get_ref()) uses the mapped memory as auxiliary memory,
+//! and hence its number of elements can't be changed; it must not be used after the mapped object is reset or destroyed.
+//! If memory mapping is not available, or the data in the file is not suitably aligned,
+//! the file is loaded into memory in the usual way.
+template<typename obj_type>
+class mapped
+  {
+  public:
+  
+  typedef typename obj_type::elem_type                   elem_type;
+  typedef typename get_pod_type<elem_type>::result       pod_type;
+  
+  inline  mapped();
+  inline ~mapped();
+  
+  inline bool load(const std::string name, const bool print_status = true);
+  inline void reset();
+  
+  inline       obj_type& get_ref();
+  inline const obj_type& get_ref() const;
+  
+  inline bool is_mapped() const;  //!< true if the object uses memory mapped from the file, rather than a copy of the data
+  
+  
+  private:
+  
+  inline      mapped(const mapped&);     //!< not implemented
+  inline void operator=(const mapped&);  //!< not implemented
+  
+  inline bool map_file(const std::string& name, std::string& err_msg);
+  
+  template<typename eT> inline static Mat<eT>*  create(elem_type* mem, const uword* dims, const Mat<eT>& junk);
+  template<typename eT> inline static Cube<eT>* create(elem_type* mem, const uword* dims, const Cube<eT>& junk);
+  
+  obj_type* obj;      //!< the underlying object; an empty object if nothing has been loaded
+  void*     map_mem;  //!< start of the mapping (0 if not mapped)
+  size_t    map_len;  //!< length of the mapping in bytes
+  };
+
+
+
+//! @}
@@ -0,0 +1,278 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup mapped
+//! @{
+
+
+
+template<typename obj_type>
+inline
+mapped<obj_type>::mapped()
+  : obj(new obj_type())
+  , map_mem(0)
+  , map_len(0)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  arma_type_check(( (is_Mat_only<obj_type>::value == false) && (is_Cube<obj_type>::value == false) ));
+  }
+
+
+
+template<typename obj_type>
+inline
+mapped<obj_type>::~mapped()
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  reset();
+  
+  delete obj;
+  }
+
+
+
+//! release the mapping (if any) and make the underlying object empty
+template<typename obj_type>
+inline
+void
+mapped<obj_type>::reset()
+  {
+  arma_extra_debug_sigprint();
+  
+  if( (obj->n_elem > 0) || (map_mem != 0) )
+    {
+    // the object must be destroyed before the memory it uses is unmapped
+    delete obj;
+    obj = new obj_type();
+    }
+  
+  #if defined(ARMA_HAVE_MMAP)
+    {
+    if(map_mem != 0)
+      {
+      munmap(map_mem, map_len);
+      }
+    }
+  #endif
+  
+  map_mem = 0;
+  map_len = 0;
+  }
+
+
+
+template<typename obj_type>
+inline
+obj_type&
+mapped<obj_type>::get_ref()
+  {
+  return *obj;
+  }
+
+
+
+template<typename obj_type>
+inline
+const obj_type&
+mapped<obj_type>::get_ref() const
+  {
+  return *obj;
+  }
+
+
+
+template<typename obj_type>
+inline
+bool
+mapped<obj_type>::is_mapped() const
+  {
+  return (map_mem != 0);
+  }
+
+
+
+//! load a matrix or cube stored in arma_binary format.
+//! the data is memory mapped if possible, otherwise it is loaded into memory
+template<typename obj_type>
+inline
+bool
+mapped<obj_type>::load(const std::string name, const bool print_status)
+  {
+  arma_extra_debug_sigprint();
+  
+  reset();
+  
+  std::string err_msg;
+  
+  bool load_okay = map_file(name, err_msg);
+  
+  if( (load_okay == false) && (err_msg.length() == 0) )
+    {
+    // memory mapping isn't possible for this file; fall back to reading it
+    load_okay = diskio::load_arma_binary(*obj, name, err_msg);
+    }
+  
+  if( (print_status == true) && (load_okay == false) )
+    {
+    if(err_msg.length() > 0)
+      {
+      arma_warn(true, "mapped::load(): ", err_msg, name);
+      }
+    else
+      {
+      arma_warn(true, "mapped::load(): couldn't read ", name);
+      }
+    }
+  
+  if(load_okay == false)
+    {
+    reset();
+    }
+  
+  return load_okay;
+  }
+
+
+
+//! try to memory map the data in the given file.
+//! err_msg is set only if the file is known to be invalid;
+//! if the file could still be loaded without memory mapping, false is returned with err_msg left empty
+template<typename obj_type>
+inline
+bool
+mapped<obj_type>::map_file(const std::string& name, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  #if defined(ARMA_HAVE_MMAP)
+    {
+    std::ifstream f(name.c_str(), std::fstream::binary);
+    
+    if(f.is_open() == false)
+      {
+      return false;
+      }
+    
+    const uword n_dims = (is_Cube<obj_type>::value) ? 3 : 2;
+    
+    std::string f_header;
+    uword       dims[3] = { 0, 0, 1 };
+    
+    f >> f_header;
+    
+    for(uword i=0; i < n_dims; ++i)
+      {
+      f >> dims[i];
+      }
+    
+    if( (f.good() == false) || (f_header != diskio::gen_bin_header(*obj)) )
+      {
+      err_msg = "incorrect header in ";
+      return false;
+      }
+    
+    f.get();
+    
+    const std::streamoff data_offset = f.tellg();
+    
+    f.seekg(0, std::ios::end);
+    
+    const std::streamoff file_len = f.tellg();
+    
+    f.close();
+    
+    const size_t n_bytes = size_t(dims[0]) * size_t(dims[1]) * size_t(dims[2]) * sizeof(elem_type);
+    
+    if( (data_offset < 0) || (file_len < 0) || ( size_t(file_len - data_offset) < n_bytes ) )
+      {
+      err_msg = "truncated data in ";
+      return false;
+      }
+    
+    // mapping an empty region isn't allowed, and misaligned elements can't be used directly
+    if( (n_bytes == 0) || ( (size_t(data_offset) % sizeof(pod_type)) != 0 ) )
+      {
+      return false;
+      }
+    
+    const int fd = open(name.c_str(), O_RDONLY);
+    
+    if(fd == -1)
+      {
+      return false;
+      }
+    
+    const size_t len = size_t(data_offset) + n_bytes;
+    
+    void* mem = mmap(0, len, (PROT_READ | PROT_WRITE), MAP_PRIVATE, fd, 0);
+    
+    close(fd);
+    
+    if(mem == MAP_FAILED)
+      {
+      return false;
+      }
+    
+    map_mem = mem;
+    map_len = len;
+    
+    elem_type* data = reinterpret_cast<elem_type*>( static_cast<char*>(mem) + data_offset );
+    
+    obj_type* mapped_obj = mapped<obj_type>::create(data, dims, *obj);
+    
+    delete obj;
+    obj = mapped_obj;
+    
+    return true;
+    }
+  #else
+    {
+    arma_ignore(name);
+    arma_ignore(err_msg);
+    
+    return false;
+    }
+  #endif
+  }
+
+
+
+template<typename obj_type>
+template<typename eT>
+inline
+Mat<eT>*
+mapped<obj_type>::create(elem_type* mem, const uword* dims, const Mat<eT>& junk)
+  {
+  arma_ignore(junk);
+  
+  return new Mat<eT>(mem, dims[0], dims[1], false, true);
+  }
+
+
+
+template<typename obj_type>
+template<typename eT>
+inline
+Cube<eT>*
+mapped<obj_type>::create(elem_type* mem, const uword* dims, const Cube<eT>& junk)
+  {
+  arma_ignore(junk);
+  
+  return new Cube<eT>(mem, dims[0], dims[1], dims[2], false, true);
+  }
+
+
+
+//! @}
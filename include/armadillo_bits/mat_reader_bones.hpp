@@ -0,0 +1,73 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup mat_reader
+//! @{
+
+
+
+//! \brief
+//! Sequential reader for a matrix stored in a file, which provides the matrix in blocks,
+//! so that files larger than the available memory can be processed.
+//! Files in arma_binary format are read in blocks of columns;
+//! files in raw_ascii, csv_ascii and raw_binary formats are read in blocks of rows
+//! (a raw_binary file is treated as a single column).
+//! Each block is stored in a user provided matrix, which can be reused between calls to next().
+template<typename eT>
+class mat_reader
+  {
+  public:
+  
+  typedef eT                                elem_type;
+  typedef typename get_pod_type<eT>::result pod_type;
+  
+  inline  mat_reader();
+  inline ~mat_reader();
+  
+  inline bool open(const std::string name, const file_type type = auto_detect, const bool print_status = true);
+  inline void close();
+  
+  inline bool next(Mat<eT>& X, const uword n);
+  
+  inline bool      is_open()  const;
+  inline bool      by_cols()  const;  //!< true if the file is read in blocks of columns, false if in blocks of rows
+  inline file_type get_type() const;
+  inline uword     n_rows()   const;  //!< number of rows in the file (0 if not known in advance)
+  inline uword     n_cols()   const;  //!< number of columns in the file
+  inline uword     n_done()   const;  //!< number of columns or rows read so far
+  
+  
+  private:
+  
+  inline      mat_reader(const mat_reader&);  //!< not implemented
+  inline void operator=(const mat_reader&);   //!< not implemented
+  
+  inline bool open_file(const file_type type, std::string& err_msg);
+  inline bool read_block(Mat<eT>& X, const uword n, std::string& err_msg);
+  inline bool read_rows (Mat<eT>& X, const uword n, std::string& err_msg);
+  inline bool parse_line(eT* out, const uword stride, std::string& err_msg);
+  
+  std::ifstream     f;             //!< the file being read
+  std::string       f_name;
+  file_type         f_type;        //!< file_type_unknown if no file is open
+  uword             f_n_rows;
+  uword             f_n_cols;
+  uword             f_n_done;
+  bool              f_print;       //!< print a warning if reading fails
+  std::string       line;          //!< current line of a text file
+  std::vector<eT>   row_buffer;    //!< rows of a text file, before they are stored in a block
+  };
+
+
+
+//! @}
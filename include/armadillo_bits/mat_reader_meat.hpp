@@ -0,0 +1,562 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup mat_reader
+//! @{
+
+
+
+template<typename eT>
+inline
+mat_reader<eT>::mat_reader()
+  : f_type(file_type_unknown)
+  , f_n_rows(0)
+  , f_n_cols(0)
+  , f_n_done(0)
+  , f_print(true)
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+mat_reader<eT>::~mat_reader()
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  close();
+  }
+
+
+
+//! open a matrix file for reading.
+//! the file type can be arma_binary, raw_ascii, csv_ascii, raw_binary or auto_detect;
+//! auto detection only examines the start of the file
+template<typename eT>
+inline
+bool
+mat_reader<eT>::open(const std::string name, const file_type type, const bool print_status)
+  {
+  arma_extra_debug_sigprint();
+  
+  close();
+  
+  f_name  = name;
+  f_print = print_status;
+  
+  f.open(name.c_str(), std::fstream::binary);
+  
+  std::string err_msg;
+  
+  const bool open_okay = (f.is_open() == true) ? open_file(type, err_msg) : false;
+  
+  if(open_okay == false)
+    {
+    if(print_status == true)
+      {
+      if(err_msg.length() > 0)
+        {
+        arma_warn(true, "mat_reader::open(): ", err_msg, name);
+        }
+      else
+        {
+        arma_warn(true, "mat_reader::open(): couldn't read ", name);
+        }
+      }
+    
+    close();
+    }
+  
+  return open_okay;
+  }
+
+
+
+template<typename eT>
+inline
+void
+mat_reader<eT>::close()
+  {
+  arma_extra_debug_sigprint();
+  
+  if(f.is_open() == true)
+    {
+    f.close();
+    }
+  
+  f.clear();
+  
+  f_type   = file_type_unknown;
+  f_n_rows = 0;
+  f_n_cols = 0;
+  f_n_done = 0;
+  }
+
+
+
+//! read the next block of at most n columns (arma_binary files) or n rows (other files) into X.
+//! returns false if there is no more data (X is then left unchanged), or if the data couldn't be read
+template<typename eT>
+inline
+bool
+mat_reader<eT>::next(Mat<eT>& X, const uword n)
+  {
+  arma_extra_debug_sigprint();
+  
+  if( (f_type == file_type_unknown) || (n == 0) )
+    {
+    return false;
+    }
+  
+  std::string err_msg;
+  
+  const bool read_okay = read_block(X, n, err_msg);
+  
+  if(err_msg.length() > 0)
+    {
+    arma_warn(f_print, "mat_reader::next(): ", err_msg, f_name);
+    
+    close();
+    }
+  
+  return read_okay;
+  }
+
+
+
+template<typename eT>
+inline
+bool
+mat_reader<eT>::is_open() const
+  {
+  return (f_type != file_type_unknown);
+  }
+
+
+
+template<typename eT>
+inline
+bool
+mat_reader<eT>::by_cols() const
+  {
+  return (f_type == arma_binary);
+  }
+
+
+
+template<typename eT>
+inline
+file_type
+mat_reader<eT>::get_type() const
+  {
+  return f_type;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+mat_reader<eT>::n_rows() const
+  {
+  return f_n_rows;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+mat_reader<eT>::n_cols() const
+  {
+  return f_n_cols;
+  }
+
+
+
+template<typename eT>
+inline
+uword
+mat_reader<eT>::n_done() const
+  {
+  return f_n_done;
+  }
+
+
+
+//! determine the type and size of the data in the opened file, and position the stream at the start of the data
+template<typename eT>
+inline
+bool
+mat_reader<eT>::open_file(const file_type type, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  f_type = type;
+  
+  if(f_type == auto_detect)
+    {
+    std::string f_header;
+    
+    f >> f_header;
+    
+    f.clear();
+    f.seekg(0, ios::beg);
+    
+    if(f_header.substr(0,12) == "ARMA_MAT_BIN")
+      {
+      f_type = arma_binary;
+      }
+    else
+    if( (f_header.substr(0,12) == "ARMA_MAT_TXT") || (f_header.substr(0,8) == "ARMA_CUB") )
+      {
+      f_type = file_type_unknown;
+      }
+    else
+      {
+      // examine the start of the file only, as the whole file may be very large
+      char buffer[4096];
+      
+      f.read(buffer, std::streamsize(sizeof(buffer)));
+      
+      const uword N = uword(f.gcount());
+      
+      f.clear();
+      f.seekg(0, ios::beg);
+      
+      bool has_binary = false;
+      bool has_comma  = false;
+      
+      for(uword i=0; i<N; ++i)
+        {
+        const unsigned char val = static_cast<unsigned char>(buffer[i]);
+        
+        if( (val <= 8) || (val >= 123) )
+          {
+          has_binary = true;
+          break;
+          }
+        
+        if(val == ',')
+          {
+          has_comma = true;
+          }
+        }
+      
+      f_type = (has_binary) ? raw_binary : ( (has_comma) ? csv_ascii : raw_ascii );
+      }
+    }
+  
+  switch(f_type)
+    {
+    case arma_binary:
+      {
+      std::string f_header;
+      
+      f >> f_header;
+      f >> f_n_rows;
+      f >> f_n_cols;
+      
+      const Mat<eT> junk;
+      
+      if( (f.good() == false) || (f_header != diskio::gen_bin_header(junk)) )
+        {
+        err_msg = "incorrect header in ";
+        return false;
+        }
+      
+      f.get();
+      
+      const std::streamoff data_offset = f.tellg();
+      
+      f.seekg(0, ios::end);
+      
+      const std::streamoff file_len = f.tellg();
+      
+      f.seekg(data_offset, ios::beg);
+      
+      const double n_bytes = double(f_n_rows) * double(f_n_cols) * double(sizeof(eT));
+      
+      if( (data_offset < 0) || (file_len < data_offset) || (double(file_len - data_offset) < n_bytes) )
+        {
+        err_msg = "truncated data in ";
+        return false;
+        }
+      }
+      break;
+    
+    case raw_binary:
+      {
+      f.seekg(0, ios::end);
+      
+      const std::streamoff file_len = f.tellg();
+      
+      f.seekg(0, ios::beg);
+      
+      f_n_rows = (file_len > 0) ? uword(file_len / std::streamoff(sizeof(eT))) : uword(0);
+      f_n_cols = 1;
+      }
+      break;
+    
+    case raw_ascii:
+    case csv_ascii:
+      {
+      // the number of columns is given by the first line
+      std::getline(f, line);
+      
+      if( (line.length() > 0) && (line[line.length()-1] == '\r') )
+        {
+        line.resize(line.length()-1);
+        }
+      
+      f_n_cols = 0;
+      
+      if(f_type == csv_ascii)
+        {
+        if(line.length() > 0)
+          {
+          f_n_cols = uword( std::count(line.begin(), line.end(), ',') ) + 1;
+          }
+        }
+      else
+        {
+        std::stringstream line_stream(line);
+        std::string       token;
+        
+        while(line_stream >> token)
+          {
+          ++f_n_cols;
+          }
+        }
+      
+      f.clear();
+      f.seekg(0, ios::beg);
+      }
+      break;
+    
+    default:
+      err_msg = "unsupported file type for ";
+      return false;
+    }
+  
+  return f.good();
+  }
+
+
+
+template<typename eT>
+inline
+bool
+mat_reader<eT>::read_block(Mat<eT>& X, const uword n, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  if( (f_type == raw_ascii) || (f_type == csv_ascii) )
+    {
+    return read_rows(X, n, err_msg);
+    }
+  
+  // binary files: blocks of columns (arma_binary) or elements of the single column (raw_binary)
+  
+  const uword n_total = (f_type == arma_binary) ? f_n_cols : f_n_rows;
+  const uword n_block = (std::min)(n, n_total - f_n_done);
+  
+  if(n_block == 0)
+    {
+    return false;
+    }
+  
+  if(f_type == arma_binary)
+    {
+    X.set_size(f_n_rows, n_block);
+    }
+  else
+    {
+    X.set_size(n_block, 1);
+    }
+  
+  f.read( reinterpret_cast<char*>(X.memptr()), std::streamsize(X.n_elem * sizeof(eT)) );
+  
+  if(f.good() == false)
+    {
+    err_msg = "truncated data in ";
+    return false;
+    }
+
+f_n_done += n_block;
+
+  return true;
+  }
+
+
+
+//! read at most n lines of text; reading stops at the first empty line or at the end of the file
+template<typename eT>
+inline
+bool
+mat_reader<eT>::read_rows(Mat<eT>& X, const uword n, std::string& err_msg)
+  {
+  arma_extra_debug_sigprint();
+  
+  if(f_n_cols == 0)
+    {
+    return false;
+    }
+  
+  // the rows are gathered in column-major order, with a column stride of n
+  if(row_buffer.size() < n * f_n_cols)
+    {
+    row_buffer.resize(n * f_n_cols);
+    }
+  
+  uword n_block = 0;
+  
+  while( (n_block < n) && std::getline(f, line) )
+    {
+    if( (line.length() > 0) && (line[line.length()-1] == '\r') )
+      {
+      line.resize(line.length()-1);
+      }
+    
+    if(line.length() == 0)
+      {
+      f.setstate(ios::eofbit);
+      break;
+      }
+    
+    if(parse_line(&row_buffer[n_block], n, err_msg) == false)
+      {
+      return false;
+      }
+    
+    ++n_block;
+    }
+  
+  if(n_block == 0)
+    {
+    return false;
+    }
+  
+  X.set_size(n_block, f_n_cols);
+  
+  for(uword col=0; col < f_n_cols; ++col)
+    {
+    arrayops::copy( X.colptr(col), &row_buffer[col*n], n_block );
+    }
+  
+  f_n_done += n_block;
+  
+  return true;
+  }
+
+
+
+//! parse the current line, storing the value in column col at out[col*stride]
+template<typename eT>
+inline
+bool
+mat_reader<eT>::parse_line(eT* out, const uword stride, std::string& err_msg)
+  {
+  const char* ptr = line.c_str();
+  
+  if(f_type == csv_ascii)
+    {
+    // missing or uninterpretable values are set to zero, as done by diskio::load_csv_ascii()
+    for(uword col=0; col < f_n_cols; ++col)
+      {
+      eT val = eT(0);
+      
+      while( (*ptr == ' ') || (*ptr == '\t') )
+        {
+        ++ptr;
+        }
+      
+      if( (*ptr != ',') && (*ptr != char(0)) )
+        {
+        const char* next = diskio::parse_token(val, ptr);
+        
+        if(next == 0)
+          {
+          val = eT(0);
+          }
+        else
+          {
+          ptr = next;
+          }
+        }
+      
+      out[col*stride] = val;
+      
+      while( (*ptr != ',') && (*ptr != char(0)) )
+        {
+        ++ptr;
+        }
+      
+      if(*ptr == ',')
+        {
+        if(col+1 == f_n_cols)
+          {
+          err_msg = "inconsistent number of columns in ";
+          return false;
+          }
+        
+        ++ptr;
+        }
+      }
+    
+    return true;
+    }
+  
+  for(uword col=0; col < f_n_cols; ++col)
+    {
+    while( (*ptr != char(0)) && (std::isspace( static_cast<unsigned char>(*ptr) ) != 0) )
+      {
+      ++ptr;
+      }
+    
+    if(*ptr == char(0))
+      {
+      err_msg = "inconsistent number of columns in ";
+      return false;
+      }
+    
+    const char* next = diskio::parse_token(out[col*stride], ptr);
+    
+    if( (next == 0) || ( (*next != char(0)) && (std::isspace( static_cast<unsigned char>(*next) ) == 0) ) )
+      {
+      err_msg = "couldn't interpret data in ";
+      return false;
+      }
+    
+    ptr = next;
+    }
+  
+  while( (*ptr != char(0)) && (std::isspace( static_cast<unsigned char>(*ptr) ) != 0) )
+    {
+    ++ptr;
+    }
+  
+  if(*ptr != char(0))
+    {
+    err_msg = "inconsistent number of columns in ";
+    return false;
+    }
+  
+  return true;
+  }
+
+
+
+//! @}
@@ -15,13 +15,23 @@
 //! @{
 
 
+//! allocation of memory for matrices, cubes and temporary arrays.
+//! unless ARMA_USE_MEMPOOL is enabled, the memory is obtained directly from the system via memory_sys,
+//! and is aligned to arma_config::mem_alignment bytes
 class memory
   {
   public:
   
+  static const uword alignment = arma_config::mem_alignment;  //!< alignment of memory returned by acquire()
+  
   template<typename eT> arma_inline static eT*  acquire(const uword n_elem);
   
   template<typename eT> arma_inline static void release(eT* mem);
+  
+  template<typename eT> arma_inline static bool is_aligned(const eT* mem);
+  
+  template<typename eT> arma_inline static void mark_as_aligned(      eT*& mem);
+  template<typename eT> arma_inline static void mark_as_aligned(const eT*& mem);
   };
 
 
@@ -31,39 +41,84 @@ arma_inline
 eT*
 memory::acquire(const uword n_elem)
   {
-  #if   defined(ARMA_USE_TBB_ALLOC)
+  #if defined(ARMA_USE_MEMPOOL)
     {
-    return ( (eT *) scalable_malloc( sizeof(eT)*n_elem) );
+    return ( (eT *) mempool::acquire( sizeof(eT)*n_elem ) );
     }
-  #elif defined(ARMA_USE_MKL_ALLOC)
+  #else
+    {
+    return ( (eT *) memory_sys::acquire( sizeof(eT)*n_elem ) );
+    }
+  #endif
+  }
+
+
+
+template<typename eT>
+arma_inline
+void
+memory::release(eT* mem)
+  {
+  #if defined(ARMA_USE_MEMPOOL)
     {
-    return ( (eT *) mkl_malloc( sizeof(eT)*n_elem, 128 ) );
+    mempool::release( (void *)(mem) );
     }
   #else
     {
-    return ( new(std::nothrow) eT[n_elem] );
+    if(mem != 0)
+      {
+      memory_sys::release( (void *)(mem) );
+      }
     }
   #endif
   }
 
 
 
+//! true if the given memory has the same alignment as memory returned by acquire();
+//! note that the memory of small matrices (held inside the matrix object) has weaker alignment
+template<typename eT>
+arma_inline
+bool
+memory::is_aligned(const eT* mem)
+  {
+  return ( (std::size_t(mem) & std::size_t(alignment - 1)) == 0 );
+  }
+
+
+
+//! tell the compiler that the given memory is aligned (which must already be established via is_aligned()),
+//! so that loops over it can use aligned loads and stores
 template<typename eT>
 arma_inline
 void
-memory::release(eT* mem)
+memory::mark_as_aligned(eT*& mem)
   {
-  #if   defined(ARMA_USE_TBB_ALLOC)
+  #if defined(ARMA_HAVE_ASSUME_ALIGNED)
+    {
+    mem = (eT*)__builtin_assume_aligned(mem, alignment);
+    }
+  #else
     {
-    scalable_free( (void *)(mem) );
+    arma_ignore(mem);
     }
-  #elif defined(ARMA_USE_MKL_ALLOC)
+  #endif
+  }
+
+
+
+template<typename eT>
+arma_inline
+void
+memory::mark_as_aligned(const eT*& mem)
+  {
+  #if defined(ARMA_HAVE_ASSUME_ALIGNED)
     {
-    mkl_free( (void *)(mem) );
+    mem = (const eT*)__builtin_assume_aligned(mem, alignment);
     }
   #else
     {
-    delete [] mem;
+    arma_ignore(mem);
     }
   #endif
   }
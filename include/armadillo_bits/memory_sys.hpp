@@ -0,0 +1,93 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup memory_sys
+//! @{
+
+
+//! allocation of raw memory from the system, aligned to arma_config::mem_alignment bytes
+class memory_sys
+  {
+  public:
+  
+  inline static void* acquire(const size_t n_bytes);
+  inline static void  release(void* mem);
+  };
+
+
+
+inline
+void*
+memory_sys::acquire(const size_t n_bytes)
+  {
+  #if   defined(ARMA_USE_TBB_ALLOC)
+    {
+    return scalable_aligned_malloc( n_bytes, size_t(arma_config::mem_alignment) );
+    }
+  #elif defined(ARMA_USE_MKL_ALLOC)
+    {
+    return mkl_malloc( n_bytes, ( (arma_config::mem_alignment > 128) ? int(arma_config::mem_alignment) : 128 ) );
+    }
+  #elif defined(ARMA_HAVE_POSIX_MEMALIGN)
+    {
+    void* mem = 0;
+    
+    // posix_memalign() does not accept a size of zero on all systems
+    const int status = posix_memalign( &mem, size_t(arma_config::mem_alignment), ( (n_bytes > 0) ? n_bytes : 1 ) );
+    
+    return (status == 0) ? mem : 0;
+    }
+  #elif defined(_MSC_VER)
+    {
+    return _aligned_malloc( ( (n_bytes > 0) ? n_bytes : 1 ), size_t(arma_config::mem_alignment) );
+    }
+  #else
+    {
+    // fallback: malloc() is only guaranteed to provide memory suitably aligned for the fundamental types
+    return std::malloc(n_bytes);
+    }
+  #endif
+  }
+
+
+
+inline
+void
+memory_sys::release(void* mem)
+  {
+  #if   defined(ARMA_USE_TBB_ALLOC)
+    {
+    scalable_aligned_free(mem);
+    }
+  #elif defined(ARMA_USE_MKL_ALLOC)
+    {
+    mkl_free(mem);
+    }
+  #elif defined(ARMA_HAVE_POSIX_MEMALIGN)
+    {
+    std::free(mem);
+    }
+  #elif defined(_MSC_VER)
+    {
+    _aligned_free(mem);
+    }
+  #else
+    {
+    std::free(mem);
+    }
+  #endif
+  }
+
+
+
+//! @}
@@ -0,0 +1,112 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup mempool
+//! @{
+
+
+
+//! \brief
+//! While an object of this class exists, all memory for matrices and cubes
+//! allocated by the thread that created it is taken from a bump allocator,
+//! and is returned to the system in one step when the object is destroyed.
+//! Arenas can be nested; the most recently created one is used.
+//! Objects still using memory from the arena when it is destroyed
+//! (eg. a matrix declared before the arena and resized within its scope) remain valid:
+//! the memory of the arena is then kept until the last such object is destroyed or resized.
+//! Memory from an arena must be released by the thread that created the arena.
+//! The arena has no effect unless ARMA_USE_MEMPOOL is enabled.
+class mem_arena
+  {
+  public:
+  
+  inline explicit mem_arena(const uword chunk_size = 1048576);
+  inline         ~mem_arena();
+  
+  inline void* acquire(const size_t n_bytes);
+  
+  inline static void release(void* block);
+  
+  
+  private:
+  
+  inline mem_arena(const mem_arena&);             //!< not implemented
+  inline void operator=(const mem_arena&);        //!< not implemented
+  
+  //! bookkeeping shared by an arena and the blocks taken from it, as the blocks can outlive the arena
+  struct shared_state
+    {
+    void*       chunk_list;  //!< chunks obtained so far; the first pointer in each chunk links to the previous chunk
+    uword       n_blocks;    //!< number of blocks taken from the arena and not yet released
+    bool        detached;    //!< true once the arena has been destroyed
+    const void* owner;       //!< thread state of the thread that created the arena
+    };
+  
+  inline static void release_chunks(shared_state* state);
+  
+  #if defined(ARMA_USE_MEMPOOL)
+    const size_t  chunk_size;   //!< minimum size of each chunk obtained from the system
+    shared_state* shared;       //!< allocated when the first chunk is needed
+    char*         chunk_pos;    //!< start of the free part of the current chunk
+    char*         chunk_end;    //!< end of the current chunk
+    mem_arena*    previous;     //!< arena that was active when this one was created
+  #endif
+  };
+
+
+
+//! pooled allocator used by memory::acquire() and memory::release() when ARMA_USE_MEMPOOL is enabled.
+//! blocks are grouped into power-of-two size classes;
+//! released blocks are kept in per-thread free lists for reuse, instead of being returned to the system.
+class mempool
+  {
+  public:
+  
+  static const size_t min_block_size = 128;      //!< size of the smallest size class, including the block header
+  static const uword  n_classes      = 14;       //!< number of size classes; the largest is min_block_size << (n_classes-1), ie. 1 MB
+  static const size_t max_cached     = 1048576;  //!< approximate number of bytes kept in each free list
+  static const uword  max_n_cached   = 64;       //!< maximum number of blocks kept in each free list
+  
+  static const uword  direct_class   = n_classes;      //!< marks blocks too large for the pool
+  static const uword  arena_class    = n_classes + 1;  //!< marks blocks taken from a mem_arena
+  
+  //! each block is preceded by a header holding its size class (and for blocks from an arena, the arena's shared state);
+  //! the header occupies a whole alignment unit, so that the payload keeps the alignment provided by memory_sys
+  static const size_t header_size = arma_config::mem_alignment;
+  
+  struct thread_state
+    {
+    void*      free_list[n_classes];  //!< the first pointer in each free block links to the next free block
+    uword      n_cached[n_classes];
+    mem_arena* arena;
+    bool       registered;            //!< true if the free lists will be released when the thread exits
+    };
+  
+  inline static void* acquire(const size_t n_bytes);
+  inline static void  release(void* mem);
+  
+  inline static thread_state& get_thread_state();
+  
+  inline static void release_thread_state(void* state_ptr);
+  
+  #if defined(ARMA_HAVE_PTHREAD_KEY)
+  inline static pthread_key_t& thread_key();
+  inline static void           create_thread_key();
+  #endif
+  
+  arma_inline static void* set_header(void* block, const uword size_class);
+  };
+
+
+
+//! @}
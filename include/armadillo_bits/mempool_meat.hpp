@@ -0,0 +1,379 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup mempool
+//! @{
+
+
+
+#if defined(ARMA_USE_MEMPOOL)
+
+
+
+inline
+mem_arena::mem_arena(const uword in_chunk_size)
+  : chunk_size(in_chunk_size)
+  , shared(0)
+  , chunk_pos(0)
+  , chunk_end(0)
+  {
+  mempool::thread_state& state = mempool::get_thread_state();
+  
+  previous    = state.arena;
+  state.arena = this;
+  }
+
+
+
+inline
+mem_arena::~mem_arena()
+  {
+  mempool::get_thread_state().arena = previous;
+  
+  if(shared != 0)
+    {
+    shared->detached = true;
+    
+    if(shared->n_blocks == 0)
+      {
+      mem_arena::release_chunks(shared);
+      }
+    }
+  }
+
+
+
+inline
+void*
+mem_arena::acquire(const size_t n_bytes)
+  {
+  if(shared == 0)
+    {
+    shared = (shared_state*)memory_sys::acquire( sizeof(shared_state) );
+    
+    if(shared == 0)
+      {
+      return 0;
+      }
+    
+    shared->chunk_list = 0;
+    shared->n_blocks   = 0;
+    shared->detached   = false;
+    shared->owner      = &(mempool::get_thread_state());
+    }
+  
+  // keep each block aligned
+  const size_t align_mask = size_t(arma_config::mem_alignment - 1);
+  
+  const size_t n_needed = size_t(mempool::header_size) + ( (n_bytes + align_mask) & ~align_mask );
+  
+  if( size_t(chunk_end - chunk_pos) < n_needed )
+    {
+    const size_t n_chunk = size_t(mempool::header_size) + (std::max)(size_t(chunk_size), n_needed);
+    
+    void* chunk = memory_sys::acquire(n_chunk);
+    
+    if(chunk == 0)
+      {
+      return 0;
+      }
+    
+    *( (void**)chunk ) = shared->chunk_list;
+    shared->chunk_list = chunk;
+    
+    chunk_pos = (char*)chunk + mempool::header_size;
+    chunk_end = (char*)chunk + n_chunk;
+    }
+  
+  void* block = chunk_pos;
+  chunk_pos  += n_needed;
+  
+  // the shared state is recorded at the end of the block header, after the size class
+  *( (shared_state**)( (char*)block + mempool::header_size - sizeof(shared_state*) ) ) = shared;
+  
+  shared->n_blocks++;
+  
+  return mempool::set_header(block, mempool::arena_class);
+  }
+
+
+
+//! called by mempool::release() for blocks taken from an arena
+inline
+void
+mem_arena::release(void* block)
+  {
+  shared_state* state = *( (shared_state**)( (char*)block + mempool::header_size - sizeof(shared_state*) ) );
+  
+  arma_debug_check( (state->owner != &(mempool::get_thread_state())), "mem_arena: memory from an arena must be released by the thread that created the arena" );
+  
+  state->n_blocks--;
+  
+  if( (state->detached == true) && (state->n_blocks == 0) )
+    {
+    mem_arena::release_chunks(state);
+    }
+  }
+
+
+
+inline
+void
+mem_arena::release_chunks(shared_state* state)
+  {
+  void* chunk = state->chunk_list;
+  
+  while(chunk != 0)
+    {
+    void* prev_chunk = *( (void**)chunk );
+    
+    memory_sys::release(chunk);
+    
+    chunk = prev_chunk;
+    }
+  
+  memory_sys::release(state);
+  }
+
+
+
+#else
+
+
+
+inline
+mem_arena::mem_arena(const uword)
+  {
+  }
+
+
+
+inline
+mem_arena::~mem_arena()
+  {
+  }
+
+
+
+inline
+void*
+mem_arena::acquire(const size_t)
+  {
+  return 0;
+  }
+
+
+
+inline
+void
+mem_arena::release(void*)
+  {
+  }
+
+
+
+#endif
+
+
+
+#if defined(ARMA_USE_MEMPOOL)
+
+
+
+inline
+mempool::thread_state&
+mempool::get_thread_state()
+  {
+  static arma_thread_local thread_state state;  // zero initialised
+  
+  #if defined(ARMA_HAVE_PTHREAD_KEY)
+    {
+    // thread local variables declared via __thread can't have destructors,
+    // so the free lists are attached to thread-specific data, which is cleaned up by the destructor function of the key
+    if(state.registered == false)
+      {
+      static pthread_once_t once = PTHREAD_ONCE_INIT;
+      
+      pthread_once(&once, &mempool::create_thread_key);
+      
+      state.registered = ( pthread_setspecific(thread_key(), &state) == 0 );
+      }
+    }
+  #endif
+  
+  return state;
+  }
+
+
+
+#if defined(ARMA_HAVE_PTHREAD_KEY)
+
+inline
+pthread_key_t&
+mempool::thread_key()
+  {
+  static pthread_key_t key;
+  
+  return key;
+  }
+
+
+
+inline
+void
+mempool::create_thread_key()
+  {
+  pthread_key_create(&thread_key(), &mempool::release_thread_state);
+  }
+
+#endif
+
+
+
+//! return the blocks held in the free lists of a thread to the system;
+//! called when the thread exits
+inline
+void
+mempool::release_thread_state(void* state_ptr)
+  {
+  thread_state& state = *( (thread_state*)state_ptr );
+  
+  for(uword size_class=0; size_class < n_classes; ++size_class)
+    {
+    void* block = state.free_list[size_class];
+    
+    while(block != 0)
+      {
+      void* next_block = *( (void**)block );
+      
+      memory_sys::release(block);
+      
+      block = next_block;
+      }
+    
+    state.free_list[size_class] = 0;
+    state.n_cached[size_class]  = 0;
+    }
+  
+  // memory released by destructors that run later in the exit of the thread causes the state to be registered again
+  state.registered = false;
+  }
+
+
+
+arma_inline
+void*
+mempool::set_header(void* block, const uword size_class)
+  {
+  *( (uword*)block ) = size_class;
+  
+  return ( (char*)block + header_size );
+  }
+
+
+
+inline
+void*
+mempool::acquire(const size_t n_bytes)
+  {
+  thread_state& state = get_thread_state();
+  
+  if(state.arena != 0)
+    {
+    return state.arena->acquire(n_bytes);
+    }
+  
+  const size_t n_total = n_bytes + header_size;
+  
+  uword  size_class = 0;
+  size_t block_size = min_block_size;
+  
+  while( (block_size < n_total) && (size_class < n_classes) )
+    {
+    ++size_class;
+    block_size <<= 1;
+    }
+  
+  if(size_class == n_classes)
+    {
+    void* block = memory_sys::acquire(n_total);
+    
+    return (block != 0) ? set_header(block, direct_class) : 0;
+    }
+  
+  void* block = state.free_list[size_class];
+  
+  if(block != 0)
+    {
+    state.free_list[size_class] = *( (void**)block );
+    state.n_cached[size_class]--;
+    }
+  else
+    {
+    block = memory_sys::acquire(block_size);
+    }
+  
+  return (block != 0) ? set_header(block, size_class) : 0;
+  }
+
+
+
+inline
+void
+mempool::release(void* mem)
+  {
+  if(mem == 0)
+    {
+    return;
+    }
+  
+  void* block = (char*)mem - header_size;
+  
+  const uword size_class = *( (uword*)block );
+  
+  if(size_class == arena_class)
+    {
+    mem_arena::release(block);
+    return;
+    }
+  
+  if(size_class == direct_class)
+    {
+    memory_sys::release(block);
+    return;
+    }
+  
+  thread_state& state = get_thread_state();
+  
+  const uword limit = (std::min)( uword(max_n_cached), (std::max)( uword(2), uword(max_cached / (min_block_size << size_class)) ) );
+  
+  if(state.n_cached[size_class] < limit)
+    {
+    *( (void**)block ) = state.free_list[size_class];
+    
+    state.free_list[size_class] = block;
+    state.n_cached[size_class]++;
+    }
+  else
+    {
+    memory_sys::release(block);
+    }
+  }
+
+
+
+#endif
+
+
+
+//! @}
@@ -0,0 +1,112 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup mp_misc
+//! @{
+
+
+
+#if defined(ARMA_USE_OPENMP)
+  #define arma_omp_pragma(x) _Pragma(#x)
+#else
+  #define arma_omp_pragma(x)
+#endif
+
+
+
+//! helpers for deciding whether an operation should be parallelised via OpenMP
+class mp_gate
+  {
+  public:
+  
+  //! number of threads that can be used by a parallelised operation
+  arma_inline
+  static
+  int
+  n_threads()
+    {
+    #if defined(ARMA_USE_OPENMP)
+      {
+      const int n_max = omp_get_max_threads();
+      
+      #if defined(ARMA_OPENMP_THREADS)
+        {
+        return ( (n_max < int(ARMA_OPENMP_THREADS)) ? n_max : ( (int(ARMA_OPENMP_THREADS) > 0) ? int(ARMA_OPENMP_THREADS) : 1 ) );
+        }
+      #else
+        {
+        return n_max;
+        }
+      #endif
+      }
+    #else
+      {
+      return 1;
+      }
+    #endif
+    }
+  
+  
+  //! true if more than one thread can be used at this point;
+  //! nested parallelism is avoided, so that user code already running inside a parallel region is not oversubscribed
+  arma_inline
+  static
+  bool
+  available()
+    {
+    #if defined(ARMA_USE_OPENMP)
+      {
+      return ( (omp_in_parallel() == 0) && (n_threads() > 1) );
+      }
+    #else
+      {
+      return false;
+      }
+    #endif
+    }
+  
+  
+  //! true if an element-wise operation involving the given number of elements should be parallelised
+  arma_inline
+  static
+  bool
+  eval(const uword n_work)
+    {
+    return ( (n_work >= arma_config::mp_threshold) && available() );
+    }
+  
+  
+  //! number of blocks of rows for a row-wise operation on a matrix with the given size;
+  //! each block is processed by one thread and has at least 16 rows, so that threads rarely share cache lines.
+  //! the result is 1 if the operation should not be parallelised
+  arma_inline
+  static
+  uword
+  n_row_blocks(const uword n_rows, const uword n_cols)
+    {
+    const uword max_blocks = n_rows / 16;
+    
+    if( (max_blocks < 2) || (eval(n_rows * n_cols) == false) )
+      {
+      return 1;
+      }
+    
+    const uword n = uword(n_threads());
+    
+    return (n < max_blocks) ? n : max_blocks;
+    }
+  };
+
+
+
+//! @}
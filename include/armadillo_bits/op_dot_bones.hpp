@@ -22,7 +22,10 @@ class op_dot
   public:
   
   template<typename eT>
-  arma_hot arma_pure arma_inline static eT direct_dot_arma(const uword n_elem, const eT* const A, const eT* const B);
+  arma_hot arma_pure inline static eT direct_dot_arma(const uword n_elem, const eT* const A, const eT* const B);
+  
+  template<typename eT>
+  arma_hot arma_pure inline static eT direct_dot_block(const uword n_elem, const eT* const A, const eT* const B);
   
   template<typename eT>
   arma_hot arma_pure inline static typename arma_float_only<eT>::result
@@ -48,6 +51,19 @@ class op_dot
   
   template<typename T1, typename T2>
   arma_hot inline static typename T1::elem_type apply_proxy (const Base<typename T1::elem_type,T1>& X, const Base<typename T1::elem_type,T2>& Y);
+  
+  
+  //! element accessor for the pairwise sums in direct_dot_block() and apply_proxy()
+  template<typename eT, typename ea_type1, typename ea_type2>
+  struct prod_ea
+    {
+    const ea_type1 A;
+    const ea_type2 B;
+    
+    arma_inline prod_ea(const ea_type1 in_A, const ea_type2 in_B) : A(in_A), B(in_B) {}
+    
+    arma_inline eT operator[](const uword i) const { return A[i] * B[i]; }
+    };
   };
 
 
@@ -17,33 +17,54 @@
 
 
 
-//! for two arrays, generic version
+//! for two arrays, generic version.
+//! the products are summed in blocks, which are combined pairwise (see pairwise_acc)
 template<typename eT>
 arma_hot
 arma_pure
-arma_inline
+inline
 eT
 op_dot::direct_dot_arma(const uword n_elem, const eT* const A, const eT* const B)
   {
   arma_extra_debug_sigprint();
   
-  eT val1 = eT(0);
-  eT val2 = eT(0);
+  typedef pairwise_acc<eT> acc_type;
+  
+  if(n_elem <= acc_type::block_size)
+    {
+    return op_dot::direct_dot_block(n_elem, A, B);
+    }
   
-  uword i, j;
+  acc_type acc;
   
-  for(i=0, j=1; j<n_elem; i+=2, j+=2)
+  for(uword i=0; i < n_elem; i += acc_type::block_size)
     {
-    val1 += A[i] * B[i];
-    val2 += A[j] * B[j];
+    const uword n_remaining = n_elem - i;
+    
+    acc.add( op_dot::direct_dot_block( (n_remaining < acc_type::block_size) ? n_remaining : uword(acc_type::block_size), &A[i], &B[i] ) );
     }
   
-  if(i < n_elem)
+  return acc.get();
+  }
+
+
+
+//! for two arrays, a single block
+template<typename eT>
+arma_hot
+arma_pure
+inline
+eT
+op_dot::direct_dot_block(const uword n_elem, const eT* const A, const eT* const B)
+  {
+  eT val = eT(0);
+  
+  if(simd::dot<pairwise_acc<eT>::compensated>(val, A, B, n_elem))
     {
-    val1 += A[i] * B[i];
+    return val;
     }
   
-  return val1 + val2;
+  return pairwise_acc<eT>::direct_sum( prod_ea<eT, const eT*, const eT*>(A, B), 0, n_elem );
   }
 
 
@@ -58,23 +79,39 @@ op_dot::direct_dot(const uword n_elem, const eT* const A, const eT* const B)
   {
   arma_extra_debug_sigprint();
   
-  if( n_elem <= (128/sizeof(eT)) )
+  typedef pairwise_acc<eT> acc_type;
+  
+  if( (n_elem <= (128/sizeof(eT))) || (acc_type::compensated) )
     {
     return op_dot::direct_dot_arma(n_elem, A, B);
     }
   else
     {
-    #if defined(ARMA_USE_ATLAS)
+    #if defined(ARMA_USE_ATLAS) || defined(ARMA_USE_BLAS)
       {
-      arma_extra_debug_print("atlas::cblas_dot()");
+      // BLAS is used for each block; the block sums are combined pairwise, so that the result does not drift for long arrays.
+      // the blocks are larger than usual, to amortise the overhead of calling BLAS
+      const uword blas_block_size = 4*acc_type::block_size;
       
-      return atlas::cblas_dot(n_elem, A, B);
-      }
-    #elif defined(ARMA_USE_BLAS)
-      {
-      arma_extra_debug_print("blas::dot()");
+      acc_type acc;
       
-      return blas::dot(n_elem, A, B);
+      for(uword i=0; i < n_elem; i += blas_block_size)
+        {
+        const uword n_remaining = n_elem - i;
+        const uword n_block     = (n_remaining < blas_block_size) ? n_remaining : blas_block_size;
+        
+        #if defined(ARMA_USE_ATLAS)
+          {
+          acc.add( atlas::cblas_dot(n_block, &A[i], &B[i]) );
+          }
+        #else
+          {
+          acc.add( blas::dot(n_block, &A[i], &B[i]) );
+          }
+        #endif
+        }
+      
+      return acc.get();
       }
     #else
       {
@@ -218,23 +255,7 @@ op_dot::apply_proxy(const Base<typename T1::elem_type,T1>& X, const Base<typenam
           ea_type1 PA = A.get_ea();
           ea_type2 PB = B.get_ea();
     
-    eT val1 = eT(0);
-    eT val2 = eT(0);
-    
-    uword i,j;
-    
-    for(i=0, j=1; j<N; i+=2, j+=2)
-      {
-      val1 += PA[i] * PB[i];
-      val2 += PA[j] * PB[j];
-      }
-    
-    if(i < N)
-      {
-      val1 += PA[i] * PB[i];
-      }
-    
-    return val1 + val2;
+    return pairwise_acc<eT>::accumulate( prod_ea<eT, ea_type1, ea_type2>(PA, PB), N );
     }
   else
     {
@@ -0,0 +1,52 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup op_fft
+//! @{
+
+
+
+class op_fft_real
+  {
+  public:
+  
+  template<typename T1>
+  inline static void apply( Mat< std::complex<typename T1::pod_type> >& out, const mtOp<std::complex<typename T1::pod_type>,T1,op_fft_real>& in );
+  };
+
+
+
+class op_fft_cx
+  {
+  public:
+  
+  template<typename T1>
+  inline static void apply( Mat<typename T1::elem_type>& out, const Op<T1,op_fft_cx>& in );
+  
+  template<typename T, bool fwd>
+  inline static void apply_noalias( Mat< std::complex<T> >& out, const Mat< std::complex<T> >& X, const uword a, const uword b );
+  };
+
+
+
+class op_ifft_cx
+  {
+  public:
+  
+  template<typename T1>
+  inline static void apply( Mat<typename T1::elem_type>& out, const Op<T1,op_ifft_cx>& in );
+  };
+
+
+
+//! @}
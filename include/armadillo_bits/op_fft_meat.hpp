@@ -0,0 +1,275 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup op_fft
+//! @{
+
+
+
+//! FFT of real input.
+//! For an even transform length N, the N real elements are packed into N/2 complex elements,
+//! which are transformed with an FFT of half the length; the full spectrum is then recovered
+//! from the half-length spectrum, using the conjugate symmetry of the FFT of real data.
+template<typename T1>
+inline
+void
+op_fft_real::apply( Mat< std::complex<typename T1::pod_type> >& out, const mtOp<std::complex<typename T1::pod_type>,T1,op_fft_real>& in )
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::pod_type T;
+  typedef std::complex<T>       cx_type;
+  
+  arma_type_check(( (is_float<T>::value == false) && (is_double<T>::value == false) ));
+  
+  const unwrap<T1>   tmp(in.m);
+  const Mat<T>& X = tmp.M;
+  
+  const uword n_rows = X.n_rows;
+  const uword n_cols = X.n_cols;
+  
+  const bool  is_vec = ( (n_rows == 1) || (n_cols == 1) );
+  
+  const uword n_in   = (is_vec) ? X.n_elem : n_rows;
+  const uword N      = (in.aux_uword_b == 1) ? in.aux_uword_a : n_in;
+  const uword n_vecs = (is_vec) ? uword(1) : n_cols;
+  
+  if(is_vec)
+    {
+    (n_cols == 1) ? out.set_size(N, 1) : out.set_size(1, N);
+    }
+  else
+    {
+    out.set_size(N, n_cols);
+    }
+  
+  if( (out.n_elem == 0) || (N == 0) )
+    {
+    return;
+    }
+  
+  const uword n_copy = (std::min)(N, n_in);
+  
+  const bool use_mp = (n_vecs > 1) && mp_gate::eval(N * n_vecs);
+  
+  if( (N % 2) == 0 )
+    {
+    const uword M = N/2;
+    
+    const fft_engine<cx_type,true> engine(M);
+    
+    // w[k] = exp(-2 pi i k / N)
+    podarray<cx_type> w(M);
+    
+    fft_engine<cx_type,true>::roots(w.memptr(), M, N);
+    
+    arma_omp_pragma(omp parallel if(use_mp))
+      {
+      podarray<cx_type> z(M);
+      podarray<cx_type> Z(M);
+      
+      arma_omp_pragma(omp for schedule(static))
+      for(uword j=0; j < n_vecs; ++j)
+        {
+        const T*       x_mem = X.memptr() + j*n_rows;
+              cx_type* y_mem = out.memptr() + j*N;
+        
+        // pack: z[k] = x[2k] + i x[2k+1], zero padded
+        
+        for(uword k=0; k < M; ++k)
+          {
+          const uword i = 2*k;
+          
+          z[k] = cx_type( (i < n_copy) ? x_mem[i] : T(0), (i+1 < n_copy) ? x_mem[i+1] : T(0) );
+          }
+        
+        engine.run(Z.memptr(), z.memptr());
+        
+        // unpack: the spectra of the even and odd elements are E[k] = (Z[k] + conj(Z[M-k]))/2 and O[k] = (Z[k] - conj(Z[M-k]))/(2i)
+        
+        for(uword k=0; k <= M; ++k)
+          {
+          const cx_type Zk = Z[ (k < M) ? k : 0 ];
+          const cx_type Zc = std::conj( Z[ (k > 0) ? (M-k) : 0 ] );
+          
+          const cx_type E  = (Zk + Zc) * T(0.5);
+          const cx_type D  = (Zk - Zc) * T(0.5);
+          const cx_type O  = cx_type( D.imag(), -D.real() );
+          
+          const cx_type Xk = (k < M) ? (E + fft_engine<cx_type,true>::mul(w[k], O)) : (E - O);
+          
+          y_mem[k] = Xk;
+          
+          if( (k > 0) && (k < M) )
+            {
+            y_mem[N-k] = std::conj(Xk);
+            }
+          }
+        }
+      }
+    }
+  else
+    {
+    const fft_engine<cx_type,true> engine(N);
+    
+    arma_omp_pragma(omp parallel if(use_mp))
+      {
+      podarray<cx_type> z(N);
+      
+      arma_omp_pragma(omp for schedule(static))
+      for(uword j=0; j < n_vecs; ++j)
+        {
+        const T* x_mem = X.memptr() + j*n_rows;
+        
+        for(uword i=0; i < N; ++i)
+          {
+          z[i] = cx_type( (i < n_copy) ? x_mem[i] : T(0), T(0) );
+          }
+        
+        engine.run(out.memptr() + j*N, z.memptr());
+        }
+      }
+    }
+  
+  arma_ignore(use_mp);
+  }
+
+
+
+template<typename T1>
+inline
+void
+op_fft_cx::apply( Mat<typename T1::elem_type>& out, const Op<T1,op_fft_cx>& in )
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::pod_type T;
+  
+  const unwrap<T1> tmp(in.m);
+  
+  if(&(tmp.M) != &out)
+    {
+    op_fft_cx::apply_noalias<T,true>(out, tmp.M, in.aux_uword_a, in.aux_uword_b);
+    }
+  else
+    {
+    Mat< std::complex<T> > out2;
+    
+    op_fft_cx::apply_noalias<T,true>(out2, tmp.M, in.aux_uword_a, in.aux_uword_b);
+    
+    out.steal_mem(out2);
+    }
+  }
+
+
+
+template<typename T, bool fwd>
+inline
+void
+op_fft_cx::apply_noalias( Mat< std::complex<T> >& out, const Mat< std::complex<T> >& X, const uword a, const uword b )
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef std::complex<T> cx_type;
+  
+  arma_type_check(( (is_float<T>::value == false) && (is_double<T>::value == false) ));
+  
+  const uword n_rows = X.n_rows;
+  const uword n_cols = X.n_cols;
+  
+  const bool  is_vec = ( (n_rows == 1) || (n_cols == 1) );
+  
+  const uword n_in   = (is_vec) ? X.n_elem : n_rows;
+  const uword N      = (b == 1) ? a : n_in;
+  const uword n_vecs = (is_vec) ? uword(1) : n_cols;
+  
+  if(is_vec)
+    {
+    (n_cols == 1) ? out.set_size(N, 1) : out.set_size(1, N);
+    }
+  else
+    {
+    out.set_size(N, n_cols);
+    }
+  
+  if( (out.n_elem == 0) || (N == 0) )
+    {
+    return;
+    }
+  
+  const fft_engine<cx_type,fwd> engine(N);
+  
+  const bool use_mp = (n_vecs > 1) && mp_gate::eval(N * n_vecs);
+  
+  arma_omp_pragma(omp parallel if(use_mp))
+    {
+    podarray<cx_type> z( (N > n_in) ? N : uword(0) );
+    
+    arma_omp_pragma(omp for schedule(static))
+    for(uword j=0; j < n_vecs; ++j)
+      {
+      const cx_type* x_mem = X.memptr() + j*n_rows;
+            cx_type* y_mem = out.memptr() + j*N;
+      
+      if(N <= n_in)
+        {
+        engine.run(y_mem, x_mem);
+        }
+      else
+        {
+        arrayops::copy(z.memptr(), x_mem, n_in);
+        arrayops::inplace_set(z.memptr() + n_in, cx_type(0), N - n_in);
+        
+        engine.run(y_mem, z.memptr());
+        }
+      
+      if(fwd == false)
+        {
+        arrayops::inplace_mul(y_mem, cx_type( T(1) / T(N) ), N);
+        }
+      }
+    }
+  
+  arma_ignore(use_mp);
+  }
+
+
+
+template<typename T1>
+inline
+void
+op_ifft_cx::apply( Mat<typename T1::elem_type>& out, const Op<T1,op_ifft_cx>& in )
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename T1::pod_type T;
+  
+  const unwrap<T1> tmp(in.m);
+  
+  if(&(tmp.M) != &out)
+    {
+    op_fft_cx::apply_noalias<T,false>(out, tmp.M, in.aux_uword_a, in.aux_uword_b);
+    }
+  else
+    {
+    Mat< std::complex<T> > out2;
+    
+    op_fft_cx::apply_noalias<T,false>(out2, tmp.M, in.aux_uword_a, in.aux_uword_b);
+    
+    out.steal_mem(out2);
+    }
+  }
+
+
+
+//! @}
@@ -18,10 +18,215 @@
 
 
 
+//! true if the elements of expression T1 are random, ie. T1 involves randu() or randn() in a form that's evaluated on access
+template<typename T1>
+struct op_find_random
+  {
+  static const bool value = false;
+  };
+
+template<typename T1>
+struct op_find_random< Gen<T1, gen_randu> >
+  {
+  static const bool value = true;
+  };
+
+template<typename T1>
+struct op_find_random< Gen<T1, gen_randn> >
+  {
+  static const bool value = true;
+  };
+
+template<typename T1, typename eop_type>
+struct op_find_random< eOp<T1, eop_type> >
+  {
+  static const bool value = op_find_random<T1>::value;
+  };
+
+template<typename T1, typename T2, typename eglue_type>
+struct op_find_random< eGlue<T1, T2, eglue_type> >
+  {
+  static const bool value = op_find_random<T1>::value || op_find_random<T2>::value;
+  };
+
+
+
+//! element access used by find(), which reads each element twice (to count the matching elements, then to store their indices).
+//! the elements are read via Proxy, so that expressions (eg. exp(A), A.submat(...)) are evaluated in each pass rather than stored;
+//! expressions involving randu() or randn() are evaluated once into a temporary matrix, as they would give different values in each pass
+template<typename T1, bool is_random = op_find_random<T1>::value>
+class op_find_access
+  {
+  public:
+  
+  typedef typename T1::elem_type elem_type;
+  
+  static const bool use_at = Proxy<T1>::prefer_at_accessor;
+  
+  inline op_find_access(const T1& X) : P(X), ea(P.get_ea()), n_rows(P.get_n_rows()), n_cols(P.get_n_cols()), n_elem(P.get_n_elem()) {}
+  
+  arma_inline elem_type operator[] (const uword i)                    const { return ea[i];          }
+  arma_inline elem_type at         (const uword row, const uword col) const { return P.at(row, col); }
+  
+  const Proxy<T1>                   P;
+  const typename Proxy<T1>::ea_type ea;
+  const uword                       n_rows;
+  const uword                       n_cols;
+  const uword                       n_elem;
+  };
+
+
+
+template<typename T1>
+class op_find_access<T1, true>
+  {
+  public:
+  
+  typedef typename T1::elem_type elem_type;
+  
+  static const bool use_at = false;
+  
+  inline op_find_access(const T1& X) : M(X), mem(M.memptr()), n_rows(M.n_rows), n_cols(M.n_cols), n_elem(M.n_elem) {}
+  
+  arma_inline elem_type operator[] (const uword i)                    const { return mem[i];          }
+  arma_inline elem_type at         (const uword row, const uword col) const { return M.at(row, col); }
+  
+  const Mat<elem_type> M;
+  const elem_type*     mem;
+  const uword          n_rows;
+  const uword          n_cols;
+  const uword          n_elem;
+  };
+
+
+
+//! predicates evaluated by find() for each element, either by index or, if use_at is true, by row and column
+
+template<typename access_type>
+struct op_find_pred_nonzero
+  {
+  typedef typename access_type::elem_type eT;
+  
+  static const bool use_at = access_type::use_at;
+  
+  const access_type& A;
+  
+  inline op_find_pred_nonzero(const access_type& in_A) : A(in_A) {}
+  
+  arma_inline uword get_n_rows() const { return A.n_rows; }
+  
+  arma_inline bool operator()(const uword i)                    const { return (A[i]          != eT(0)); }
+  arma_inline bool at        (const uword row, const uword col) const { return (A.at(row, col) != eT(0)); }
+  };
+
+
+
+template<typename op_type, typename access_type>
+struct op_find_pred_rel
+  {
+  typedef typename access_type::elem_type eT;
+  
+  static const bool use_at = access_type::use_at;
+  
+  const access_type& A;
+  const eT           val;
+  
+  inline op_find_pred_rel(const access_type& in_A, const eT in_val) : A(in_A), val(in_val) {}
+  
+  arma_inline uword get_n_rows() const { return A.n_rows; }
+  
+  arma_inline bool operator()(const uword i)                    const { return test(A[i]);          }
+  arma_inline bool at        (const uword row, const uword col) const { return test(A.at(row, col)); }
+  
+  arma_inline bool test(const eT tmp) const;
+  };
+
+
+
+template<typename op_type, typename access_type>
+struct op_find_pred_rel_cx
+  {
+  typedef typename access_type::elem_type eT;
+  
+  static const bool use_at = access_type::use_at;
+  
+  const access_type& A;
+  const eT           val;
+  
+  inline op_find_pred_rel_cx(const access_type& in_A, const eT in_val) : A(in_A), val(in_val) {}
+  
+  arma_inline uword get_n_rows() const { return A.n_rows; }
+  
+  arma_inline bool operator()(const uword i)                    const { return test(A[i]);          }
+  arma_inline bool at        (const uword row, const uword col) const { return test(A.at(row, col)); }
+  
+  arma_inline bool test(const eT tmp) const;
+  };
+
+
+
+template<typename glue_type, typename access_type1, typename access_type2>
+struct op_find_pred_glue_rel
+  {
+  typedef typename access_type1::elem_type eT1;
+  typedef typename access_type2::elem_type eT2;
+  
+  static const bool use_at = access_type1::use_at || access_type2::use_at;
+  
+  const access_type1& A;
+  const access_type2& B;
+  
+  inline op_find_pred_glue_rel(const access_type1& in_A, const access_type2& in_B) : A(in_A), B(in_B) {}
+  
+  arma_inline uword get_n_rows() const { return A.n_rows; }
+  
+  arma_inline bool operator()(const uword i)                    const { return test(A[i],          B[i]);          }
+  arma_inline bool at        (const uword row, const uword col) const { return test(A.at(row, col), B.at(row, col)); }
+  
+  arma_inline bool test(const eT1 tmp1, const eT2 tmp2) const;
+  };
+
+
+
+template<typename glue_type, typename access_type1, typename access_type2>
+struct op_find_pred_glue_rel_cx
+  {
+  typedef typename access_type1::elem_type eT1;
+  typedef typename access_type2::elem_type eT2;
+  
+  static const bool use_at = access_type1::use_at || access_type2::use_at;
+  
+  const access_type1& A;
+  const access_type2& B;
+  
+  inline op_find_pred_glue_rel_cx(const access_type1& in_A, const access_type2& in_B) : A(in_A), B(in_B) {}
+  
+  arma_inline uword get_n_rows() const { return A.n_rows; }
+  
+  arma_inline bool operator()(const uword i)                    const { return test(A[i],          B[i]);          }
+  arma_inline bool at        (const uword row, const uword col) const { return test(A.at(row, col), B.at(row, col)); }
+  
+  arma_inline bool test(const eT1& tmp1, const eT2& tmp2) const;
+  };
+
+
+
 class op_find
   {
   public:
   
+  //! number of elements in each block counted or filled by one thread
+  static const uword block_size = 4096;
+  
+  template<typename pred_type>
+  inline static uword count_block(const pred_type& pred, const uword start, const uword end);
+  
+  template<typename pred_type>
+  inline static void fill_block(uword* out, const pred_type& pred, const uword start, const uword end, const uword n_nz);
+  
+  template<typename pred_type>
+  inline static uword find_indices(Mat<uword>& indices, const pred_type& pred, const uword n_elem);
+  
   template<typename T1>
   inline static uword
   helper
@@ -18,44 +18,275 @@
 
 
 
-template<typename T1>
+template<typename op_type, typename access_type>
+arma_inline
+bool
+op_find_pred_rel<op_type, access_type>::test(const eT tmp) const
+  {
+       if(is_same_type<op_type, op_rel_lt_pre   >::value == true)  { return (val <  tmp); }
+  else if(is_same_type<op_type, op_rel_lt_post  >::value == true)  { return (tmp <  val); }
+  else if(is_same_type<op_type, op_rel_gt_pre   >::value == true)  { return (val >  tmp); }
+  else if(is_same_type<op_type, op_rel_gt_post  >::value == true)  { return (tmp >  val); }
+  else if(is_same_type<op_type, op_rel_lteq_pre >::value == true)  { return (val <= tmp); }
+  else if(is_same_type<op_type, op_rel_lteq_post>::value == true)  { return (tmp <= val); }
+  else if(is_same_type<op_type, op_rel_gteq_pre >::value == true)  { return (val >= tmp); }
+  else if(is_same_type<op_type, op_rel_gteq_post>::value == true)  { return (tmp >= val); }
+  else if(is_same_type<op_type, op_rel_eq       >::value == true)  { return (tmp == val); }
+  else if(is_same_type<op_type, op_rel_noteq    >::value == true)  { return (tmp != val); }
+  else return false;
+  }
+
+
+
+template<typename op_type, typename access_type>
+arma_inline
+bool
+op_find_pred_rel_cx<op_type, access_type>::test(const eT tmp) const
+  {
+       if(is_same_type<op_type, op_rel_eq   >::value == true)  { return (tmp == val); }
+  else if(is_same_type<op_type, op_rel_noteq>::value == true)  { return (tmp != val); }
+  else return false;
+  }
+
+
+
+template<typename glue_type, typename access_type1, typename access_type2>
+arma_inline
+bool
+op_find_pred_glue_rel<glue_type, access_type1, access_type2>::test(const eT1 tmp1, const eT2 tmp2) const
+  {
+       if(is_same_type<glue_type, glue_rel_lt    >::value == true)  { return (tmp1 <  tmp2); }
+  else if(is_same_type<glue_type, glue_rel_gt    >::value == true)  { return (tmp1 >  tmp2); }
+  else if(is_same_type<glue_type, glue_rel_lteq  >::value == true)  { return (tmp1 <= tmp2); }
+  else if(is_same_type<glue_type, glue_rel_gteq  >::value == true)  { return (tmp1 >= tmp2); }
+  else if(is_same_type<glue_type, glue_rel_eq    >::value == true)  { return (tmp1 == tmp2); }
+  else if(is_same_type<glue_type, glue_rel_noteq >::value == true)  { return (tmp1 != tmp2); }
+  else return false;
+  }
+
+
+
+template<typename glue_type, typename access_type1, typename access_type2>
+arma_inline
+bool
+op_find_pred_glue_rel_cx<glue_type, access_type1, access_type2>::test(const eT1& tmp1, const eT2& tmp2) const
+  {
+       if(is_same_type<glue_type, glue_rel_eq    >::value == true)  { return (tmp1 == tmp2); }
+  else if(is_same_type<glue_type, glue_rel_noteq >::value == true)  { return (tmp1 != tmp2); }
+  else return false;
+  }
+
+
+
+//! number of elements in [start, end) that satisfy the predicate;
+//! the loop has no branches that depend on the data, so that it can be vectorised by the compiler
+template<typename pred_type>
+arma_hot
 inline
 uword
-op_find::helper
-  (
-  Mat<uword>& indices,
-  const Base<typename T1::elem_type, T1>& X
-  )
+op_find::count_block(const pred_type& pred, const uword start, const uword end)
+  {
+  uword n_nz = 0;
+  
+  if(pred_type::use_at == false)
+    {
+    for(uword i=start; i<end; ++i)
+      {
+      n_nz += (pred(i)) ? uword(1) : uword(0);
+      }
+    }
+  else
+  if(start < end)
+    {
+    // elements accessed via at(): the block is processed as runs of rows within each column
+    const uword n_rows = pred.get_n_rows();
+    
+    uword row = start % n_rows;
+    uword col = start / n_rows;
+    
+    for(uword i=start; i<end; row=0, ++col)
+      {
+      const uword len = ( (end - i) < (n_rows - row) ) ? (end - i) : (n_rows - row);
+      
+      for(uword j=0; j<len; ++j)
+        {
+        n_nz += (pred.at(row+j, col)) ? uword(1) : uword(0);
+        }
+      
+      i += len;
+      }
+    }
+  
+  return n_nz;
+  }
+
+
+
+//! write the indices of the n_nz elements in [start, end) that satisfy the predicate
+template<typename pred_type>
+arma_hot
+inline
+void
+op_find::fill_block(uword* out, const pred_type& pred, const uword start, const uword end, const uword n_nz)
+  {
+  const uword n = end - start;
+  
+  if(n_nz == n)
+    {
+    for(uword j=0; j<n; ++j)
+      {
+      out[j] = start + j;
+      }
+    }
+  else
+  if(pred_type::use_at == true)
+    {
+    const uword n_rows = pred.get_n_rows();
+    
+    uword row = start % n_rows;
+    uword col = start / n_rows;
+    
+    uword count = 0;
+    
+    for(uword i=start; count < n_nz; row=0, ++col)
+      {
+      const uword len = ( (end - i) < (n_rows - row) ) ? (end - i) : (n_rows - row);
+      
+      // as for dense blocks below, each index is stored unconditionally
+      for(uword j=0; (j < len) && (count < n_nz); ++j)
+        {
+        out[count] = i+j;
+        
+        count += (pred.at(row+j, col)) ? uword(1) : uword(0);
+        }
+      
+      i += len;
+      }
+    }
+  else
+  if( (8*n_nz) >= n )
+    {
+    // dense block: each index is stored unconditionally and the output position only advances for elements that satisfy the predicate.
+    // this avoids unpredictable branches; the loop stops at the last matching element, so all writes are within the block's part of the output
+    uword count = 0;
+    
+    for(uword i=start; count < n_nz; ++i)
+      {
+      out[count] = i;
+      
+      count += (pred(i)) ? uword(1) : uword(0);
+      }
+    }
+  else
+    {
+    uword count = 0;
+    
+    for(uword i=start; count < n_nz; ++i)
+      {
+      if(pred(i) == true)
+        {
+        out[count] = i;
+        ++count;
+        }
+      }
+    }
+  }
+
+
+
+//! indices of the elements that satisfy the predicate, in increasing order.
+//! the elements are processed in blocks: the matching elements in each block are counted first,
+//! so that the output can be allocated with its final size and each block written at its own offset.
+//! both passes are parallelised with OpenMP for large numbers of elements.
+template<typename pred_type>
+inline
+uword
+op_find::find_indices(Mat<uword>& indices, const pred_type& pred, const uword n_elem)
   {
   arma_extra_debug_sigprint();
   
-  typedef typename T1::elem_type      eT;
-  typedef typename Proxy<T1>::ea_type ea_type;
+  const uword n_blocks = (n_elem + block_size - 1) / block_size;
   
-  const Proxy<T1> A(X.get_ref());
+  if(n_blocks <= 1)
+    {
+    const uword n_nz = op_find::count_block(pred, 0, n_elem);
+    
+    indices.set_size(n_nz, 1);
+    
+    op_find::fill_block(indices.memptr(), pred, 0, n_elem, n_nz);
+    
+    return n_nz;
+    }
+  
+  podarray<uword> offsets(n_blocks + 1);
   
-  ea_type   PA     = A.get_ea();
-  const uword n_elem = A.get_n_elem();
+  uword* offsets_mem = offsets.memptr();
   
-  indices.set_size(n_elem, 1);
+  const bool use_mp    = mp_gate::eval(n_elem);
+  const int  n_threads = mp_gate::n_threads();
+  
+  arma_omp_pragma(omp parallel for schedule(static) if(use_mp) num_threads(n_threads))
+  for(uword block=0; block < n_blocks; ++block)
+    {
+    const uword start = block * block_size;
+    const uword end   = (block == n_blocks-1) ? n_elem : (start + block_size);
+    
+    offsets_mem[block+1] = op_find::count_block(pred, start, end);
+    }
+  
+  offsets_mem[0] = 0;
+  
+  for(uword block=0; block < n_blocks; ++block)
+    {
+    offsets_mem[block+1] += offsets_mem[block];
+    }
+  
+  const uword n_nz = offsets_mem[n_blocks];
+  
+  indices.set_size(n_nz, 1);
   
   uword* indices_mem = indices.memptr();
-  uword  n_nz        = 0;
   
-  for(uword i=0; i<n_elem; ++i)
+  arma_omp_pragma(omp parallel for schedule(static) if(use_mp) num_threads(n_threads))
+  for(uword block=0; block < n_blocks; ++block)
     {
-    if(PA[i] != eT(0))
+    const uword start = block * block_size;
+    const uword end   = (block == n_blocks-1) ? n_elem : (start + block_size);
+    
+    const uword block_n_nz = offsets_mem[block+1] - offsets_mem[block];
+    
+    if(block_n_nz > 0)
       {
-      indices_mem[n_nz] = i;
-      ++n_nz;
+      op_find::fill_block(&indices_mem[ offsets_mem[block] ], pred, start, end, block_n_nz);
       }
     }
-   
+  
+  arma_ignore(use_mp);
+  arma_ignore(n_threads);
+  
   return n_nz;
   }
 
 
 
+template<typename T1>
+inline
+uword
+op_find::helper
+  (
+  Mat<uword>& indices,
+  const Base<typename T1::elem_type, T1>& X
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  const op_find_access<T1> A(X.get_ref());
+  
+  return op_find::find_indices(indices, op_find_pred_nonzero< op_find_access<T1> >(A), A.n_elem);
+  }
+
+
+
 template<typename T1, typename op_type>
 inline
 uword
@@ -71,47 +302,9 @@ op_find::helper
   arma_ignore(junk1);
   arma_ignore(junk2);
   
-  typedef typename T1::elem_type      eT;
-  typedef typename Proxy<T1>::ea_type ea_type;
-  
-  const eT val = X.aux;
-  
-  const Proxy<T1> A(X.m);
-  
-  ea_type   PA     = A.get_ea();
-  const uword n_elem = A.get_n_elem();
-  
-  indices.set_size(n_elem, 1);
-  
-  uword* indices_mem = indices.memptr();
-  uword  n_nz        = 0;
-  
-  for(uword i=0; i<n_elem; ++i)
-    {
-    const eT tmp = PA[i];
-    
-    bool not_zero;
-    
-         if(is_same_type<op_type, op_rel_lt_pre   >::value == true)  { not_zero = (val <  tmp); }
-    else if(is_same_type<op_type, op_rel_lt_post  >::value == true)  { not_zero = (tmp <  val); }
-    else if(is_same_type<op_type, op_rel_gt_pre   >::value == true)  { not_zero = (val >  tmp); }
-    else if(is_same_type<op_type, op_rel_gt_post  >::value == true)  { not_zero = (tmp >  val); }
-    else if(is_same_type<op_type, op_rel_lteq_pre >::value == true)  { not_zero = (val <= tmp); }
-    else if(is_same_type<op_type, op_rel_lteq_post>::value == true)  { not_zero = (tmp <= val); }
-    else if(is_same_type<op_type, op_rel_gteq_pre >::value == true)  { not_zero = (val >= tmp); }
-    else if(is_same_type<op_type, op_rel_gteq_post>::value == true)  { not_zero = (tmp >= val); }
-    else if(is_same_type<op_type, op_rel_eq       >::value == true)  { not_zero = (tmp == val); }
-    else if(is_same_type<op_type, op_rel_noteq    >::value == true)  { not_zero = (tmp != val); }
-    else not_zero = false;
-    
-    if(not_zero == true)
-      {
-      indices_mem[n_nz] = i;
-      ++n_nz;
-      }
-    }
+  const op_find_access<T1> A(X.m);
   
-  return n_nz;
+  return op_find::find_indices(indices, op_find_pred_rel< op_type, op_find_access<T1> >(A, X.aux), A.n_elem);
   }
 
 
@@ -131,39 +324,9 @@ op_find::helper
   arma_ignore(junk1);
   arma_ignore(junk2);
   
-  typedef typename T1::elem_type      eT;
-  typedef typename Proxy<T1>::ea_type ea_type;
-  
-  const eT val = X.aux;
-  
-  const Proxy<T1> A(X.m);
+  const op_find_access<T1> A(X.m);
   
-  ea_type   PA     = A.get_ea();
-  const uword n_elem = A.get_n_elem();
-  
-  indices.set_size(n_elem, 1);
-  
-  uword* indices_mem = indices.memptr();
-  uword  n_nz        = 0;
-  
-  for(uword i=0; i<n_elem; ++i)
-    {
-    const eT tmp = PA[i];
-    
-    bool not_zero;
-    
-         if(is_same_type<op_type, op_rel_eq   >::value == true)  { not_zero = (tmp == val); }
-    else if(is_same_type<op_type, op_rel_noteq>::value == true)  { not_zero = (tmp != val); }
-    else not_zero = false;
-    
-    if(not_zero == true)
-      {
-      indices_mem[n_nz] = i;
-      ++n_nz;
-      }
-    }
-  
-  return n_nz;
+  return op_find::find_indices(indices, op_find_pred_rel_cx< op_type, op_find_access<T1> >(A, X.aux), A.n_elem);
   }
 
 
@@ -185,49 +348,12 @@ op_find::helper
   arma_ignore(junk2);
   arma_ignore(junk3);
   
-  typedef typename T1::elem_type eT1;
-  typedef typename T2::elem_type eT2;
-  
-  typedef typename Proxy<T1>::ea_type ea_type1;
-  typedef typename Proxy<T2>::ea_type ea_type2;
-  
-  const Proxy<T1> A(X.A);
-  const Proxy<T2> B(X.B);
-  
-  arma_debug_assert_same_size(A, B, "relational operator");
-  
-  ea_type1  PA     = A.get_ea();
-  ea_type2  PB     = B.get_ea();
-  const uword n_elem = B.get_n_elem();
+  const op_find_access<T1> A(X.A);
+  const op_find_access<T2> B(X.B);
   
-  indices.set_size(n_elem, 1);
+  arma_debug_assert_same_size(A.n_rows, A.n_cols, B.n_rows, B.n_cols, "relational operator");
   
-  uword* indices_mem = indices.memptr();
-  uword  n_nz        = 0;
-  
-  for(uword i=0; i<n_elem; ++i)
-    {
-    const eT1 tmp1 = PA[i];
-    const eT2 tmp2 = PB[i];
-    
-    bool not_zero;
-    
-         if(is_same_type<glue_type, glue_rel_lt    >::value == true)  { not_zero = (tmp1 <  tmp2); }
-    else if(is_same_type<glue_type, glue_rel_gt    >::value == true)  { not_zero = (tmp1 >  tmp2); }
-    else if(is_same_type<glue_type, glue_rel_lteq  >::value == true)  { not_zero = (tmp1 <= tmp2); }
-    else if(is_same_type<glue_type, glue_rel_gteq  >::value == true)  { not_zero = (tmp1 >= tmp2); }
-    else if(is_same_type<glue_type, glue_rel_eq    >::value == true)  { not_zero = (tmp1 == tmp2); }
-    else if(is_same_type<glue_type, glue_rel_noteq >::value == true)  { not_zero = (tmp1 != tmp2); }
-    else not_zero = false;
-    
-    if(not_zero == true)
-      {
-      indices_mem[n_nz] = i;
-      ++n_nz;
-      }
-    }
-  
-  return n_nz;
+  return op_find::find_indices(indices, op_find_pred_glue_rel< glue_type, op_find_access<T1>, op_find_access<T2> >(A, B), B.n_elem);
   }
 
 
@@ -249,39 +375,12 @@ op_find::helper
   arma_ignore(junk2);
   arma_ignore(junk3);
   
-  typedef typename Proxy<T1>::ea_type ea_type1;
-  typedef typename Proxy<T2>::ea_type ea_type2;
+  const op_find_access<T1> A(X.A);
+  const op_find_access<T2> B(X.B);
   
-  const Proxy<T1> A(X.A);
-  const Proxy<T2> B(X.B);
-  
-  arma_debug_assert_same_size(A, B, "relational operator");
-  
-  ea_type1  PA     = A.get_ea();
-  ea_type2  PB     = B.get_ea();
-  const uword n_elem = B.get_n_elem();
-  
-  indices.set_size(n_elem, 1);
-  
-  uword* indices_mem = indices.memptr();
-  uword  n_nz        = 0;
+  arma_debug_assert_same_size(A.n_rows, A.n_cols, B.n_rows, B.n_cols, "relational operator");
   
-  for(uword i=0; i<n_elem; ++i)
-    {
-    bool not_zero;
-    
-         if(is_same_type<glue_type, glue_rel_eq    >::value == true)  { not_zero = (PA[i] == PB[i]); }
-    else if(is_same_type<glue_type, glue_rel_noteq >::value == true)  { not_zero = (PA[i] != PB[i]); }
-    else not_zero = false;
-    
-    if(not_zero == true)
-      {
-      indices_mem[n_nz] = i;
-      ++n_nz;
-      }
-    }
-  
-  return n_nz;
+  return op_find::find_indices(indices, op_find_pred_glue_rel_cx< glue_type, op_find_access<T1>, op_find_access<T2> >(A, B), B.n_elem);
   }
 
 
@@ -301,13 +400,19 @@ op_find::apply(Mat<uword>& out, const mtOp<uword, T1, op_find>& X)
   
   if(n_nz > 0)
     {
+    if( (k == 0) || (k >= n_nz) )
+      {
+      // indices has exactly n_nz elements, so its memory can be used directly
+      out.steal_mem(indices);
+      }
+    else
     if(type == 0)   // "first"
       {
-      out = (k > 0 && k <= n_nz) ? indices.rows(0,      k-1   ) : indices.rows(0, n_nz-1);
+      out = indices.rows(0,      k-1   );
       }
     else   // "last"
       {
-      out = (k > 0 && k <= n_nz) ? indices.rows(n_nz-k, n_nz-1) : indices.rows(0, n_nz-1);
+      out = indices.rows(n_nz-k, n_nz-1);
       }
     }
   else
@@ -21,6 +21,11 @@ class op_htrans
   {
   public:
   
+  template<typename eT>
+  arma_hot inline static void inplace_conj(eT* mem, const uword n_elem);
+  
+  //
+  
   template<typename eT>
   arma_hot arma_inline static void apply_noalias(Mat<eT>& out, const Mat<eT>& A, const typename arma_not_cx<eT>::result* junk = 0);
   
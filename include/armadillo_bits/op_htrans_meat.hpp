@@ -16,6 +16,20 @@
 
 
 
+template<typename eT>
+arma_hot
+inline
+void
+op_htrans::inplace_conj(eT* mem, const uword n_elem)
+  {
+  for(uword i=0; i < n_elem; ++i)
+    {
+    mem[i] = std::conj(mem[i]);
+    }
+  }
+
+
+
 template<typename eT>
 arma_hot
 arma_inline
@@ -56,6 +70,13 @@ op_htrans::apply_noalias(Mat<eT>& out, const Mat<eT>& A, const typename arma_cx_
       out_mem[i] = std::conj(A_mem[i]);
       }
     }
+  else
+  if( (A_n_rows >= op_strans::large_min_size) && (A_n_cols >= op_strans::large_min_size) )
+    {
+    op_strans::apply_noalias_large(out, A);
+    
+    op_htrans::inplace_conj( out.memptr(), out.n_elem );
+    }
   else
     {
     for(uword in_row = 0; in_row < A_n_rows; ++in_row)
@@ -109,21 +130,18 @@ op_htrans::apply(Mat<eT>& out, const Mat<eT>& A, const typename arma_cx_only<eT>
       {
       arma_extra_debug_print("doing in-place hermitian transpose of a square matrix");
       
-      for(uword col=0; col < n_cols; ++col)
-        {
-        eT* coldata = out.colptr(col);
-        
-        out.at(col,col) = std::conj( out.at(col,col) );
-        
-        for(uword row=(col+1); row < n_rows; ++row)
-          {
-          const eT val1 = std::conj(coldata[row]);
-          const eT val2 = std::conj(out.at(col,row));
-          
-          out.at(col,row) = val1;
-          coldata[row]    = val2;
-          }
-        }
+      op_strans::apply_inplace_square(out);
+      
+      op_htrans::inplace_conj( out.memptr(), out.n_elem );
+      }
+    else
+    if(op_strans::use_inplace_lowmem(out) == true)
+      {
+      arma_extra_debug_print("doing in-place hermitian transpose of a non-square matrix");
+      
+      op_strans::apply_inplace_lowmem(out);
+      
+      op_htrans::inplace_conj( out.memptr(), out.n_elem );
       }
     else
       {
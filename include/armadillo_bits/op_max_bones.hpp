@@ -37,6 +37,9 @@ class op_max
   template<typename eT>
   inline static eT direct_max(const Mat<eT>& X, const uword row);
   
+  template<typename eT>
+  inline static void direct_max_rows(eT* out_mem, const Mat<eT>& X);
+  
   template<typename eT>
   inline static eT max(const subview<eT>& X);
   
@@ -56,6 +59,9 @@ class op_max
   template<typename T>
   inline static std::complex<T> direct_max(const Mat< std::complex<T> >& X, const uword row);
   
+  template<typename T>
+  inline static void direct_max_rows(std::complex<T>* out_mem, const Mat< std::complex<T> >& X);
+  
   template<typename T>
   inline static std::complex<T> max(const subview< std::complex<T> >& X);
   
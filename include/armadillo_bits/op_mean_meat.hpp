@@ -49,10 +49,17 @@ op_mean::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_mean>& in)
       {
       eT* out_mem = out.memptr();
       
+      const bool use_mp    = mp_gate::eval(X.n_elem);
+      const int  n_threads = mp_gate::n_threads();
+      
+      arma_omp_pragma(omp parallel for schedule(static) if(use_mp) num_threads(n_threads))
       for(uword col=0; col < X_n_cols; ++col)
         {
         out_mem[col] = op_mean::direct_mean( X.colptr(col), X_n_rows );
         }
+      
+      arma_ignore(use_mp);
+      arma_ignore(n_threads);
       }
     }
   else
@@ -66,9 +73,13 @@ op_mean::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_mean>& in)
       {
       eT* out_mem = out.memptr();
       
+      op_sum::direct_sum_rows(out_mem, X);
+      
       for(uword row=0; row < X_n_rows; ++row)
         {
-        out_mem[row] = op_mean::direct_mean( X, row );
+        const eT result = out_mem[row] / T(X_n_cols);
+        
+        out_mem[row] = arma_isfinite(result) ? result : op_mean::direct_mean_robust(X, row);
         }
       }
     }
@@ -226,10 +237,14 @@ op_mean::mean_all(const subview<eT>& X)
     }
   else
     {
+    pairwise_acc<eT> acc;
+    
     for(uword col=0; col < X_n_cols; ++col)
       {
-      val += arrayops::accumulate(X.colptr(col), X_n_rows);
+      acc.add( arrayops::accumulate(X.colptr(col), X_n_rows) );
       }
+    
+    val = acc.get();
     }
   
   const eT result = val / T(X_n_elem);
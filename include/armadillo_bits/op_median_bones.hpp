@@ -42,8 +42,11 @@ class op_median
   template<typename T1>
   inline static void apply(Mat<typename T1::elem_type>& out, const Op<T1,op_median>& in);
   
-  template<typename T, typename T1>
-  inline static void apply(Mat< std::complex<T> >& out, const Op<T1,op_median>& in);
+  template<typename T1>
+  inline static void apply_noalias(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, const uword dim, const typename arma_not_cx<typename T1::elem_type>::result* junk = 0);
+  
+  template<typename T1>
+  inline static void apply_noalias(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, const uword dim, const typename arma_cx_only<typename T1::elem_type>::result* junk = 0);
   
   //
   //
@@ -58,10 +61,10 @@ class op_median
   //
   
   template<typename eT>
-  inline static eT direct_median(std::vector<eT>& X);
+  inline static eT direct_median(eT* X, const uword n_elem);
   
   template<typename T>
-  inline static void direct_cx_median_index(uword& out_index1, uword& out_index2, std::vector< arma_cx_median_packet<T> >& X);
+  inline static void direct_cx_median_index(uword& out_index1, uword& out_index2, arma_cx_median_packet<T>* X, const uword n_elem);
   };
 
 
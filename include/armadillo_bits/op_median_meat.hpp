@@ -29,135 +29,229 @@ op_median::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_median>& in)
   
   typedef typename T1::elem_type eT;
   
-  const unwrap_check<T1> tmp(in.m, out);
-  const Mat<eT>&     X = tmp.M;
-  
-  const uword X_n_rows = X.n_rows;
-  const uword X_n_cols = X.n_cols;
-  
   const uword dim = in.aux_uword_a;
   arma_debug_check( (dim > 1), "median(): incorrect usage. dim must be 0 or 1");
   
+  const Proxy<T1> P(in.m);
+  
+  if(P.is_alias(out) == false)
+    {
+    op_median::apply_noalias(out, P, dim);
+    }
+  else
+    {
+    Mat<eT> tmp;
+    
+    op_median::apply_noalias(tmp, P, dim);
+    
+    out.steal_mem(tmp);
+    }
+  }
+
+
+
+//! The elements of each column or row are copied directly from the proxy into a scratch array,
+//! which is allocated once (per thread) and reused.
+//! When OpenMP is enabled and the matrix is large enough, the columns or rows are processed in parallel.
+template<typename T1>
+inline
+void
+op_median::apply_noalias(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, const uword dim, const typename arma_not_cx<typename T1::elem_type>::result* junk)
+  {
+  arma_extra_debug_sigprint();
+  arma_ignore(junk);
+  
+  typedef typename T1::elem_type eT;
+  
+  typedef typename Proxy<T1>::ea_type ea_type;
+  
+  const uword n_rows = P.get_n_rows();
+  const uword n_cols = P.get_n_cols();
+  
+  const bool use_ea = (Proxy<T1>::prefer_at_accessor == false);
+  
+  ea_type A = P.get_ea();
+  
   if(dim == 0)  // in each column
     {
     arma_extra_debug_print("op_median::apply(), dim = 0");
     
-    arma_debug_check( (X_n_rows == 0), "median(): given object has zero rows" );
+    arma_debug_check( (n_rows == 0), "median(): given object has zero rows" );
     
-    out.set_size(1, X_n_cols);
+    out.set_size(1, n_cols);
     
-    std::vector<eT> tmp_vec(X_n_rows);
-      
-    for(uword col=0; col<X_n_cols; ++col)
+    eT* out_mem = out.memptr();
+    
+    const bool use_mp = (n_cols > 1) && mp_gate::eval(n_rows*n_cols);
+    
+    arma_omp_pragma(omp parallel if(use_mp))
       {
-      const eT* colmem = X.colptr(col);
+      podarray<eT> tmp_array(n_rows);
+      
+      eT* tmp_mem = tmp_array.memptr();
       
-      for(uword row=0; row<X_n_rows; ++row)
+      arma_omp_pragma(omp for schedule(static))
+      for(uword col=0; col < n_cols; ++col)
         {
-        tmp_vec[row] = colmem[row];
+        if(use_ea)
+          {
+          const uword offset = col*n_rows;
+          
+          for(uword row=0; row < n_rows; ++row)
+            {
+            tmp_mem[row] = A[offset + row];
+            }
+          }
+        else
+          {
+          for(uword row=0; row < n_rows; ++row)
+            {
+            tmp_mem[row] = P.at(row,col);
+            }
+          }
+        
+        out_mem[col] = op_median::direct_median(tmp_mem, n_rows);
         }
-      
-      out[col] = op_median::direct_median(tmp_vec);
       }
+    
+    arma_ignore(use_mp);
     }
   else
   if(dim == 1)  // in each row
     {
     arma_extra_debug_print("op_median::apply(), dim = 1");
     
-    arma_debug_check( (X_n_cols == 0), "median(): given object has zero columns" );
+    arma_debug_check( (n_cols == 0), "median(): given object has zero columns" );
     
-    out.set_size(X_n_rows, 1);
+    out.set_size(n_rows, 1);
     
-    std::vector<eT> tmp_vec(X_n_cols);
-      
-    for(uword row=0; row<X_n_rows; ++row)
+    eT* out_mem = out.memptr();
+    
+    const bool use_mp = (n_rows > 1) && mp_gate::eval(n_rows*n_cols);
+    
+    arma_omp_pragma(omp parallel if(use_mp))
       {
-      for(uword col=0; col<X_n_cols; ++col)
+      podarray<eT> tmp_array(n_cols);
+      
+      eT* tmp_mem = tmp_array.memptr();
+      
+      arma_omp_pragma(omp for schedule(static))
+      for(uword row=0; row < n_rows; ++row)
         {
-        tmp_vec[col] = X.at(row,col);
+        if(use_ea)
+          {
+          for(uword col=0; col < n_cols; ++col)
+            {
+            tmp_mem[col] = A[col*n_rows + row];
+            }
+          }
+        else
+          {
+          for(uword col=0; col < n_cols; ++col)
+            {
+            tmp_mem[col] = P.at(row,col);
+            }
+          }
+        
+        out_mem[row] = op_median::direct_median(tmp_mem, n_cols);
         }
-      
-      out[row] = op_median::direct_median(tmp_vec);
       }
+    
+    arma_ignore(use_mp);
     }
   }
 
 
 
 //! Implementation for complex numbers
-template<typename T, typename T1>
+template<typename T1>
 inline
 void
-op_median::apply(Mat< std::complex<T> >& out, const Op<T1,op_median>& in)
+op_median::apply_noalias(Mat<typename T1::elem_type>& out, const Proxy<T1>& P, const uword dim, const typename arma_cx_only<typename T1::elem_type>::result* junk)
   {
   arma_extra_debug_sigprint();
+  arma_ignore(junk);
   
-  typedef typename std::complex<T> eT;
-  
-  arma_type_check(( is_same_type<eT, typename T1::elem_type>::value == false ));
-  
-  const unwrap_check<T1> tmp(in.m, out);
-  const Mat<eT>&     X = tmp.M;
-  
-  const uword X_n_rows = X.n_rows;
-  const uword X_n_cols = X.n_cols;
+  typedef typename T1::elem_type eT;
+  typedef typename T1::pod_type   T;
   
-  const uword dim = in.aux_uword_a;
-  arma_debug_check( (dim > 1), "median(): incorrect usage. dim must be 0 or 1");
+  const uword n_rows = P.get_n_rows();
+  const uword n_cols = P.get_n_cols();
   
   if(dim == 0)  // in each column
     {
     arma_extra_debug_print("op_median::apply(), dim = 0");
     
-    arma_debug_check( (X_n_rows == 0), "median(): given object has zero rows" );
-
-    out.set_size(1, X_n_cols);
+    arma_debug_check( (n_rows == 0), "median(): given object has zero rows" );
+    
+    out.set_size(1, n_cols);
+    
+    eT* out_mem = out.memptr();
     
-    std::vector< arma_cx_median_packet<T> > tmp_vec(X_n_rows);
+    const bool use_mp = (n_cols > 1) && mp_gate::eval(n_rows*n_cols);
     
-    for(uword col=0; col<X_n_cols; ++col)
+    arma_omp_pragma(omp parallel if(use_mp))
       {
-      const eT* colmem = X.colptr(col);
+      podarray< arma_cx_median_packet<T> > tmp_array(n_rows);
       
-      for(uword row=0; row<X_n_rows; ++row)
-        {
-        tmp_vec[row].val   = std::abs(colmem[row]);
-        tmp_vec[row].index = row;
-        }
+      arma_cx_median_packet<T>* tmp_mem = tmp_array.memptr();
       
-      uword index1;
-      uword index2;
-      op_median::direct_cx_median_index(index1, index2, tmp_vec);
+      arma_omp_pragma(omp for schedule(static))
+      for(uword col=0; col < n_cols; ++col)
+        {
+        for(uword row=0; row < n_rows; ++row)
+          {
+          tmp_mem[row].val   = std::abs( P.at(row,col) );
+          tmp_mem[row].index = row;
+          }
+        
+        uword index1;
+        uword index2;
+        op_median::direct_cx_median_index(index1, index2, tmp_mem, n_rows);
         
-      out[col] = op_mean::robust_mean(colmem[index1], colmem[index2]);
+        out_mem[col] = op_mean::robust_mean( P.at(index1,col), P.at(index2,col) );
+        }
       }
+    
+    arma_ignore(use_mp);
     }
   else
   if(dim == 1)  // in each row
     {
     arma_extra_debug_print("op_median::apply(), dim = 1");
     
-    arma_debug_check( (X_n_cols == 0), "median(): given object has zero columns" );
+    arma_debug_check( (n_cols == 0), "median(): given object has zero columns" );
+    
+    out.set_size(n_rows, 1);
     
-    out.set_size(X_n_rows, 1);
+    eT* out_mem = out.memptr();
     
-    std::vector< arma_cx_median_packet<T> > tmp_vec(X_n_cols);
+    const bool use_mp = (n_rows > 1) && mp_gate::eval(n_rows*n_cols);
     
-    for(uword row=0; row<X_n_rows; ++row)
+    arma_omp_pragma(omp parallel if(use_mp))
       {
-      for(uword col=0; col<X_n_cols; ++col)
-        {
-        tmp_vec[col].val   = std::abs(X.at(row,col));
-        tmp_vec[col].index = col;
-        }
+      podarray< arma_cx_median_packet<T> > tmp_array(n_cols);
       
-      uword index1;
-      uword index2;
-      op_median::direct_cx_median_index(index1, index2, tmp_vec);
+      arma_cx_median_packet<T>* tmp_mem = tmp_array.memptr();
       
-      out[row] = op_mean::robust_mean( X.at(row,index1), X.at(row,index2) );
+      arma_omp_pragma(omp for schedule(static))
+      for(uword row=0; row < n_rows; ++row)
+        {
+        for(uword col=0; col < n_cols; ++col)
+          {
+          tmp_mem[col].val   = std::abs( P.at(row,col) );
+          tmp_mem[col].index = col;
+          }
+        
+        uword index1;
+        uword index2;
+        op_median::direct_cx_median_index(index1, index2, tmp_mem, n_cols);
+        
+        out_mem[row] = op_mean::robust_mean( P.at(row,index1), P.at(row,index2) );
+        }
       }
+    
+    arma_ignore(use_mp);
     }
   }
 
@@ -183,8 +277,10 @@ op_median::median_vec
   
   arma_debug_check( (n_elem == 0), "median(): given object has no elements" );
   
-  std::vector<eT> tmp_vec(n_elem);
-    
+  podarray<eT> tmp_array(n_elem);
+  
+  eT* tmp_mem = tmp_array.memptr();
+  
   if(Proxy<T1>::prefer_at_accessor == false)
     {
     typedef typename Proxy<T1>::ea_type ea_type;
@@ -193,7 +289,7 @@ op_median::median_vec
     
     for(uword i=0; i<n_elem; ++i)
       {
-      tmp_vec[i] = A[i];
+      tmp_mem[i] = A[i];
       }
     }
   else
@@ -205,7 +301,7 @@ op_median::median_vec
       {
       for(uword row=0; row < n_rows; ++row)
         {
-        tmp_vec[row] = P.at(row,0);
+        tmp_mem[row] = P.at(row,0);
         }
       }
     else
@@ -213,7 +309,7 @@ op_median::median_vec
       {
       for(uword col=0; col < n_cols; ++col)
         {
-        tmp_vec[col] = P.at(0,col);
+        tmp_mem[col] = P.at(0,col);
         }
       }
     else
@@ -222,7 +318,7 @@ op_median::median_vec
       }
     }
   
-  return op_median::direct_median(tmp_vec);
+  return op_median::direct_median(tmp_mem, n_elem);
   }
 
 
@@ -248,7 +344,9 @@ op_median::median_vec
   
   arma_debug_check( (n_elem == 0), "median(): given object has no elements" );
   
-  std::vector< arma_cx_median_packet<T> > tmp_vec(n_elem);
+  podarray< arma_cx_median_packet<T> > tmp_array(n_elem);
+  
+  arma_cx_median_packet<T>* tmp_mem = tmp_array.memptr();
   
   if(Proxy<T1>::prefer_at_accessor == false)
     {
@@ -258,13 +356,13 @@ op_median::median_vec
     
     for(uword i=0; i<n_elem; ++i)
       {
-      tmp_vec[i].val   = std::abs( A[i] );
-      tmp_vec[i].index = i;
+      tmp_mem[i].val   = std::abs( A[i] );
+      tmp_mem[i].index = i;
       }
     
     uword index1;
     uword index2;
-    op_median::direct_cx_median_index(index1, index2, tmp_vec);
+    op_median::direct_cx_median_index(index1, index2, tmp_mem, n_elem);
     
     return op_mean::robust_mean( A[index1], A[index2] );
     }
@@ -277,13 +375,13 @@ op_median::median_vec
       {
       for(uword row=0; row < n_rows; ++row)
         {
-        tmp_vec[row].val   = std::abs( P.at(row,0) );
-        tmp_vec[row].index = row;
+        tmp_mem[row].val   = std::abs( P.at(row,0) );
+        tmp_mem[row].index = row;
         }
       
       uword index1;
       uword index2;
-      op_median::direct_cx_median_index(index1, index2, tmp_vec);
+      op_median::direct_cx_median_index(index1, index2, tmp_mem, n_elem);
       
       return op_mean::robust_mean( P.at(index1,0), P.at(index2,0) );
       }
@@ -292,13 +390,13 @@ op_median::median_vec
       {
       for(uword col=0; col < n_cols; ++col)
         {
-        tmp_vec[col].val   = std::abs( P.at(0,col) );
-        tmp_vec[col].index = col;
+        tmp_mem[col].val   = std::abs( P.at(0,col) );
+        tmp_mem[col].index = col;
         }
       
       uword index1;
       uword index2;
-      op_median::direct_cx_median_index(index1, index2, tmp_vec);
+      op_median::direct_cx_median_index(index1, index2, tmp_mem, n_elem);
       
       return op_mean::robust_mean( P.at(0,index1), P.at(0,index2) );
       }
@@ -313,22 +411,25 @@ op_median::median_vec
 
 
 
-//! find the median value of a std::vector (contents is modified)
+//! find the median value of an array (contents is modified).
+//! the middle element is found by selection (std::nth_element), rather than by sorting the whole array;
+//! for an even number of elements, the other middle element is the largest element preceding it
 template<typename eT>
 inline 
 eT
-op_median::direct_median(std::vector<eT>& X)
+op_median::direct_median(eT* X, const uword n_elem)
   {
   arma_extra_debug_sigprint();
   
-  const uword n_elem = X.size();
-  const uword half   = n_elem/2;
+  const uword half = n_elem/2;
   
-  std::sort(X.begin(), X.end());
+  std::nth_element(&X[0], &X[half], &X[n_elem]);
   
   if((n_elem % 2) == 0)
     {
-    return op_mean::robust_mean(X[half-1], X[half]);
+    const eT val1 = *( std::max_element(&X[0], &X[half]) );
+    
+    return op_mean::robust_mean(val1, X[half]);
     }
   else
     {
@@ -345,20 +446,20 @@ op_median::direct_cx_median_index
   (
   uword& out_index1, 
   uword& out_index2, 
-  std::vector< arma_cx_median_packet<T> >& X
+  arma_cx_median_packet<T>* X,
+  const uword n_elem
   )
   {
   arma_extra_debug_sigprint();
   
-  const uword n_elem = X.size();
-  const uword half   = n_elem/2;
+  const uword half = n_elem/2;
   
-  std::sort(X.begin(), X.end());
+  std::nth_element(&X[0], &X[half], &X[n_elem]);
   
   if((n_elem % 2) == 0)
     {
-    out_index1 = X[half-1].index;
-    out_index2 = X[half  ].index;
+    out_index1 = std::max_element(&X[0], &X[half])->index;
+    out_index2 = X[half].index;
     }
   else
     {
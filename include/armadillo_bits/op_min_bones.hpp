@@ -36,6 +36,9 @@ class op_min
   template<typename eT>
   inline static eT direct_min(const Mat<eT>& X, const uword row);
   
+  template<typename eT>
+  inline static void direct_min_rows(eT* out_mem, const Mat<eT>& X);
+  
   template<typename eT>
   inline static eT min(const subview<eT>& X);
   
@@ -55,6 +58,9 @@ class op_min
   template<typename T>
   inline static std::complex<T> direct_min(const Mat< std::complex<T> >& X, const uword row);
   
+  template<typename T>
+  inline static void direct_min_rows(std::complex<T>* out_mem, const Mat< std::complex<T> >& X);
+  
   template<typename T>
   inline static std::complex<T> min(const subview< std::complex<T> >&X);
   
@@ -46,10 +46,17 @@ inline void op_min::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_min>&
     
     eT* out_mem = out.memptr();
     
+    const bool use_mp    = mp_gate::eval(X.n_elem);
+    const int  n_threads = mp_gate::n_threads();
+    
+    arma_omp_pragma(omp parallel for schedule(static) if(use_mp) num_threads(n_threads))
     for(uword col=0; col<X_n_cols; ++col)
       {
       out_mem[col] = op_min::direct_min( X.colptr(col), X_n_rows );
       }
+    
+    arma_ignore(use_mp);
+    arma_ignore(n_threads);
     }
   else
   if(dim == 1)  // min in each row
@@ -60,12 +67,7 @@ inline void op_min::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_min>&
 
     out.set_size(X_n_rows, 1);
     
-    eT* out_mem = out.memptr();
-    
-    for(uword row=0; row<X_n_rows; ++row)
-      {
-      out_mem[row] = op_min::direct_min( X, row );
-      }
+    op_min::direct_min_rows( out.memptr(), X );
     }
   }
 
@@ -184,6 +186,47 @@ op_min::direct_min(const Mat<eT>& X, const uword row)
 
 
 
+//! minimum value in each row of X; X is traversed column by column (ie. in storage order), with a buffer holding the current minimum of each row.
+//! blocks of rows are processed by separate threads when OpenMP is enabled.
+template<typename eT>
+inline
+void
+op_min::direct_min_rows(eT* out_mem, const Mat<eT>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword X_n_rows = X.n_rows;
+  const uword X_n_cols = X.n_cols;
+  
+  const uword n_blocks   = mp_gate::n_row_blocks(X_n_rows, X_n_cols);
+  const uword block_rows = (X_n_rows + n_blocks - 1) / n_blocks;
+  
+  arma_omp_pragma(omp parallel for schedule(static) if(n_blocks > 1) num_threads(int(n_blocks)))
+  for(uword block=0; block < n_blocks; ++block)
+    {
+    const uword row_start = (std::min)(block * block_rows, X_n_rows);
+    const uword n_rows    = (std::min)(block_rows, X_n_rows - row_start);
+    
+    eT* out_block = &(out_mem[row_start]);
+    
+    arrayops::inplace_set(out_block, priv::most_pos<eT>(), n_rows);
+    
+    for(uword col=0; col < X_n_cols; ++col)
+      {
+      const eT* X_col = &(X.colptr(col)[row_start]);
+      
+      for(uword i=0; i < n_rows; ++i)
+        {
+        const eT val = X_col[i];
+        
+        if(val < out_block[i]) { out_block[i] = val; }
+        }
+      }
+    }
+  }
+
+
+
 template<typename eT>
 inline
 eT
@@ -415,6 +458,63 @@ op_min::direct_min(const Mat< std::complex<T> >& X, const uword row)
 
 
 
+//! version for complex numbers: the elements with the smallest magnitude are found
+template<typename T>
+inline
+void
+op_min::direct_min_rows(std::complex<T>* out_mem, const Mat< std::complex<T> >& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename std::complex<T> eT;
+  
+  const uword X_n_rows = X.n_rows;
+  const uword X_n_cols = X.n_cols;
+  
+  if(X_n_cols == 0)
+    {
+    return;
+    }
+  
+  const uword n_blocks   = mp_gate::n_row_blocks(X_n_rows, X_n_cols);
+  const uword block_rows = (X_n_rows + n_blocks - 1) / n_blocks;
+  
+  arma_omp_pragma(omp parallel for schedule(static) if(n_blocks > 1) num_threads(int(n_blocks)))
+  for(uword block=0; block < n_blocks; ++block)
+    {
+    const uword row_start = (std::min)(block * block_rows, X_n_rows);
+    const uword n_rows    = (std::min)(block_rows, X_n_rows - row_start);
+    
+    eT* out_block = &(out_mem[row_start]);
+    
+    podarray<T> min_abs(n_rows);
+    
+    T* min_abs_mem = min_abs.memptr();
+    
+    arrayops::inplace_set(min_abs_mem, priv::most_pos<T>(), n_rows);
+    
+    arrayops::copy(out_block, &(X.colptr(0)[row_start]), n_rows);
+    
+    for(uword col=0; col < X_n_cols; ++col)
+      {
+      const eT* X_col = &(X.colptr(col)[row_start]);
+      
+      for(uword i=0; i < n_rows; ++i)
+        {
+        const T tmp_val = std::abs(X_col[i]);
+        
+        if(tmp_val < min_abs_mem[i])
+          {
+          min_abs_mem[i] = tmp_val;
+          out_block[i]   = X_col[i];
+          }
+        }
+      }
+    }
+  }
+
+
+
 template<typename T>
 inline
 std::complex<T>
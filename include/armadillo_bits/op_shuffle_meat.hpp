@@ -35,13 +35,19 @@ op_shuffle::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_shuffle>& in)
   const uword dim = in.aux_uword_a;
   const uword N   = (dim == 0) ? X.n_rows : X.n_cols;
   
+  // the sort keys are generated in the same way as randu(),
+  // so that the permutation depends only on the seed (see arma_rng)
+  podarray<double> keys(N);
+  
+  arma_rng::randu<double>::fill(keys.memptr(), N);
+  
   // see "fn_sort_index.hpp" for the definition of "arma_sort_index_packet_ascend"
   // and the associated "operator<"
-  std::vector< arma_sort_index_packet_ascend<int,uword> > packet_vec(N);
+  std::vector< arma_sort_index_packet_ascend<double,uword> > packet_vec(N);
   
   for(uword i=0; i<N; ++i)
     {
-    packet_vec[i].val   = std::rand();
+    packet_vec[i].val   = keys[i];
     packet_vec[i].index = i;
     }
   
@@ -29,6 +29,33 @@ class op_sort
   template<typename eT>
   inline static void direct_sort(eT* X, const uword N, const uword sort_type = 0);
   
+  template<typename eT, typename comparator_type>
+  inline static void generic_sort(eT* X, const uword N, const comparator_type& comparator);
+  
+  template<typename eT, typename comparator_type>
+  inline static void mp_sort(eT* X, const uword N, const comparator_type& comparator);
+  
+  template<typename eT, typename comparator_type>
+  inline static void serial_sort(eT* X, const uword N, const comparator_type& comparator);
+  
+  template<typename eT>
+  inline static void serial_sort(eT* X, const uword N, const arma_ascend_sort_helper<eT>& comparator);
+  
+  template<typename eT>
+  inline static void serial_sort(eT* X, const uword N, const arma_descend_sort_helper<eT>& comparator);
+  
+  template<typename T1, typename T2>
+  inline static void serial_sort(arma_sort_index_packet_ascend<T1,T2>* X, const uword N, const std::less< arma_sort_index_packet_ascend<T1,T2> >& comparator);
+  
+  template<typename T1, typename T2>
+  inline static void serial_sort(arma_sort_index_packet_descend<T1,T2>* X, const uword N, const std::less< arma_sort_index_packet_descend<T1,T2> >& comparator);
+  
+  template<typename eT, typename key_functor>
+  inline static void radix_sort(eT* X, const uword N, const key_functor& get_key);
+  
+  //! minimum number of elements for which radix sort is used instead of std::sort()
+  static const uword radix_threshold = 4096;
+  
   template<typename T1>
   inline static void apply(Mat<typename T1::elem_type>& out, const Op<T1,op_sort>& in);
   };
@@ -80,6 +80,216 @@ class arma_descend_sort_helper< std::complex<T> >
 
 
 
+//! \brief
+//! maps an element to an unsigned integer (key), such that the order of the keys matches the order of the elements;
+//! only defined for types which can be radix sorted (supported = true)
+template<typename eT>
+struct arma_radix_key
+  {
+  static const bool supported = false;
+  
+  typedef u32 key_type;
+  
+  arma_inline static key_type encode(const eT&) { return key_type(0); }
+  };
+
+
+
+template<>
+struct arma_radix_key<u8>
+  {
+  static const bool supported = true;
+  
+  typedef u32 key_type;
+  
+  arma_inline static key_type encode(const u8 x) { return key_type(x); }
+  };
+
+
+
+template<>
+struct arma_radix_key<s8>
+  {
+  static const bool supported = true;
+  
+  typedef u32 key_type;
+  
+  arma_inline static key_type encode(const s8 x) { return key_type(u8(x) ^ u8(0x80)); }
+  };
+
+
+
+template<>
+struct arma_radix_key<u16>
+  {
+  static const bool supported = true;
+  
+  typedef u32 key_type;
+  
+  arma_inline static key_type encode(const u16 x) { return key_type(x); }
+  };
+
+
+
+template<>
+struct arma_radix_key<s16>
+  {
+  static const bool supported = true;
+  
+  typedef u32 key_type;
+  
+  arma_inline static key_type encode(const s16 x) { return key_type(u16(x) ^ u16(0x8000)); }
+  };
+
+
+
+template<>
+struct arma_radix_key<u32>
+  {
+  static const bool supported = true;
+  
+  typedef u32 key_type;
+  
+  arma_inline static key_type encode(const u32 x) { return x; }
+  };
+
+
+
+template<>
+struct arma_radix_key<s32>
+  {
+  static const bool supported = true;
+  
+  typedef u32 key_type;
+  
+  arma_inline static key_type encode(const s32 x) { return ( u32(x) ^ u32(0x80000000) ); }
+  };
+
+
+
+#if defined(ARMA_64BIT_WORD)
+
+template<>
+struct arma_radix_key<u64>
+  {
+  static const bool supported = true;
+  
+  typedef u64 key_type;
+  
+  arma_inline static key_type encode(const u64 x) { return x; }
+  };
+
+
+
+template<>
+struct arma_radix_key<s64>
+  {
+  static const bool supported = true;
+  
+  typedef u64 key_type;
+  
+  arma_inline static key_type encode(const s64 x) { return ( u64(x) ^ (u64(1) << 63) ); }
+  };
+
+#endif
+
+
+
+//! the sign bit of a float is flipped if the number is positive; all bits are flipped if it is negative
+template<>
+struct arma_radix_key<float>
+  {
+  static const bool supported = true;
+  
+  typedef u32 key_type;
+  
+  arma_inline
+  static
+  key_type
+  encode(const float x)
+    {
+    key_type bits;
+    std::memcpy(&bits, &x, sizeof(float));
+    
+    const key_type sign_bit = key_type(1) << 31;
+    
+    return (bits & sign_bit) ? key_type(~bits) : key_type(bits | sign_bit);
+    }
+  };
+
+
+
+template<>
+struct arma_radix_key<double>
+  {
+  static const bool supported = true;
+  
+  #if ULONG_MAX >= 0xffffffffffffffff
+    typedef unsigned long      key_type;
+  #else
+    typedef unsigned long long key_type;
+  #endif
+  
+  arma_inline
+  static
+  key_type
+  encode(const double x)
+    {
+    key_type bits;
+    std::memcpy(&bits, &x, sizeof(double));
+    
+    const key_type sign_bit = key_type(1) << 63;
+    
+    return (bits & sign_bit) ? key_type(~bits) : key_type(bits | sign_bit);
+    }
+  };
+
+
+
+//! radix sort key of a value to be sorted in ascending or descending order
+template<typename eT, bool descend>
+class arma_radix_value_key
+  {
+  public:
+  
+  typedef typename arma_radix_key<eT>::key_type key_type;
+  
+  static const uword n_bytes = sizeof(eT);
+  
+  arma_inline
+  key_type
+  operator() (const eT& x) const
+    {
+    const key_type key = arma_radix_key<eT>::encode(x);
+    
+    return (descend) ? key_type(~key) : key;
+    }
+  };
+
+
+
+//! radix sort key of a packet used by sort_index(), based on the value held in the packet
+template<typename packet_type, typename eT, bool descend>
+class arma_radix_packet_key
+  {
+  public:
+  
+  typedef typename arma_radix_key<eT>::key_type key_type;
+  
+  static const uword n_bytes = sizeof(eT);
+  
+  arma_inline
+  key_type
+  operator() (const packet_type& x) const
+    {
+    const key_type key = arma_radix_key<eT>::encode(x.val);
+    
+    return (descend) ? key_type(~key) : key;
+    }
+  };
+
+
+
 template<typename eT>
 inline 
 void
@@ -91,13 +301,278 @@ op_sort::direct_sort(eT* X, const uword n_elem, const uword sort_type)
     {
     arma_ascend_sort_helper<eT> comparator;
     
-    std::sort(&X[0], &X[n_elem], comparator);
+    op_sort::generic_sort(X, n_elem, comparator);
     }
   else
     {
     arma_descend_sort_helper<eT> comparator;
     
+    op_sort::generic_sort(X, n_elem, comparator);
+    }
+  }
+
+
+
+//! sort an array with serial_sort(), or with mp_sort() if the array is large enough
+template<typename eT, typename comparator_type>
+inline
+void
+op_sort::generic_sort(eT* X, const uword n_elem, const comparator_type& comparator)
+  {
+  if( mp_gate::eval(n_elem) )
+    {
+    op_sort::mp_sort(X, n_elem, comparator);
+    }
+  else
+    {
+    op_sort::serial_sort(X, n_elem, comparator);
+    }
+  }
+
+
+
+//! sort an array in one thread.
+//! the overloads below use radix sort for elements that support it, when the ordering is known
+template<typename eT, typename comparator_type>
+inline
+void
+op_sort::serial_sort(eT* X, const uword n_elem, const comparator_type& comparator)
+  {
+  std::sort(&X[0], &X[n_elem], comparator);
+  }
+
+
+
+template<typename eT>
+inline
+void
+op_sort::serial_sort(eT* X, const uword n_elem, const arma_ascend_sort_helper<eT>& comparator)
+  {
+  if( (arma_radix_key<eT>::supported == true) && (n_elem >= radix_threshold) )
+    {
+    op_sort::radix_sort(X, n_elem, arma_radix_value_key<eT,false>());
+    }
+  else
+    {
+    std::sort(&X[0], &X[n_elem], comparator);
+    }
+  }
+
+
+
+template<typename eT>
+inline
+void
+op_sort::serial_sort(eT* X, const uword n_elem, const arma_descend_sort_helper<eT>& comparator)
+  {
+  if( (arma_radix_key<eT>::supported == true) && (n_elem >= radix_threshold) )
+    {
+    op_sort::radix_sort(X, n_elem, arma_radix_value_key<eT,true>());
+    }
+  else
+    {
+    std::sort(&X[0], &X[n_elem], comparator);
+    }
+  }
+
+
+
+template<typename T1, typename T2>
+inline
+void
+op_sort::serial_sort(arma_sort_index_packet_ascend<T1,T2>* X, const uword n_elem, const std::less< arma_sort_index_packet_ascend<T1,T2> >& comparator)
+  {
+  typedef arma_sort_index_packet_ascend<T1,T2> packet_type;
+  
+  if( (arma_radix_key<T1>::supported == true) && (n_elem >= radix_threshold) )
+    {
+    op_sort::radix_sort(X, n_elem, arma_radix_packet_key<packet_type,T1,false>());
+    }
+  else
+    {
+    std::sort(&X[0], &X[n_elem], comparator);
+    }
+  }
+
+
+
+template<typename T1, typename T2>
+inline
+void
+op_sort::serial_sort(arma_sort_index_packet_descend<T1,T2>* X, const uword n_elem, const std::less< arma_sort_index_packet_descend<T1,T2> >& comparator)
+  {
+  typedef arma_sort_index_packet_descend<T1,T2> packet_type;
+  
+  if( (arma_radix_key<T1>::supported == true) && (n_elem >= radix_threshold) )
+    {
+    op_sort::radix_sort(X, n_elem, arma_radix_packet_key<packet_type,T1,true>());
+    }
+  else
+    {
+    std::sort(&X[0], &X[n_elem], comparator);
+    }
+  }
+
+
+
+//! Least significant digit radix sort, using 11 bit digits.
+//! The key of each element is obtained via key_functor, and is an unsigned integer whose order matches the required order of the elements.
+//! The elements are moved between X and a buffer once for each digit;
+//! digits which are the same for all elements are skipped.
+//! The sort is stable.
+template<typename eT, typename key_functor>
+inline
+void
+op_sort::radix_sort(eT* X, const uword n_elem, const key_functor& get_key)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename key_functor::key_type key_type;
+  
+  const uword n_bits    = 11;
+  const uword n_buckets = uword(1) << n_bits;
+  const uword n_digits  = (8*key_functor::n_bytes + n_bits - 1) / n_bits;
+  
+  const key_type mask = key_type(n_buckets - 1);
+  
+  podarray<uword> counts(n_digits * n_buckets);
+  
+  counts.zeros();
+  
+  uword* counts_mem = counts.memptr();
+  
+  for(uword i=0; i < n_elem; ++i)
+    {
+    const key_type key = get_key(X[i]);
+    
+    for(uword digit=0; digit < n_digits; ++digit)
+      {
+      counts_mem[digit*n_buckets + uword( (key >> (n_bits*digit)) & mask )]++;
+      }
+    }
+  
+  podarray<eT> buffer(n_elem);
+  
+  eT* src = X;
+  eT* dst = buffer.memptr();
+  
+  for(uword digit=0; digit < n_digits; ++digit)
+    {
+    uword* pos = &counts_mem[digit*n_buckets];
+    
+    const uword shift = n_bits*digit;
+    
+    if( pos[ uword( (get_key(src[0]) >> shift) & mask ) ] == n_elem )
+      {
+      continue;
+      }
+    
+    // convert the counts to the starting positions of the buckets
+    uword sum = 0;
+    
+    for(uword bucket=0; bucket < n_buckets; ++bucket)
+      {
+      const uword count = pos[bucket];
+      
+      pos[bucket] = sum;
+      sum        += count;
+      }
+    
+    for(uword i=0; i < n_elem; ++i)
+      {
+      const uword bucket = uword( (get_key(src[i]) >> shift) & mask );
+      
+      dst[ pos[bucket] ] = src[i];
+      
+      pos[bucket]++;
+      }
+    
+    std::swap(src, dst);
+    }
+  
+  if(src != X)
+    {
+    arrayops::copy(X, src, n_elem);
+    }
+  }
+
+
+
+//! Sort an array using several threads.
+//! The array is split into one part per thread, the parts are sorted concurrently,
+//! and then pairs of sorted parts are merged until one sorted array remains.
+//! Each merge of two parts is split into several independent sub-merges,
+//! so that all threads are kept busy in the last rounds.
+template<typename eT, typename comparator_type>
+inline
+void
+op_sort::mp_sort(eT* X, const uword n_elem, const comparator_type& comparator)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword n_parts = (std::min)( uword(mp_gate::n_threads()), n_elem );
+  
+  if(n_parts <= 1)
+    {
     std::sort(&X[0], &X[n_elem], comparator);
+    return;
+    }
+  
+  podarray<uword> bounds(n_parts + 1);
+  
+  const uword part_len  = n_elem / n_parts;
+  const uword part_left = n_elem % n_parts;
+  
+  for(uword i=0; i <= n_parts; ++i)
+    {
+    bounds[i] = i*part_len + (std::min)(i, part_left);
+    }
+  
+  arma_omp_pragma(omp parallel for schedule(static) num_threads(int(n_parts)))
+  for(uword i=0; i < n_parts; ++i)
+    {
+    op_sort::serial_sort(&X[bounds[i]], bounds[i+1] - bounds[i], comparator);
+    }
+  
+  podarray<eT> buffer(n_elem);
+  
+  eT* src = X;
+  eT* dst = buffer.memptr();
+  
+  for(uword width=1; width < n_parts; width *= 2)
+    {
+    const uword n_merges = (n_parts + 2*width - 1) / (2*width);
+    const uword n_splits = (std::max)( uword(1), n_parts / n_merges );
+    
+    arma_omp_pragma(omp parallel for schedule(static) num_threads(int(n_parts)))
+    for(uword task=0; task < n_merges*n_splits; ++task)
+      {
+      const uword i = (task / n_splits) * 2 * width;
+      const uword j = (task % n_splits);
+      
+      const uword start = bounds[i];
+      const uword mid   = bounds[(std::min)(i +   width, n_parts)];
+      const uword end   = bounds[(std::min)(i + 2*width, n_parts)];
+      
+      // the elements of the first part are split evenly;
+      // the second part is split at the first element not preceding the corresponding split element of the first part
+      const double n_a = double(mid - start);
+      
+      const uword a_lo = start + uword( (n_a * double(j    )) / double(n_splits) );
+      const uword a_hi = start + uword( (n_a * double(j + 1)) / double(n_splits) );
+      
+      const uword b_lo = (j == 0)    ? mid : ( (a_lo == mid) ? end : uword(std::lower_bound(&src[mid], &src[end], src[a_lo], comparator) - src) );
+      const uword b_hi = (a_hi == mid) ? end : uword(std::lower_bound(&src[mid], &src[end], src[a_hi], comparator) - src);
+      
+      std::merge(&src[a_lo], &src[a_hi], &src[b_lo], &src[b_hi], &dst[a_lo + (b_lo - mid)], comparator);
+      }
+    
+    std::swap(src, dst);
+    }
+  
+  if(src != X)
+    {
+    arrayops::copy(X, src, n_elem);
     }
   }
 
@@ -183,13 +658,19 @@ op_sort::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_sort>& in)
     
     const uword n_rows = out.n_rows;
     const uword n_cols = out.n_cols;
-      
+    
+    // the columns are sorted concurrently if there are enough of them; otherwise each column may be sorted by several threads
+    const bool use_mp = (n_cols >= uword(mp_gate::n_threads())) && mp_gate::eval(out.n_elem);
+    
+    arma_omp_pragma(omp parallel for schedule(dynamic) if(use_mp))
     for(uword col=0; col < n_cols; ++col)
       {
       op_sort::direct_sort( out.colptr(col), n_rows, sort_type );
       }
+    
+    arma_ignore(use_mp);
     }
-  else
+else
   if(dim == 1)  // sort the contents of each row
     {
     if(X.n_rows == 1)  // a row vector
@@ -208,18 +689,26 @@ op_sort::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_sort>& in)
       const uword n_rows = out.n_rows;
       const uword n_cols = out.n_cols;
       
-      podarray<eT> tmp_array(n_cols);
+      const bool use_mp = (n_rows >= uword(mp_gate::n_threads())) && mp_gate::eval(out.n_elem);
       
-      for(uword row=0; row < n_rows; ++row)
+      arma_omp_pragma(omp parallel if(use_mp))
         {
-        op_sort::copy_row(tmp_array.memptr(), X, row);
-        
-        op_sort::direct_sort( tmp_array.memptr(), n_cols, sort_type );
+        podarray<eT> tmp_array(n_cols);
         
-        op_sort::copy_row(out, tmp_array.memptr(), row);
+        arma_omp_pragma(omp for schedule(dynamic))
+        for(uword row=0; row < n_rows; ++row)
+          {
+          op_sort::copy_row(tmp_array.memptr(), X, row);
+          
+          op_sort::direct_sort( tmp_array.memptr(), n_cols, sort_type );
+          
+          op_sort::copy_row(out, tmp_array.memptr(), row);
+          }
         }
+      
+      arma_ignore(use_mp);
       }
-    }
+}
   
   }
 
@@ -51,10 +51,17 @@ op_stddev::apply(Mat<typename T1::pod_type>& out, const mtOp<typename T1::pod_ty
     
     out_eT* out_mem = out.memptr();
     
+    const bool use_mp    = mp_gate::eval(X.n_elem);
+    const int  n_threads = mp_gate::n_threads();
+    
+    arma_omp_pragma(omp parallel for schedule(static) if(use_mp) num_threads(n_threads))
     for(uword col=0; col<X_n_cols; ++col)
       {
       out_mem[col] = std::sqrt( op_var::direct_var( X.colptr(col), X_n_rows, norm_type ) );
       }
+    
+    arma_ignore(use_mp);
+    arma_ignore(n_threads);
     }
   else
   if(dim == 1)
@@ -65,16 +72,13 @@ op_stddev::apply(Mat<typename T1::pod_type>& out, const mtOp<typename T1::pod_ty
 
     out.set_size(X_n_rows, 1);
     
-    podarray<in_eT> dat(X_n_cols);
-    
-    in_eT*  dat_mem = dat.memptr();
     out_eT* out_mem = out.memptr();
     
+    op_var::direct_var_rows( out_mem, X, norm_type );
+    
     for(uword row=0; row<X_n_rows; ++row)
       {
-      dat.copy_row(X, row);
-      
-      out_mem[row] = std::sqrt( op_var::direct_var( dat_mem, X_n_cols, norm_type) );
+      out_mem[row] = std::sqrt( out_mem[row] );
       }
     }
   }
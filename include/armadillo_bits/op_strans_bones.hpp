@@ -29,12 +29,32 @@ class op_strans
     static const uword n4 = (do_flip == false) ? (row + col*4) : (col + row*4);
     };
   
+  static const uword block_size         = 64;       //!< size of the square tiles used for transposing large matrices
+  static const uword large_min_size     = 256;      //!< matrices with at least this many rows and columns are transposed tile by tile
+  static const uword inplace_min_n_elem = 16777216; //!< aliased non-square matrices with at least this many elements are transposed in place
+  static const uword lowmem_band        = 128;      //!< maximum number of rows processed together by apply_inplace_lowmem()
+  
   template<typename eT>
   arma_hot inline static void apply_noalias_tinysq(Mat<eT>& out, const Mat<eT>& A);
   
+  template<typename eT>
+  arma_hot inline static void block_worker(eT* Y, const eT* X, const uword X_n_rows, const uword Y_n_rows, const uword n_rows, const uword n_cols);
+  
+  template<typename eT>
+  arma_hot inline static void apply_noalias_large(Mat<eT>& out, const Mat<eT>& A);
+  
   template<typename eT>
   arma_hot inline static void apply_noalias(Mat<eT>& out, const Mat<eT>& A);
   
+  template<typename eT>
+  arma_hot inline static void apply_inplace_square(Mat<eT>& X);
+  
+  template<typename eT>
+  inline static void apply_inplace_lowmem(Mat<eT>& X);
+  
+  template<typename eT>
+  arma_hot inline static bool use_inplace_lowmem(const Mat<eT>& X);
+  
   template<typename eT>
   arma_hot inline static void apply(Mat<eT>& out, const Mat<eT>& A);
   
@@ -92,6 +92,71 @@ op_strans::apply_noalias_tinysq(Mat<eT>& out, const Mat<eT>& A)
 
 
 
+//! transpose a block of size n_rows x n_cols, stored in X with column stride X_n_rows,
+//! into Y with column stride Y_n_rows
+template<typename eT>
+arma_hot
+inline
+void
+op_strans::block_worker(eT* Y, const eT* X, const uword X_n_rows, const uword Y_n_rows, const uword n_rows, const uword n_cols)
+  {
+  for(uword row=0; row < n_rows; ++row)
+    {
+    const eT* X_row = &X[row];
+          eT* Y_col = &Y[row * Y_n_rows];
+    
+    for(uword col=0; col < n_cols; ++col)
+      {
+      Y_col[col] = X_row[col * X_n_rows];
+      }
+    }
+  }
+
+
+
+//! tiled transpose for matrices which don't fit in the cache:
+//! each block_size x block_size tile of A is read and written while it's still in the cache.
+//! out must already have the size of the transposed matrix.
+template<typename eT>
+arma_hot
+inline
+void
+op_strans::apply_noalias_large(Mat<eT>& out, const Mat<eT>& A)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword A_n_rows = A.n_rows;
+  const uword A_n_cols = A.n_cols;
+  
+  const uword B        = op_strans::block_size;
+  const uword n_blocks = (A_n_cols + B - 1) / B;
+  
+  const eT* A_mem   = A.memptr();
+        eT* out_mem = out.memptr();
+  
+  const bool use_mp    = mp_gate::eval(A.n_elem);
+  const int  n_threads = mp_gate::n_threads();
+  
+  arma_omp_pragma(omp parallel for schedule(static) if(use_mp) num_threads(n_threads))
+  for(uword block=0; block < n_blocks; ++block)
+    {
+    const uword col    = block * B;
+    const uword n_cols = (std::min)(B, A_n_cols - col);
+    
+    for(uword row=0; row < A_n_rows; row += B)
+      {
+      const uword n_rows = (std::min)(B, A_n_rows - row);
+      
+      op_strans::block_worker( &(out_mem[col + row*A_n_cols]), &(A_mem[row + col*A_n_rows]), A_n_rows, A_n_cols, n_rows, n_cols );
+      }
+    }
+  
+  arma_ignore(use_mp);
+  arma_ignore(n_threads);
+  }
+
+
+
 //! Immediate transpose of a dense matrix
 template<typename eT>
 arma_hot
@@ -116,6 +181,11 @@ op_strans::apply_noalias(Mat<eT>& out, const Mat<eT>& A)
       {
       op_strans::apply_noalias_tinysq(out, A);
       }
+    else
+    if( (A_n_rows >= op_strans::large_min_size) && (A_n_cols >= op_strans::large_min_size) )
+      {
+      op_strans::apply_noalias_large(out, A);
+      }
     else
       {
       for(uword k=0; k < A_n_cols; ++k)
@@ -144,6 +214,232 @@ op_strans::apply_noalias(Mat<eT>& out, const Mat<eT>& A)
 
 
 
+//! in-place transpose of a square matrix;
+//! tiles below the diagonal are swapped with their mirror tiles above the diagonal
+template<typename eT>
+arma_hot
+inline
+void
+op_strans::apply_inplace_square(Mat<eT>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword N = X.n_rows;
+  const uword B = op_strans::block_size;
+  
+  const uword n_blocks = (N + B - 1) / B;
+  
+  eT* X_mem = X.memptr();
+  
+  const bool use_mp    = mp_gate::eval(X.n_elem);
+  const int  n_threads = mp_gate::n_threads();
+  
+  // block column b holds the tiles on and below the diagonal; their mirror tiles are in block row b,
+  // so each iteration touches a separate set of elements
+  arma_omp_pragma(omp parallel for schedule(dynamic) if(use_mp) num_threads(n_threads))
+  for(uword block=0; block < n_blocks; ++block)
+    {
+    const uword col_start = block * B;
+    const uword col_end   = (std::min)(col_start + B, N);
+    
+    for(uword row_start = col_start; row_start < N; row_start += B)
+      {
+      const uword row_end = (std::min)(row_start + B, N);
+      
+      for(uword col = col_start; col < col_end; ++col)
+        {
+        eT* colptr = &(X_mem[col * N]);
+        
+        const uword row_first = (row_start == col_start) ? (col + 1) : row_start;
+        
+        for(uword row = row_first; row < row_end; ++row)
+          {
+          std::swap(colptr[row], X_mem[col + row*N]);
+          }
+        }
+      }
+    }
+  
+  arma_ignore(use_mp);
+  arma_ignore(n_threads);
+  }
+
+
+
+//! in-place transpose of a non-square matrix, with scratch memory proportional to n_rows + n_cols.
+//! uses the decomposition by Catanzaro, Keller and Garland (2014):
+//! viewing the memory as a row-major m x n array (m = n_cols, n = n_rows),
+//! the transpose is a rotation of each array column, followed by a permutation within each array row,
+//! followed by a permutation within each array column.
+//! array rows are the columns of X; array columns are the rows of X, which are processed in bands of up to lowmem_band rows.
+template<typename eT>
+inline
+void
+op_strans::apply_inplace_lowmem(Mat<eT>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword m = X.n_cols;
+  const uword n = X.n_rows;
+  
+  X.set_size(m, n);
+  
+  if( (m == 1) || (n == 1) || (X.n_elem == 0) )
+    {
+    return;
+    }
+  
+  // rows are processed in bands, with the band size limited so that the scratch memory is at most 1/16 of the matrix
+  const uword band = (std::max)( uword(1), (std::min)( uword(op_strans::lowmem_band), uword(n / 16) ) );
+  
+  uword c = m;
+  uword r = n;
+  
+  while(r != 0)
+    {
+    const uword tmp = c % r;
+    
+    c = r;
+    r = tmp;
+    }
+  
+  const uword a = m / c;
+  const uword b = n / c;
+  
+  podarray<eT> W( (std::max)(band*m, n) );
+  
+  eT* W_mem = W.memptr();
+  eT* X_mem = X.memptr();
+  
+  // step 1: rotate array column j by j/b positions
+  
+  if(c > 1)
+    {
+    uword shift[op_strans::lowmem_band];
+    
+    for(uword j_start=0; j_start < n; j_start += band)
+      {
+      const uword n_band = (std::min)(band, n - j_start);
+      
+      for(uword jj=0; jj < n_band; ++jj)
+        {
+        shift[jj] = (j_start + jj) / b;
+        }
+      
+      for(uword i=0; i < m; ++i)
+        {
+        eT* W_row = &(W_mem[i*band]);
+        
+        for(uword jj=0; jj < n_band; ++jj)
+          {
+          const uword src = i + shift[jj];
+          
+          W_row[jj] = X_mem[ (j_start + jj) + ( (src < m) ? src : (src - m) ) * n ];
+          }
+        }
+      
+      for(uword i=0; i < m; ++i)
+        {
+        arrayops::copy( &(X_mem[j_start + i*n]), &(W_mem[i*band]), n_band );
+        }
+      }
+    }
+  
+  // step 2: scatter each array row, sending element j to ((i + j/b) mod m + j*m) mod n
+  
+  const uword m_mod_n = m % n;
+  
+  for(uword i=0; i < m; ++i)
+    {
+    eT* X_col = &(X_mem[i*n]);
+    
+    uword jm    = 0;      // (j*m) mod n
+    uword rot_m = i;      // (i + j/b) mod m
+    uword rot_n = i % n;  // rot_m mod n
+    
+    for(uword j_start=0; j_start < n; j_start += b)
+      {
+      const uword j_end = j_start + b;
+      
+      for(uword j=j_start; j < j_end; ++j)
+        {
+        const uword dest = rot_n + jm;
+        
+        W_mem[ (dest < n) ? dest : (dest - n) ] = X_col[j];
+        
+        jm += m_mod_n;
+        jm  = (jm < n) ? jm : (jm - n);
+        }
+      
+      ++rot_m;
+      ++rot_n;
+      
+      if(rot_m == m)  { rot_m = 0; rot_n = 0; }
+      if(rot_n == n)  { rot_n = 0;            }
+      }
+    
+    arrayops::copy( X_col, W_mem, n );
+    }
+  
+  // step 3: gather each array column, taking element i from (j + i*n - i/a) mod m
+  
+  const uword n_mod_m = n % m;
+  
+  for(uword j_start=0; j_start < n; j_start += band)
+    {
+    const uword n_band = (std::min)(band, n - j_start);
+    
+    uword s       = j_start % m;
+    uword i_mod_a = 0;
+    
+    for(uword i=0; i < m; ++i)
+      {
+      eT* W_row = &(W_mem[i*band]);
+      
+      uword src = s;
+      
+      for(uword jj=0; jj < n_band; ++jj)
+        {
+        W_row[jj] = X_mem[ (j_start + jj) + src*n ];
+        
+        ++src;
+        src = (src < m) ? src : 0;
+        }
+      
+      s += n_mod_m;
+      s  = (s < m) ? s : (s - m);
+      
+      ++i_mod_a;
+      
+      if(i_mod_a == a)
+        {
+        i_mod_a = 0;
+        s       = (s > 0) ? (s - 1) : (m - 1);
+        }
+      }
+    
+    for(uword i=0; i < m; ++i)
+      {
+      arrayops::copy( &(X_mem[j_start + i*n]), &(W_mem[i*band]), n_band );
+      }
+    }
+  }
+
+
+
+//! true if an aliased transpose of X should use apply_inplace_lowmem():
+//! X must be large enough for the saved memory to matter, and its size must be changeable
+template<typename eT>
+arma_hot
+inline
+bool
+op_strans::use_inplace_lowmem(const Mat<eT>& X)
+  {
+  return ( (X.n_elem >= op_strans::inplace_min_n_elem) && (X.vec_state == 0) && (X.mem_state <= 1) );
+  }
+
+
+
 template<typename eT>
 arma_hot
 inline
@@ -165,25 +461,14 @@ op_strans::apply(Mat<eT>& out, const Mat<eT>& A)
       {
       arma_extra_debug_print("op_strans::apply(): doing in-place transpose of a square matrix");
       
-      const uword N = n_rows;
+      op_strans::apply_inplace_square(out);
+      }
+    else
+    if(op_strans::use_inplace_lowmem(out) == true)
+      {
+      arma_extra_debug_print("op_strans::apply(): doing in-place transpose of a non-square matrix");
       
-      for(uword k=0; k < N; ++k)
-        {
-        eT* colptr = out.colptr(k);
-        
-        uword i,j;
-        
-        for(i=(k+1), j=(k+2); j < N; i+=2, j+=2)
-          {
-          std::swap(out.at(k,i), colptr[i]);
-          std::swap(out.at(k,j), colptr[j]);
-          }
-        
-        if(i < N)
-          {
-          std::swap(out.at(k,i), colptr[i]);
-          }
-        }
+      op_strans::apply_inplace_lowmem(out);
       }
     else
       {
@@ -469,6 +754,13 @@ op_strans2::apply_noalias(Mat<eT>& out, const Mat<eT>& A, const eT val)
       {
       op_strans2::apply_noalias_tinysq(out, A, val);
       }
+    else
+    if( (A_n_rows >= op_strans::large_min_size) && (A_n_cols >= op_strans::large_min_size) )
+      {
+      op_strans::apply_noalias_large(out, A);
+      
+      arrayops::inplace_mul( out.memptr(), val, out.n_elem );
+      }
     else
       {
       for(uword k=0; k < A_n_cols; ++k)
@@ -518,27 +810,18 @@ op_strans2::apply(Mat<eT>& out, const Mat<eT>& A, const eT val)
       {
       arma_extra_debug_print("op_strans2::apply(): doing in-place transpose of a square matrix");
       
-      const uword N = n_rows;
-      
       // TODO: do multiplication while swapping
       
-      for(uword k=0; k < N; ++k)
-        {
-        eT* colptr = out.colptr(k);
-        
-        uword i,j;
-        
-        for(i=(k+1), j=(k+2); j < N; i+=2, j+=2)
-          {
-          std::swap(out.at(k,i), colptr[i]);
-          std::swap(out.at(k,j), colptr[j]);
-          }
-        
-        if(i < N)
-          {
-          std::swap(out.at(k,i), colptr[i]);
-          }
-        }
+      op_strans::apply_inplace_square(out);
+      
+      arrayops::inplace_mul( out.memptr(), val, out.n_elem );
+      }
+    else
+    if(op_strans::use_inplace_lowmem(out) == true)
+      {
+      arma_extra_debug_print("op_strans2::apply(): doing in-place transpose of a non-square matrix");
+      
+      op_strans::apply_inplace_lowmem(out);
       
       arrayops::inplace_mul( out.memptr(), val, out.n_elem );
       }
@@ -21,6 +21,9 @@ class op_sum
   
   template<typename T1>
   arma_hot inline static void apply(Mat<typename T1::elem_type>& out, const Op<T1, op_sum>& in);
+  
+  template<typename eT>
+  arma_hot inline static void direct_sum_rows(eT* out_mem, const Mat<eT>& X);
   };
 
 
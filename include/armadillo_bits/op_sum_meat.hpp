@@ -50,35 +50,23 @@ op_sum::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_sum>& in)
       
       eT* out_mem = out.memptr();
       
+      const bool use_mp    = mp_gate::eval(X.n_elem);
+      const int  n_threads = mp_gate::n_threads();
+      
+      arma_omp_pragma(omp parallel for schedule(static) if(use_mp) num_threads(n_threads))
       for(uword col=0; col < X_n_cols; ++col)
         {
         out_mem[col] = arrayops::accumulate( X.colptr(col), X_n_rows );
         }
+      
+      arma_ignore(use_mp);
+      arma_ignore(n_threads);
       }
     else  // traverse across columns (i.e. find the sum in each row)
       {
       out.set_size(X_n_rows, 1);
       
-      eT* out_mem = out.memptr();
-        
-      for(uword row=0; row < X_n_rows; ++row)
-        {
-        eT val = eT(0);
-        
-        uword i,j;
-        for(i=0, j=1; j < X_n_cols; i+=2, j+=2)
-          {
-          val += X.at(row,i);
-          val += X.at(row,j);
-          }
-        
-        if(i < X_n_cols)
-          {
-          val += X.at(row,i);
-          }
-        
-        out_mem[row] = val;
-        }
+      op_sum::direct_sum_rows(out.memptr(), X);
       }
     }
   else
@@ -92,6 +80,10 @@ op_sum::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_sum>& in)
       
       eT* out_mem = out.memptr();
       
+      const bool use_mp    = mp_gate::eval(P.get_n_elem());
+      const int  n_threads = mp_gate::n_threads();
+      
+      arma_omp_pragma(omp parallel for schedule(static) if(use_mp) num_threads(n_threads))
       for(uword col=0; col < P_n_cols; ++col)
         {
         eT val = eT(0);
@@ -110,30 +102,23 @@ op_sum::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_sum>& in)
         
         out_mem[col] = val;
         }
+      
+      arma_ignore(use_mp);
+      arma_ignore(n_threads);
       }
     else  // traverse across columns (i.e. find the sum in each row)
       {
-      out.set_size(P_n_rows, 1);
+      out.zeros(P_n_rows, 1);
       
       eT* out_mem = out.memptr();
       
-      for(uword row=0; row < P_n_rows; ++row)
+      // accumulate column by column, so that the elements are accessed in storage order
+      for(uword col=0; col < P_n_cols; ++col)
         {
-        eT val = eT(0);
-        
-        uword i,j;
-        for(i=0, j=1; j < P_n_cols; i+=2, j+=2)
-          {
-          val += P.at(row,i);
-          val += P.at(row,j);
-          }
-        
-        if(i < P_n_cols)
+        for(uword row=0; row < P_n_rows; ++row)
           {
-          val += P.at(row,i);
+          out_mem[row] += P.at(row,col);
           }
-        
-        out_mem[row] = val;
         }
       }
     }
@@ -141,4 +126,40 @@ op_sum::apply(Mat<typename T1::elem_type>& out, const Op<T1,op_sum>& in)
 
 
 
+//! sum of each row of X, accumulated column by column into out_mem, so that X is accessed in storage order.
+//! blocks of rows are processed by separate threads when OpenMP is enabled;
+//! the order of additions for each row doesn't depend on the number of threads.
+template<typename eT>
+arma_hot
+inline
+void
+op_sum::direct_sum_rows(eT* out_mem, const Mat<eT>& X)
+  {
+  arma_extra_debug_sigprint();
+  
+  const uword X_n_rows = X.n_rows;
+  const uword X_n_cols = X.n_cols;
+  
+  const uword n_blocks   = mp_gate::n_row_blocks(X_n_rows, X_n_cols);
+  const uword block_rows = (X_n_rows + n_blocks - 1) / n_blocks;
+  
+  arma_omp_pragma(omp parallel for schedule(static) if(n_blocks > 1) num_threads(int(n_blocks)))
+  for(uword block=0; block < n_blocks; ++block)
+    {
+    const uword row_start = (std::min)(block * block_rows, X_n_rows);
+    const uword n_rows    = (std::min)(block_rows, X_n_rows - row_start);
+    
+    eT* out_block = &(out_mem[row_start]);
+    
+    arrayops::inplace_set(out_block, eT(0), n_rows);
+    
+    for(uword col=0; col < X_n_cols; ++col)
+      {
+      arrayops::inplace_plus(out_block, &(X.colptr(col)[row_start]), n_rows);
+      }
+    }
+  }
+
+
+
 //! @}
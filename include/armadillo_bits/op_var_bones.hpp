@@ -53,6 +53,46 @@ class op_var
   
   template<typename T>
   inline static  T direct_var_robust(const std::complex<T>* const X, const uword N, const uword norm_type = 0);
+  
+  
+  //
+  
+  template<typename eT>
+  inline static void direct_var_sums(typename get_pod_type<eT>::result& out_sq, eT& out_dev, const eT* const X, const uword N, const eT mean_val);
+  
+  template<typename eT>
+  inline static void direct_var_rows(typename get_pod_type<eT>::result* out_mem, const Mat<eT>& X, const uword norm_type = 0);
+  
+  template<typename eT>
+  arma_inline static eT sq_abs(const eT val);
+  
+  template<typename T>
+  arma_inline static T  sq_abs(const std::complex<T>& val);
+  
+  
+  //! element accessors for the pairwise sums in direct_var_sums()
+  
+  template<typename eT>
+  struct dev_ea
+    {
+    const eT* const X;
+    const eT        mean_val;
+    
+    arma_inline dev_ea(const eT* const in_X, const eT in_mean_val) : X(in_X), mean_val(in_mean_val) {}
+    
+    arma_inline eT operator[](const uword i) const { return mean_val - X[i]; }
+    };
+  
+  template<typename eT>
+  struct sq_dev_ea
+    {
+    const eT* const X;
+    const eT        mean_val;
+    
+    arma_inline sq_dev_ea(const eT* const in_X, const eT in_mean_val) : X(in_X), mean_val(in_mean_val) {}
+    
+    arma_inline typename get_pod_type<eT>::result operator[](const uword i) const { return op_var::sq_abs(mean_val - X[i]); }
+    };
   };
 
 
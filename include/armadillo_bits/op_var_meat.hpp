@@ -51,10 +51,17 @@ op_var::apply(Mat<typename T1::pod_type>& out, const mtOp<typename T1::pod_type,
     
     out_eT* out_mem = out.memptr();
     
+    const bool use_mp    = mp_gate::eval(X.n_elem);
+    const int  n_threads = mp_gate::n_threads();
+    
+    arma_omp_pragma(omp parallel for schedule(static) if(use_mp) num_threads(n_threads))
     for(uword col=0; col<X_n_cols; ++col)
       {
       out_mem[col] = op_var::direct_var( X.colptr(col), X_n_rows, norm_type );
       }
+    
+    arma_ignore(use_mp);
+    arma_ignore(n_threads);
     }
   else
   if(dim == 1)
@@ -65,17 +72,7 @@ op_var::apply(Mat<typename T1::pod_type>& out, const mtOp<typename T1::pod_type,
     
     out.set_size(X_n_rows, 1);
     
-    podarray<in_eT> dat(X_n_cols);
-    
-    in_eT*  dat_mem = dat.memptr();
-    out_eT* out_mem = out.memptr();
-    
-    for(uword row=0; row<X_n_rows; ++row)
-      {
-      dat.copy_row(X, row);
-      
-      out_mem[row] = op_var::direct_var( dat_mem, X_n_cols, norm_type );
-      }
+    op_var::direct_var_rows( out.memptr(), X, norm_type );
     }
   }
 
@@ -161,32 +158,10 @@ op_var::direct_var(const eT* const X, const uword n_elem, const uword norm_type)
     {
     const eT acc1 = op_mean::direct_mean(X, n_elem);
     
-    eT acc2 = eT(0);
-    eT acc3 = eT(0);
-    
-    uword i,j;
-    
-    for(i=0, j=1; j<n_elem; i+=2, j+=2)
-      {
-      const eT Xi = X[i];
-      const eT Xj = X[j];
-      
-      const eT tmpi = acc1 - Xi;
-      const eT tmpj = acc1 - Xj;
-      
-      acc2 += tmpi*tmpi + tmpj*tmpj;
-      acc3 += tmpi      + tmpj;
-      }
+    eT acc2;
+    eT acc3;
     
-    if(i < n_elem)
-      {
-      const eT Xi = X[i];
-      
-      const eT tmpi = acc1 - Xi;
-      
-      acc2 += tmpi*tmpi;
-      acc3 += tmpi;
-      }
+    op_var::direct_var_sums(acc2, acc3, X, n_elem, acc1);
     
     const eT norm_val = (norm_type == 0) ? eT(n_elem-1) : eT(n_elem);
     const eT var_val  = (acc2 - acc3*acc3/eT(n_elem)) / norm_val;
@@ -201,6 +176,40 @@ op_var::direct_var(const eT* const X, const uword n_elem, const uword norm_type)
 
 
 
+//! sums of the squared deviations and of the deviations from mean_val, for the elements of an array.
+//! the sums are computed block by block (see pairwise_acc), so that each block is read from the cache for the second sum
+template<typename eT>
+inline
+void
+op_var::direct_var_sums(typename get_pod_type<eT>::result& out_sq, eT& out_dev, const eT* const X, const uword n_elem, const eT mean_val)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  const uword block_size = pairwise_acc<eT>::block_size;
+  
+  const    dev_ea<eT>    dev(X, mean_val);
+  const sq_dev_ea<eT> sq_dev(X, mean_val);
+  
+  pairwise_acc<T>  acc_sq;
+  pairwise_acc<eT> acc_dev;
+  
+  for(uword i=0; i < n_elem; i += block_size)
+    {
+    const uword n_remaining = n_elem - i;
+    const uword end         = i + ( (n_remaining < block_size) ? n_remaining : block_size );
+    
+    acc_sq.add ( pairwise_acc<T >::direct_sum(sq_dev, i, end) );
+    acc_dev.add( pairwise_acc<eT>::direct_sum(dev,    i, end) );
+    }
+  
+  out_sq  = acc_sq.get();
+  out_dev = acc_dev.get();
+  }
+
+
+
 //! find the variance of an array (robust but slow)
 template<typename eT>
 inline
@@ -248,16 +257,10 @@ op_var::direct_var(const std::complex<T>* const X, const uword n_elem, const uwo
     {
     const eT acc1 = op_mean::direct_mean(X, n_elem);
     
-    T  acc2 =  T(0);
-    eT acc3 = eT(0);
+    T  acc2;
+    eT acc3;
     
-    for(uword i=0; i<n_elem; ++i)
-      {
-      const eT tmp = acc1 - X[i];
-      
-      acc2 += std::norm(tmp);
-      acc3 += tmp;
-      }
+    op_var::direct_var_sums(acc2, acc3, X, n_elem, acc1);
     
     const T norm_val = (norm_type == 0) ? T(n_elem-1) : T(n_elem);
     const T var_val  = (acc2 - std::norm(acc3)/T(n_elem)) / norm_val;
@@ -307,5 +310,115 @@ op_var::direct_var_robust(const std::complex<T>* const X, const uword n_elem, co
 
 
 
+//! find the variance of each row of X.
+//! X is traversed column by column (ie. in storage order), with buffers holding the mean and the running sums of each row;
+//! blocks of rows are processed by separate threads when OpenMP is enabled.
+//! rows for which the result isn't finite are processed again with direct_var_robust()
+template<typename eT>
+inline
+void
+op_var::direct_var_rows(typename get_pod_type<eT>::result* out_mem, const Mat<eT>& X, const uword norm_type)
+  {
+  arma_extra_debug_sigprint();
+  
+  typedef typename get_pod_type<eT>::result T;
+  
+  const uword X_n_rows = X.n_rows;
+  const uword X_n_cols = X.n_cols;
+  
+  if(X_n_cols < 2)
+    {
+    arrayops::inplace_set(out_mem, T(0), X_n_rows);
+    return;
+    }
+  
+  podarray<eT> means(X_n_rows);
+  podarray<eT> acc3s(X_n_rows);
+  
+  eT* means_mem = means.memptr();
+  eT* acc3s_mem = acc3s.memptr();
+  
+  op_sum::direct_sum_rows(means_mem, X);
+  
+  for(uword row=0; row < X_n_rows; ++row)
+    {
+    const eT mean_val = means_mem[row] / T(X_n_cols);
+    
+    means_mem[row] = arma_isfinite(mean_val) ? mean_val : op_mean::direct_mean_robust(X, row);
+    }
+  
+  const T norm_val = (norm_type == 0) ? T(X_n_cols-1) : T(X_n_cols);
+  
+  const uword n_blocks   = mp_gate::n_row_blocks(X_n_rows, X_n_cols);
+  const uword block_rows = (X_n_rows + n_blocks - 1) / n_blocks;
+  
+  arma_omp_pragma(omp parallel for schedule(static) if(n_blocks > 1) num_threads(int(n_blocks)))
+  for(uword block=0; block < n_blocks; ++block)
+    {
+    const uword row_start = (std::min)(block * block_rows, X_n_rows);
+    const uword n_rows    = (std::min)(block_rows, X_n_rows - row_start);
+    
+    const eT* mean_block = &(means_mem[row_start]);
+          eT* acc3_block = &(acc3s_mem[row_start]);
+           T* acc2_block = &(out_mem[row_start]);
+    
+    arrayops::inplace_set(acc2_block,  T(0), n_rows);
+    arrayops::inplace_set(acc3_block, eT(0), n_rows);
+    
+    for(uword col=0; col < X_n_cols; ++col)
+      {
+      const eT* X_col = &(X.colptr(col)[row_start]);
+      
+      for(uword i=0; i < n_rows; ++i)
+        {
+        const eT tmp = mean_block[i] - X_col[i];
+        
+        acc2_block[i] += op_var::sq_abs(tmp);
+        acc3_block[i] += tmp;
+        }
+      }
+    
+    for(uword i=0; i < n_rows; ++i)
+      {
+      const T var_val = (acc2_block[i] - op_var::sq_abs(acc3_block[i])/T(X_n_cols)) / norm_val;
+      
+      if(arma_isfinite(var_val))
+        {
+        acc2_block[i] = var_val;
+        }
+      else
+        {
+        podarray<eT> dat(X_n_cols);
+        
+        dat.copy_row(X, row_start + i);
+        
+        acc2_block[i] = op_var::direct_var_robust( dat.memptr(), X_n_cols, norm_type );
+        }
+      }
+    }
+  }
+
+
+
+template<typename eT>
+arma_inline
+eT
+op_var::sq_abs(const eT val)
+  {
+  return val*val;
+  }
+
+
+
+template<typename T>
+arma_inline
+T
+op_var::sq_abs(const std::complex<T>& val)
+  {
+  return std::norm(val);
+  }
+
+
+
 //! @}
 
@@ -124,6 +124,74 @@ operator+
 
 
 
+//! addition of a matrix to the product of two matrices, eg. A*B + C;
+//! C is added to the result of the multiplication while it is still in cache (see glue_times_plus).
+//! longer chains of multiplications are left to eglue_plus, so that glue_times can choose their order of evaluation
+template<typename T1, typename T2, typename T3>
+arma_inline
+typename
+enable_if2
+  <
+  is_arma_type<T3>::value && is_same_type<typename T1::elem_type, typename T3::elem_type>::value && (is_glue_times<T1>::value == false) && (is_glue_times<T2>::value == false),
+  const Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus >
+  >::result
+operator+
+  (
+  const Glue<T1, T2, glue_times>& X,
+  const T3&                       Y
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  return Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus >(X, Y);
+  }
+
+
+
+//! addition of the product of two matrices to a matrix, eg. C + A*B
+template<typename T1, typename T2, typename T3>
+arma_inline
+typename
+enable_if2
+  <
+  is_arma_type<T3>::value && is_same_type<typename T1::elem_type, typename T3::elem_type>::value && (is_glue_times<T1>::value == false) && (is_glue_times<T2>::value == false),
+  const Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus >
+  >::result
+operator+
+  (
+  const T3&                       Y,
+  const Glue<T1, T2, glue_times>& X
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  return Glue< Glue<T1, T2, glue_times>, T3, glue_times_plus >(X, Y);  // NOTE: order is swapped
+  }
+
+
+
+//! addition of two products of two matrices, eg. A*B + C*D; the second product is evaluated first
+template<typename T1, typename T2, typename T3, typename T4>
+arma_inline
+typename
+enable_if2
+  <
+  is_same_type<typename T1::elem_type, typename T3::elem_type>::value && (is_glue_times<T1>::value == false) && (is_glue_times<T2>::value == false) && (is_glue_times<T3>::value == false) && (is_glue_times<T4>::value == false),
+  const Glue< Glue<T1, T2, glue_times>, Glue<T3, T4, glue_times>, glue_times_plus >
+  >::result
+operator+
+  (
+  const Glue<T1, T2, glue_times>& X,
+  const Glue<T3, T4, glue_times>& Y
+  )
+  {
+  arma_extra_debug_sigprint();
+  
+  return Glue< Glue<T1, T2, glue_times>, Glue<T3, T4, glue_times>, glue_times_plus >(X, Y);
+  }
+
+
+
 //! addition of user-accessible Armadillo objects with different element types
 template<typename T1, typename T2>
 inline
@@ -0,0 +1,202 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup pairwise_acc
+//! @{
+
+
+
+//! Blocked pairwise summation, used by accu(), sum(), mean(), var() and dot().
+//! Each block of at most block_size consecutive elements is summed directly,
+//! using several independent accumulators (or vector registers, see simd::accumulate()).
+//! The block sums are then combined pairwise (cascade summation),
+//! so that the round-off error grows with the logarithm of the number of blocks rather than linearly.
+//! If ARMA_USE_COMPENSATED_SUM is defined, the sums within each block use Kahan's compensated summation.
+template<typename eT>
+class pairwise_acc
+  {
+  public:
+  
+  static const uword block_size = 1024;
+  
+  #if defined(ARMA_USE_COMPENSATED_SUM)
+    static const bool compensated = is_non_integral<eT>::value;
+  #else
+    static const bool compensated = false;
+  #endif
+  
+  
+  inline
+  pairwise_acc()
+    : n_added(0)
+    , depth(0)
+    {
+    }
+  
+  
+  //! add the sum of the next block
+  arma_inline
+  void
+  add(const eT val)
+    {
+    eT acc = val;
+    
+    ++n_added;
+    
+    // each trailing zero bit of n_added marks a pair of equally sized partial sums, which are combined
+    for(uword k = n_added; (k & 1) == 0; k >>= 1)
+      {
+      --depth;
+      
+      acc = stack[depth] + acc;
+      }
+    
+    stack[depth] = acc;
+    ++depth;
+    }
+  
+  
+  //! the sum of all blocks added so far
+  inline
+  eT
+  get() const
+    {
+    if(depth == 0)
+      {
+      return eT(0);
+      }
+    
+    eT acc = stack[depth-1];
+    
+    for(uword i = depth-1; i > 0; --i)
+      {
+      acc = stack[i-1] + acc;
+      }
+    
+    return acc;
+    }
+  
+  
+  //! sum of src[start] ... src[end-1], where src is a plain array or an element accessor (see Proxy)
+  template<typename src_type>
+  arma_hot
+  inline
+  static
+  eT
+  direct_sum(const src_type& src, const uword start, const uword end)
+    {
+    uword i = start;
+    
+    if(compensated == false)
+      {
+      eT acc1 = eT(0);
+      eT acc2 = eT(0);
+      eT acc3 = eT(0);
+      eT acc4 = eT(0);
+      
+      for(; (i+4) <= end; i += 4)
+        {
+        acc1 += src[i  ];
+        acc2 += src[i+1];
+        acc3 += src[i+2];
+        acc4 += src[i+3];
+        }
+      
+      for(; i < end; ++i)
+        {
+        acc1 += src[i];
+        }
+      
+      return (acc1 + acc2) + (acc3 + acc4);
+      }
+    else
+      {
+      eT s1 = eT(0);  eT c1 = eT(0);
+      eT s2 = eT(0);  eT c2 = eT(0);
+      
+      for(; (i+2) <= end; i += 2)
+        {
+        const eT y1 = src[i  ] - c1;
+        const eT y2 = src[i+1] - c2;
+        
+        const eT t1 = s1 + y1;
+        const eT t2 = s2 + y2;
+        
+        c1 = (t1 - s1) - y1;
+        c2 = (t2 - s2) - y2;
+        
+        s1 = t1;
+        s2 = t2;
+        }
+      
+      if(i < end)
+        {
+        const eT y1 = src[i] - c1;
+        const eT t1 = s1 + y1;
+        
+        c1 = (t1 - s1) - y1;
+        s1 = t1;
+        }
+      
+      return (s1 + s2) - (c1 + c2);
+      }
+    }
+  
+  
+  //! sum of src[0] ... src[n_elem-1], where src is a plain array or an element accessor (see Proxy)
+  template<typename src_type>
+  arma_hot
+  inline
+  static
+  eT
+  accumulate(const src_type& src, const uword n_elem)
+    {
+    if(n_elem <= block_size)
+      {
+      return direct_sum(src, 0, n_elem);
+      }
+    
+    pairwise_acc<eT> acc;
+    
+    for(uword i=0; i < n_elem; i += block_size)
+      {
+      const uword n_remaining = n_elem - i;
+      
+      acc.add( direct_sum(src, i, i + ((n_remaining < block_size) ? n_remaining : uword(block_size))) );
+      }
+    
+    return acc.get();
+    }
+  
+  
+  //! as above, for a plain array; the block sums are vectorised where possible
+  arma_inline
+  static
+  eT
+  accumulate(const eT* src, const uword n_elem)
+    {
+    return arrayops::accumulate(src, n_elem);
+    }
+  
+  
+  private:
+  
+  uword n_added;
+  uword depth;
+  
+  eT stack[8*sizeof(uword)];
+  };
+
+
+
+//! @}
@@ -0,0 +1,60 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup running_quantile
+//! @{
+
+
+
+//! Class for estimating a quantile (eg. the median) of a continuously sampled process / signal,
+//! without storing the individual samples.
+//! Uses the P-square algorithm by R. Jain and I. Chlamtac (Communications of the ACM, 1985),
+//! which keeps five markers whose heights are adjusted with piecewise-parabolic interpolation.
+template<typename eT>
+class running_quantile
+  {
+  public:
+  
+  inline ~running_quantile();
+  inline explicit running_quantile(const eT in_p = eT(0.5));
+  
+  inline void operator() (const eT sample);
+  
+  inline void reset();
+  
+  inline eT quantile() const;
+  
+  inline eT min() const;
+  inline eT max() const;
+  
+  inline eT count() const;
+  
+  
+  private:
+  
+  inline eT parabolic(const uword i, const eT d) const;
+  inline eT linear   (const uword i, const eT d) const;
+  
+  arma_aligned arma_counter<eT> counter;
+  
+  arma_aligned eT p;          //!< requested quantile, in the [0,1] interval
+  
+  arma_aligned eT q[5];       //!< marker heights; the first five samples are kept here until the markers are initialised
+  arma_aligned eT n[5];       //!< actual marker positions
+  arma_aligned eT n_des[5];   //!< desired marker positions
+  arma_aligned eT dn[5];      //!< increments of the desired marker positions
+  };
+
+
+
+//! @}
@@ -0,0 +1,296 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup running_quantile
+//! @{
+
+
+
+template<typename eT>
+inline
+running_quantile<eT>::~running_quantile()
+  {
+  arma_extra_debug_sigprint_this(this);
+  }
+
+
+
+template<typename eT>
+inline
+running_quantile<eT>::running_quantile(const eT in_p)
+  : p(in_p)
+  {
+  arma_extra_debug_sigprint_this(this);
+  
+  arma_type_check(( is_float<eT>::value == false ) && ( is_double<eT>::value == false ));
+  
+  arma_debug_check( ((in_p < eT(0)) || (in_p > eT(1))), "running_quantile: p must be in the [0,1] interval" );
+  
+  reset();
+  }
+
+
+
+//! update the estimate to reflect new sample
+template<typename eT>
+inline
+void
+running_quantile<eT>::operator() (const eT sample)
+  {
+  arma_extra_debug_sigprint();
+  
+  if( arma_isfinite(sample) == false )
+    {
+    arma_warn(true, "running_quantile: sample ignored as it is non-finite" );
+    return;
+    }
+  
+  const eT N = counter.value();
+  
+  if(N < eT(5))
+    {
+    q[ uword(N) ] = sample;
+    
+    ++counter;
+    
+    if(N == eT(4))
+      {
+      std::sort(&q[0], &q[5]);
+      
+      for(uword i=0; i<5; ++i)
+        {
+        n[i] = eT(i+1);
+        }
+      
+      n_des[0] = eT(1);
+      n_des[1] = eT(1) + eT(2)*p;
+      n_des[2] = eT(1) + eT(4)*p;
+      n_des[3] = eT(3) + eT(2)*p;
+      n_des[4] = eT(5);
+      
+      dn[0] = eT(0);
+      dn[1] = p/eT(2);
+      dn[2] = p;
+      dn[3] = (eT(1) + p)/eT(2);
+      dn[4] = eT(1);
+      }
+    
+    return;
+    }
+  
+  ++counter;
+  
+  // find the cell containing the sample, extending the extreme markers if necessary
+  
+  uword k;
+  
+  if(sample < q[0])
+    {
+    q[0] = sample;
+    k    = 0;
+    }
+  else
+  if(sample >= q[4])
+    {
+    q[4] = sample;
+    k    = 3;
+    }
+  else
+    {
+    k = 0;
+    
+    while(sample >= q[k+1])
+      {
+      ++k;
+      }
+    }
+  
+  for(uword i=k+1; i<5; ++i)
+    {
+    n[i] += eT(1);
+    }
+  
+  for(uword i=0; i<5; ++i)
+    {
+    n_des[i] += dn[i];
+    }
+  
+  // adjust the heights of the middle markers if they are off their desired positions
+  
+  for(uword i=1; i<4; ++i)
+    {
+    const eT delta = n_des[i] - n[i];
+    
+    if( ((delta >= eT(1)) && ((n[i+1] - n[i]) > eT(1))) || ((delta <= eT(-1)) && ((n[i-1] - n[i]) < eT(-1))) )
+      {
+      const eT d = (delta >= eT(0)) ? eT(1) : eT(-1);
+      
+      const eT q_new = parabolic(i, d);
+      
+      q[i] = ( (q[i-1] < q_new) && (q_new < q[i+1]) ) ? q_new : linear(i, d);
+      
+      n[i] += d;
+      }
+    }
+  }
+
+
+
+//! piecewise-parabolic prediction of the height of marker i, when it is moved by d (+1 or -1)
+template<typename eT>
+inline
+eT
+running_quantile<eT>::parabolic(const uword i, const eT d) const
+  {
+  const eT a = (n[i]   - n[i-1] + d) * (q[i+1] - q[i]  ) / (n[i+1] - n[i]  );
+  const eT b = (n[i+1] - n[i]   - d) * (q[i]   - q[i-1]) / (n[i]   - n[i-1]);
+  
+  return q[i] + (d / (n[i+1] - n[i-1])) * (a + b);
+  }
+
+
+
+//! linear prediction of the height of marker i, used when the parabolic prediction is out of order
+template<typename eT>
+inline
+eT
+running_quantile<eT>::linear(const uword i, const eT d) const
+  {
+  const uword j = (d > eT(0)) ? (i+1) : (i-1);
+  
+  return q[i] + d * (q[j] - q[i]) / (n[j] - n[i]);
+  }
+
+
+
+//! discard all samples
+template<typename eT>
+inline
+void
+running_quantile<eT>::reset()
+  {
+  arma_extra_debug_sigprint();
+  
+  counter.reset();
+  
+  for(uword i=0; i<5; ++i)
+    {
+    q[i]     = eT(0);
+    n[i]     = eT(0);
+    n_des[i] = eT(0);
+    dn[i]    = eT(0);
+    }
+  }
+
+
+
+//! estimate of the quantile so far;
+//! while fewer than five samples have been seen, the quantile is found exactly (via linear interpolation)
+template<typename eT>
+inline
+eT
+running_quantile<eT>::quantile() const
+  {
+  arma_extra_debug_sigprint();
+  
+  const eT N = counter.value();
+  
+  if(N >= eT(5))
+    {
+    return q[2];
+    }
+  
+  if(N == eT(0))
+    {
+    return eT(0);
+    }
+  
+  const uword n_elem = uword(N);
+  
+  // at most 4 values: insertion sort
+  eT tmp[4];
+  
+  for(uword i=0; i < n_elem; ++i)
+    {
+    const eT val = q[i];
+    
+    uword j = i;
+    
+    while( (j > 0) && (val < tmp[j-1]) )
+      {
+      tmp[j] = tmp[j-1];
+      --j;
+      }
+    
+    tmp[j] = val;
+    }
+  
+  const eT    pos   = p * eT(n_elem - 1);
+  const uword index = uword(pos);
+  
+  if(index+1 < n_elem)
+    {
+    return tmp[index] + (pos - eT(index)) * (tmp[index+1] - tmp[index]);
+    }
+  else
+    {
+    return tmp[index];
+    }
+  }
+
+
+
+//! minimum value so far
+template<typename eT>
+inline
+eT
+running_quantile<eT>::min() const
+  {
+  arma_extra_debug_sigprint();
+  
+  const eT N = counter.value();
+  
+  return (N < eT(5)) ? ( (N > eT(0)) ? *( std::min_element(&q[0], &q[uword(N)]) ) : eT(0) ) : q[0];
+  }
+
+
+
+//! maximum value so far
+template<typename eT>
+inline
+eT
+running_quantile<eT>::max() const
+  {
+  arma_extra_debug_sigprint();
+  
+  const eT N = counter.value();
+  
+  return (N < eT(5)) ? ( (N > eT(0)) ? *( std::max_element(&q[0], &q[uword(N)]) ) : eT(0) ) : q[4];
+  }
+
+
+
+//! number of samples so far
+template<typename eT>
+inline
+eT
+running_quantile<eT>::count() const
+  {
+  arma_extra_debug_sigprint();
+  
+  return counter.value();
+  }
+
+
+
+//! @}
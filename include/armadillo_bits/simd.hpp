@@ -0,0 +1,1003 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+//! \addtogroup simd
+//! @{
+
+
+
+//! wrapper for a vector register holding several elements of type eT;
+//! the generic version indicates that no vector instructions are available for eT
+template<typename eT>
+struct simd_pack
+  {
+  static const bool  available = false;
+  static const uword width     = 1;
+  };
+
+
+
+#if defined(ARMA_HAVE_AVX)
+
+template<>
+struct simd_pack<double>
+  {
+  static const bool  available = true;
+  static const uword width     = 4;
+  static const uword alignment = 32;
+  
+  typedef double  elem_type;
+  typedef __m256d vec_type;
+  
+  arma_inline static vec_type zeros()                                    { return _mm256_setzero_pd();        }
+  arma_inline static vec_type fill (const double val)                    { return _mm256_set1_pd(val);        }
+  arma_inline static vec_type load (const double* mem)                   { return _mm256_load_pd(mem);        }
+  arma_inline static vec_type loadu(const double* mem)                   { return _mm256_loadu_pd(mem);       }
+  arma_inline static void     store(double* mem, const vec_type& a)      {        _mm256_store_pd(mem, a);    }
+  arma_inline static void     storeu(double* mem, const vec_type& a)     {        _mm256_storeu_pd(mem, a);   }
+  
+  arma_inline static vec_type add(const vec_type& a, const vec_type& b)  { return _mm256_add_pd(a, b);        }
+  arma_inline static vec_type sub(const vec_type& a, const vec_type& b)  { return _mm256_sub_pd(a, b);        }
+  arma_inline static vec_type mul(const vec_type& a, const vec_type& b)  { return _mm256_mul_pd(a, b);        }
+  arma_inline static vec_type div(const vec_type& a, const vec_type& b)  { return _mm256_div_pd(a, b);        }
+  arma_inline static vec_type sqrt(const vec_type& a)                    { return _mm256_sqrt_pd(a);          }
+  arma_inline static vec_type neg (const vec_type& a)                    { return _mm256_xor_pd(a, fill(-0.0));    }
+  arma_inline static vec_type abs (const vec_type& a)                    { return _mm256_andnot_pd(fill(-0.0), a); }
+  
+  arma_inline static vec_type min   (const vec_type& a, const vec_type& b)  { return _mm256_min_pd(a, b);    }
+  arma_inline static vec_type max   (const vec_type& a, const vec_type& b)  { return _mm256_max_pd(a, b);    }
+  arma_inline static vec_type and_  (const vec_type& a, const vec_type& b)  { return _mm256_and_pd(a, b);    }
+  arma_inline static vec_type or_   (const vec_type& a, const vec_type& b)  { return _mm256_or_pd(a, b);     }
+  arma_inline static vec_type xor_  (const vec_type& a, const vec_type& b)  { return _mm256_xor_pd(a, b);    }
+  arma_inline static vec_type andnot(const vec_type& a, const vec_type& b)  { return _mm256_andnot_pd(a, b); }
+  
+  arma_inline static vec_type cmp_lt(const vec_type& a, const vec_type& b)  { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+  arma_inline static vec_type cmp_le(const vec_type& a, const vec_type& b)  { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+  arma_inline static vec_type cmp_gt(const vec_type& a, const vec_type& b)  { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+  arma_inline static vec_type cmp_ge(const vec_type& a, const vec_type& b)  { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+  
+  arma_inline static vec_type select (const vec_type& mask, const vec_type& a, const vec_type& b) { return _mm256_or_pd( _mm256_and_pd(mask, a), _mm256_andnot_pd(mask, b) ); }
+  arma_inline static bool     all_set(const vec_type& mask)                                       { return (_mm256_movemask_pd(mask) == 0xF); }
+  
+  //! 2^n, for integral n in the range of normal exponents
+  arma_inline
+  static
+  vec_type
+  pow2i(const vec_type& n)
+    {
+    const vec_type t = _mm256_add_pd(n, fill(4503599627370496.0 + 1023.0));
+    
+    const __m128i lo = _mm_slli_epi64( _mm_castpd_si128(_mm256_castpd256_pd128(t)),    52 );
+    const __m128i hi = _mm_slli_epi64( _mm_castpd_si128(_mm256_extractf128_pd(t, 1)), 52 );
+    
+    return _mm256_insertf128_pd( _mm256_castpd128_pd256(_mm_castsi128_pd(lo)), _mm_castsi128_pd(hi), 1 );
+    }
+  
+  //! biased exponent of positive a
+  arma_inline
+  static
+  vec_type
+  exponent(const vec_type& a)
+    {
+    const __m128i lo = _mm_srli_epi64( _mm_castpd_si128(_mm256_castpd256_pd128(a)),    52 );
+    const __m128i hi = _mm_srli_epi64( _mm_castpd_si128(_mm256_extractf128_pd(a, 1)), 52 );
+    
+    const vec_type e = _mm256_insertf128_pd( _mm256_castpd128_pd256(_mm_castsi128_pd(lo)), _mm_castsi128_pd(hi), 1 );
+    
+    return _mm256_sub_pd( _mm256_or_pd(e, fill(4503599627370496.0)), fill(4503599627370496.0) );
+    }
+  
+  arma_inline
+  static
+  double
+  hsum(const vec_type& a)
+    {
+    const __m128d b = _mm_add_pd( _mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1) );
+    
+    return _mm_cvtsd_f64( _mm_add_sd(b, _mm_unpackhi_pd(b, b)) );
+    }
+  };
+
+
+
+template<>
+struct simd_pack<float>
+  {
+  static const bool  available = true;
+  static const uword width     = 8;
+  static const uword alignment = 32;
+  
+  typedef float  elem_type;
+  typedef __m256 vec_type;
+  
+  arma_inline static vec_type zeros()                                    { return _mm256_setzero_ps();        }
+  arma_inline static vec_type fill (const float val)                     { return _mm256_set1_ps(val);        }
+  arma_inline static vec_type load (const float* mem)                    { return _mm256_load_ps(mem);        }
+  arma_inline static vec_type loadu(const float* mem)                    { return _mm256_loadu_ps(mem);       }
+  arma_inline static void     store(float* mem, const vec_type& a)       {        _mm256_store_ps(mem, a);    }
+  arma_inline static void     storeu(float* mem, const vec_type& a)      {        _mm256_storeu_ps(mem, a);   }
+  
+  arma_inline static vec_type add(const vec_type& a, const vec_type& b)  { return _mm256_add_ps(a, b);        }
+  arma_inline static vec_type sub(const vec_type& a, const vec_type& b)  { return _mm256_sub_ps(a, b);        }
+  arma_inline static vec_type mul(const vec_type& a, const vec_type& b)  { return _mm256_mul_ps(a, b);        }
+  arma_inline static vec_type div(const vec_type& a, const vec_type& b)  { return _mm256_div_ps(a, b);        }
+  arma_inline static vec_type sqrt(const vec_type& a)                    { return _mm256_sqrt_ps(a);          }
+  arma_inline static vec_type neg (const vec_type& a)                    { return _mm256_xor_ps(a, fill(-0.0f));    }
+  arma_inline static vec_type abs (const vec_type& a)                    { return _mm256_andnot_ps(fill(-0.0f), a); }
+  
+  arma_inline static vec_type min   (const vec_type& a, const vec_type& b)  { return _mm256_min_ps(a, b);    }
+  arma_inline static vec_type max   (const vec_type& a, const vec_type& b)  { return _mm256_max_ps(a, b);    }
+  arma_inline static vec_type and_  (const vec_type& a, const vec_type& b)  { return _mm256_and_ps(a, b);    }
+  arma_inline static vec_type or_   (const vec_type& a, const vec_type& b)  { return _mm256_or_ps(a, b);     }
+  arma_inline static vec_type xor_  (const vec_type& a, const vec_type& b)  { return _mm256_xor_ps(a, b);    }
+  arma_inline static vec_type andnot(const vec_type& a, const vec_type& b)  { return _mm256_andnot_ps(a, b); }
+  
+  arma_inline static vec_type cmp_lt(const vec_type& a, const vec_type& b)  { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+  arma_inline static vec_type cmp_le(const vec_type& a, const vec_type& b)  { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+  arma_inline static vec_type cmp_gt(const vec_type& a, const vec_type& b)  { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+  arma_inline static vec_type cmp_ge(const vec_type& a, const vec_type& b)  { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+  
+  arma_inline static vec_type select (const vec_type& mask, const vec_type& a, const vec_type& b) { return _mm256_or_ps( _mm256_and_ps(mask, a), _mm256_andnot_ps(mask, b) ); }
+  arma_inline static bool     all_set(const vec_type& mask)                                       { return (_mm256_movemask_ps(mask) == 0xFF); }
+  
+  //! 2^n, for integral n in the range of normal exponents
+  arma_inline
+  static
+  vec_type
+  pow2i(const vec_type& n)
+    {
+    const vec_type t = _mm256_add_ps(n, fill(8388608.0f + 127.0f));
+    
+    const __m128i lo = _mm_slli_epi32( _mm_castps_si128(_mm256_castps256_ps128(t)),    23 );
+    const __m128i hi = _mm_slli_epi32( _mm_castps_si128(_mm256_extractf128_ps(t, 1)), 23 );
+    
+    return _mm256_insertf128_ps( _mm256_castps128_ps256(_mm_castsi128_ps(lo)), _mm_castsi128_ps(hi), 1 );
+    }
+  
+  //! biased exponent of positive a
+  arma_inline
+  static
+  vec_type
+  exponent(const vec_type& a)
+    {
+    const __m128i lo = _mm_srli_epi32( _mm_castps_si128(_mm256_castps256_ps128(a)),    23 );
+    const __m128i hi = _mm_srli_epi32( _mm_castps_si128(_mm256_extractf128_ps(a, 1)), 23 );
+    
+    const vec_type e = _mm256_insertf128_ps( _mm256_castps128_ps256(_mm_castsi128_ps(lo)), _mm_castsi128_ps(hi), 1 );
+    
+    return _mm256_sub_ps( _mm256_or_ps(e, fill(8388608.0f)), fill(8388608.0f) );
+    }
+  
+  arma_inline
+  static
+  float
+  hsum(const vec_type& a)
+    {
+    const __m128 b = _mm_add_ps( _mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1) );
+    const __m128 c = _mm_add_ps( b, _mm_movehl_ps(b, b) );
+    
+    return _mm_cvtss_f32( _mm_add_ss(c, _mm_shuffle_ps(c, c, 1)) );
+    }
+  };
+
+#elif defined(ARMA_HAVE_SSE2)
+
+template<>
+struct simd_pack<double>
+  {
+  static const bool  available = true;
+  static const uword width     = 2;
+  static const uword alignment = 16;
+  
+  typedef double  elem_type;
+  typedef __m128d vec_type;
+  
+  arma_inline static vec_type zeros()                                    { return _mm_setzero_pd();        }
+  arma_inline static vec_type fill (const double val)                    { return _mm_set1_pd(val);        }
+  arma_inline static vec_type load (const double* mem)                   { return _mm_load_pd(mem);        }
+  arma_inline static vec_type loadu(const double* mem)                   { return _mm_loadu_pd(mem);       }
+  arma_inline static void     store(double* mem, const vec_type& a)      {        _mm_store_pd(mem, a);    }
+  arma_inline static void     storeu(double* mem, const vec_type& a)     {        _mm_storeu_pd(mem, a);   }
+  
+  arma_inline static vec_type add(const vec_type& a, const vec_type& b)  { return _mm_add_pd(a, b);        }
+  arma_inline static vec_type sub(const vec_type& a, const vec_type& b)  { return _mm_sub_pd(a, b);        }
+  arma_inline static vec_type mul(const vec_type& a, const vec_type& b)  { return _mm_mul_pd(a, b);        }
+  arma_inline static vec_type div(const vec_type& a, const vec_type& b)  { return _mm_div_pd(a, b);        }
+  arma_inline static vec_type sqrt(const vec_type& a)                    { return _mm_sqrt_pd(a);          }
+  arma_inline static vec_type neg (const vec_type& a)                    { return _mm_xor_pd(a, fill(-0.0));    }
+  arma_inline static vec_type abs (const vec_type& a)                    { return _mm_andnot_pd(fill(-0.0), a); }
+  
+  arma_inline static vec_type min   (const vec_type& a, const vec_type& b)  { return _mm_min_pd(a, b);    }
+  arma_inline static vec_type max   (const vec_type& a, const vec_type& b)  { return _mm_max_pd(a, b);    }
+  arma_inline static vec_type and_  (const vec_type& a, const vec_type& b)  { return _mm_and_pd(a, b);    }
+  arma_inline static vec_type or_   (const vec_type& a, const vec_type& b)  { return _mm_or_pd(a, b);     }
+  arma_inline static vec_type xor_  (const vec_type& a, const vec_type& b)  { return _mm_xor_pd(a, b);    }
+  arma_inline static vec_type andnot(const vec_type& a, const vec_type& b)  { return _mm_andnot_pd(a, b); }
+  
+  arma_inline static vec_type cmp_lt(const vec_type& a, const vec_type& b)  { return _mm_cmplt_pd(a, b); }
+  arma_inline static vec_type cmp_le(const vec_type& a, const vec_type& b)  { return _mm_cmple_pd(a, b); }
+  arma_inline static vec_type cmp_gt(const vec_type& a, const vec_type& b)  { return _mm_cmpgt_pd(a, b); }
+  arma_inline static vec_type cmp_ge(const vec_type& a, const vec_type& b)  { return _mm_cmpge_pd(a, b); }
+  
+  arma_inline static vec_type select (const vec_type& mask, const vec_type& a, const vec_type& b) { return _mm_or_pd( _mm_and_pd(mask, a), _mm_andnot_pd(mask, b) ); }
+  arma_inline static bool     all_set(const vec_type& mask)                                       { return (_mm_movemask_pd(mask) == 0x3); }
+  
+  //! 2^n, for integral n in the range of normal exponents
+  arma_inline
+  static
+  vec_type
+  pow2i(const vec_type& n)
+    {
+    return _mm_castsi128_pd( _mm_slli_epi64( _mm_castpd_si128( _mm_add_pd(n, fill(4503599627370496.0 + 1023.0)) ), 52 ) );
+    }
+  
+  //! biased exponent of positive a
+  arma_inline
+  static
+  vec_type
+  exponent(const vec_type& a)
+    {
+    const vec_type e = _mm_castsi128_pd( _mm_srli_epi64( _mm_castpd_si128(a), 52 ) );
+    
+    return _mm_sub_pd( _mm_or_pd(e, fill(4503599627370496.0)), fill(4503599627370496.0) );
+    }
+  
+  arma_inline static double   hsum(const vec_type& a)                    { return _mm_cvtsd_f64( _mm_add_sd(a, _mm_unpackhi_pd(a, a)) ); }
+  };
+
+
+
+template<>
+struct simd_pack<float>
+  {
+  static const bool  available = true;
+  static const uword width     = 4;
+  static const uword alignment = 16;
+  
+  typedef float  elem_type;
+  typedef __m128 vec_type;
+  
+  arma_inline static vec_type zeros()                                    { return _mm_setzero_ps();        }
+  arma_inline static vec_type fill (const float val)                     { return _mm_set1_ps(val);        }
+  arma_inline static vec_type load (const float* mem)                    { return _mm_load_ps(mem);        }
+  arma_inline static vec_type loadu(const float* mem)                    { return _mm_loadu_ps(mem);       }
+  arma_inline static void     store(float* mem, const vec_type& a)       {        _mm_store_ps(mem, a);    }
+  arma_inline static void     storeu(float* mem, const vec_type& a)      {        _mm_storeu_ps(mem, a);   }
+  
+  arma_inline static vec_type add(const vec_type& a, const vec_type& b)  { return _mm_add_ps(a, b);        }
+  arma_inline static vec_type sub(const vec_type& a, const vec_type& b)  { return _mm_sub_ps(a, b);        }
+  arma_inline static vec_type mul(const vec_type& a, const vec_type& b)  { return _mm_mul_ps(a, b);        }
+  arma_inline static vec_type div(const vec_type& a, const vec_type& b)  { return _mm_div_ps(a, b);        }
+  arma_inline static vec_type sqrt(const vec_type& a)                    { return _mm_sqrt_ps(a);          }
+  arma_inline static vec_type neg (const vec_type& a)                    { return _mm_xor_ps(a, fill(-0.0f));    }
+  arma_inline static vec_type abs (const vec_type& a)                    { return _mm_andnot_ps(fill(-0.0f), a); }
+  
+  arma_inline static vec_type min   (const vec_type& a, const vec_type& b)  { return _mm_min_ps(a, b);    }
+  arma_inline static vec_type max   (const vec_type& a, const vec_type& b)  { return _mm_max_ps(a, b);    }
+  arma_inline static vec_type and_  (const vec_type& a, const vec_type& b)  { return _mm_and_ps(a, b);    }
+  arma_inline static vec_type or_   (const vec_type& a, const vec_type& b)  { return _mm_or_ps(a, b);     }
+  arma_inline static vec_type xor_  (const vec_type& a, const vec_type& b)  { return _mm_xor_ps(a, b);    }
+  arma_inline static vec_type andnot(const vec_type& a, const vec_type& b)  { return _mm_andnot_ps(a, b); }
+  
+  arma_inline static vec_type cmp_lt(const vec_type& a, const vec_type& b)  { return _mm_cmplt_ps(a, b); }
+  arma_inline static vec_type cmp_le(const vec_type& a, const vec_type& b)  { return _mm_cmple_ps(a, b); }
+  arma_inline static vec_type cmp_gt(const vec_type& a, const vec_type& b)  { return _mm_cmpgt_ps(a, b); }
+  arma_inline static vec_type cmp_ge(const vec_type& a, const vec_type& b)  { return _mm_cmpge_ps(a, b); }
+  
+  arma_inline static vec_type select (const vec_type& mask, const vec_type& a, const vec_type& b) { return _mm_or_ps( _mm_and_ps(mask, a), _mm_andnot_ps(mask, b) ); }
+  arma_inline static bool     all_set(const vec_type& mask)                                       { return (_mm_movemask_ps(mask) == 0xF); }
+  
+  //! 2^n, for integral n in the range of normal exponents
+  arma_inline
+  static
+  vec_type
+  pow2i(const vec_type& n)
+    {
+    return _mm_castsi128_ps( _mm_slli_epi32( _mm_castps_si128( _mm_add_ps(n, fill(8388608.0f + 127.0f)) ), 23 ) );
+    }
+  
+  //! biased exponent of positive a
+  arma_inline
+  static
+  vec_type
+  exponent(const vec_type& a)
+    {
+    const vec_type e = _mm_castsi128_ps( _mm_srli_epi32( _mm_castps_si128(a), 23 ) );
+    
+    return _mm_sub_ps( _mm_or_ps(e, fill(8388608.0f)), fill(8388608.0f) );
+    }
+  
+  arma_inline
+  static
+  float
+  hsum(const vec_type& a)
+    {
+    const __m128 b = _mm_add_ps( a, _mm_movehl_ps(a, a) );
+    
+    return _mm_cvtss_f32( _mm_add_ss(b, _mm_shuffle_ps(b, b, 1)) );
+    }
+  };
+
+#endif
+
+
+
+// 
+// how the result of an element-wise operation is written to the output
+
+struct simd_op_equ
+  {
+  static const bool uses_out = false;
+  
+  template<typename pack> arma_inline static typename pack::vec_type apply(const typename pack::vec_type&,     const typename pack::vec_type& val) { return val;                  }
+  template<typename eT>   arma_inline static void                    apply(eT& out, const eT val)                                                 { out = val;                   }
+  };
+
+struct simd_op_plus
+  {
+  static const bool uses_out = true;
+  
+  template<typename pack> arma_inline static typename pack::vec_type apply(const typename pack::vec_type& out, const typename pack::vec_type& val) { return pack::add(out, val); }
+  template<typename eT>   arma_inline static void                    apply(eT& out, const eT val)                                                 { out += val;                  }
+  };
+
+struct simd_op_minus
+  {
+  static const bool uses_out = true;
+  
+  template<typename pack> arma_inline static typename pack::vec_type apply(const typename pack::vec_type& out, const typename pack::vec_type& val) { return pack::sub(out, val); }
+  template<typename eT>   arma_inline static void                    apply(eT& out, const eT val)                                                 { out -= val;                  }
+  };
+
+struct simd_op_schur
+  {
+  static const bool uses_out = true;
+  
+  template<typename pack> arma_inline static typename pack::vec_type apply(const typename pack::vec_type& out, const typename pack::vec_type& val) { return pack::mul(out, val); }
+  template<typename eT>   arma_inline static void                    apply(eT& out, const eT val)                                                 { out *= val;                  }
+  };
+
+struct simd_op_div
+  {
+  static const bool uses_out = true;
+  
+  template<typename pack> arma_inline static typename pack::vec_type apply(const typename pack::vec_type& out, const typename pack::vec_type& val) { return pack::div(out, val); }
+  template<typename eT>   arma_inline static void                    apply(eT& out, const eT val)                                                 { out /= val;                  }
+  };
+
+
+
+// 
+// vectorised forms of element-wise operations;
+// only operations that give results identical to the scalar versions in eop_core and eglue_core are listed;
+// approximations of exp(), log(), sin(), cos() and tanh() are added in simd_math.hpp if ARMA_USE_SIMD_MATH is defined
+
+template<typename eop_type>
+struct simd_eop
+  {
+  static const bool available = false;
+  };
+
+
+#undef  arma_simd_eop
+#define arma_simd_eop(eop_type, expr) \
+  template<>\
+  struct simd_eop<eop_type>\
+    {\
+    static const bool available = true;\
+    \
+    template<typename pack>\
+    arma_inline static typename pack::vec_type process(const typename pack::vec_type& val, const typename pack::vec_type& k)\
+      {\
+      arma_ignore(k);\
+      return expr;\
+      }\
+    };
+
+arma_simd_eop(eop_scalar_plus,       pack::add(val, k)     )
+arma_simd_eop(eop_scalar_minus_pre,  pack::sub(k, val)     )
+arma_simd_eop(eop_scalar_minus_post, pack::sub(val, k)     )
+arma_simd_eop(eop_scalar_times,      pack::mul(val, k)     )
+arma_simd_eop(eop_scalar_div_pre,    pack::div(k, val)     )
+arma_simd_eop(eop_scalar_div_post,   pack::div(val, k)     )
+arma_simd_eop(eop_square,            pack::mul(val, val)   )
+arma_simd_eop(eop_neg,               pack::neg(val)        )
+arma_simd_eop(eop_sqrt,              pack::sqrt(val)       )
+arma_simd_eop(eop_abs,               pack::abs(val)        )
+
+#undef arma_simd_eop
+
+
+
+template<typename eglue_type>
+struct simd_eglue
+  {
+  static const bool available = false;
+  };
+
+
+#undef  arma_simd_eglue
+#define arma_simd_eglue(eglue_type, vec_function, operatorB) \
+  template<>\
+  struct simd_eglue<eglue_type>\
+    {\
+    static const bool available = true;\
+    \
+    template<typename pack>\
+    arma_inline static typename pack::vec_type process(const typename pack::vec_type& a, const typename pack::vec_type& b) { return pack::vec_function(a, b); }\
+    \
+    template<typename eT>\
+    arma_inline static eT process(const eT a, const eT b) { return a operatorB b; }\
+    };
+
+arma_simd_eglue(eglue_plus,  add, +)
+arma_simd_eglue(eglue_minus, sub, -)
+arma_simd_eglue(eglue_schur, mul, *)
+arma_simd_eglue(eglue_div,   div, /)
+
+#undef arma_simd_eglue
+
+
+
+//! the vectorised loops;
+//! the output is processed one element at a time until it is aligned,
+//! after which aligned stores (and, where possible, aligned loads) are used
+template<bool use_simd>
+class simd_engine
+  {
+  public:
+  
+  template<typename eop_type, typename op_type, typename eT>
+  arma_inline static bool eop_apply(eT*, const eT*, const eT, const uword) { return false; }
+  
+  template<typename eglue_type, typename op_type, typename eT>
+  arma_inline static bool eglue_apply(eT*, const eT*, const eT*, const uword) { return false; }
+  
+  template<typename op_type, typename eT>
+  arma_inline static bool array_apply(eT*, const eT*, const uword) { return false; }
+  
+  template<bool compensated, typename eT>
+  arma_inline static bool accumulate(eT&, const eT*, const uword) { return false; }
+  
+  template<bool compensated, typename eT>
+  arma_inline static bool dot(eT&, const eT*, const eT*, const uword) { return false; }
+  };
+
+
+
+template<>
+class simd_engine<true>
+  {
+  public:
+  
+  template<typename eop_type, typename op_type, typename eT>
+  arma_hot
+  inline
+  static
+  bool
+  eop_apply(eT* out, const eT* A, const eT k, const uword n_elem)
+    {
+    typedef simd_pack<eT> pack;
+    
+    uword i = 0;
+    
+    for(; (i < n_elem) && (is_aligned<pack>(&out[i]) == false); ++i)
+      {
+      op_type::apply(out[i], eop_core<eop_type>::process(A[i], k));
+      }
+    
+    const uword n_vec = i + ( (n_elem - i) / pack::width ) * pack::width;
+    
+    if(is_aligned<pack>(&A[i]))
+      {
+      eop_loop<eop_type, op_type, pack, true >(out, A, k, i, n_vec);
+      }
+    else
+      {
+      eop_loop<eop_type, op_type, pack, false>(out, A, k, i, n_vec);
+      }
+    
+    for(i = n_vec; i < n_elem; ++i)
+      {
+      op_type::apply(out[i], eop_core<eop_type>::process(A[i], k));
+      }
+    
+    return true;
+    }
+  
+  
+  
+  template<typename eglue_type, typename op_type, typename eT>
+  arma_hot
+  inline
+  static
+  bool
+  eglue_apply(eT* out, const eT* A, const eT* B, const uword n_elem)
+    {
+    typedef simd_pack<eT> pack;
+    
+    uword i = 0;
+    
+    for(; (i < n_elem) && (is_aligned<pack>(&out[i]) == false); ++i)
+      {
+      op_type::apply(out[i], simd_eglue<eglue_type>::process(A[i], B[i]));
+      }
+    
+    const uword n_vec = i + ( (n_elem - i) / pack::width ) * pack::width;
+    
+    if( is_aligned<pack>(&A[i]) && is_aligned<pack>(&B[i]) )
+      {
+      eglue_loop<eglue_type, op_type, pack, true >(out, A, B, i, n_vec);
+      }
+    else
+      {
+      eglue_loop<eglue_type, op_type, pack, false>(out, A, B, i, n_vec);
+      }
+    
+    for(i = n_vec; i < n_elem; ++i)
+      {
+      op_type::apply(out[i], simd_eglue<eglue_type>::process(A[i], B[i]));
+      }
+    
+    return true;
+    }
+  
+  
+  
+  template<typename op_type, typename eT>
+  arma_hot
+  inline
+  static
+  bool
+  array_apply(eT* out, const eT* A, const uword n_elem)
+    {
+    typedef simd_pack<eT> pack;
+    
+    uword i = 0;
+    
+    for(; (i < n_elem) && (is_aligned<pack>(&out[i]) == false); ++i)
+      {
+      op_type::apply(out[i], A[i]);
+      }
+    
+    const uword n_vec = i + ( (n_elem - i) / pack::width ) * pack::width;
+    
+    if(is_aligned<pack>(&A[i]))
+      {
+      array_loop<op_type, pack, true >(out, A, i, n_vec);
+      }
+    else
+      {
+      array_loop<op_type, pack, false>(out, A, i, n_vec);
+      }
+    
+    for(i = n_vec; i < n_elem; ++i)
+      {
+      op_type::apply(out[i], A[i]);
+      }
+    
+    return true;
+    }
+  
+  
+  
+  template<bool compensated, typename eT>
+  arma_hot
+  inline
+  static
+  bool
+  accumulate(eT& out, const eT* A, const uword n_elem)
+    {
+    return reduce<compensated, false>(out, A, A, n_elem);
+    }
+  
+  
+  
+  template<bool compensated, typename eT>
+  arma_hot
+  inline
+  static
+  bool
+  dot(eT& out, const eT* A, const eT* B, const uword n_elem)
+    {
+    return reduce<compensated, true>(out, A, B, n_elem);
+    }
+  
+  
+  
+  private:
+  
+  template<typename pack>
+  arma_inline
+  static
+  bool
+  is_aligned(const typename pack::elem_type* mem)
+    {
+    return ( (std::size_t(mem) & std::size_t(pack::alignment - 1)) == 0 );
+    }
+  
+  
+  
+  //! out = sum(A), or out = sum(A % B) if use_B is true
+  template<bool compensated, bool use_B, typename eT>
+  arma_hot
+  inline
+  static
+  bool
+  reduce(eT& out, const eT* A, const eT* B, const uword n_elem)
+    {
+    typedef simd_pack<eT> pack;
+    
+    eT acc = eT(0);
+    
+    uword i = 0;
+    
+    for(; (i < n_elem) && (is_aligned<pack>(&A[i]) == false); ++i)
+      {
+      acc += (use_B) ? A[i]*B[i] : A[i];
+      }
+    
+    const uword n_vec = i + ( (n_elem - i) / pack::width ) * pack::width;
+    
+    if( is_aligned<pack>(&B[i]) )
+      {
+      acc += reduce_loop<compensated, use_B, pack, true >(A, B, i, n_vec);
+      }
+    else
+      {
+      acc += reduce_loop<compensated, use_B, pack, false>(A, B, i, n_vec);
+      }
+    
+    for(i = n_vec; i < n_elem; ++i)
+      {
+      acc += (use_B) ? A[i]*B[i] : A[i];
+      }
+    
+    out = acc;
+    
+    return true;
+    }
+  
+  
+  
+  //! A[i] (or A[i]*B[i]) for the elements i ... i+pack::width-1; A is aligned
+  template<bool use_B, typename pack, bool B_aligned>
+  arma_inline
+  static
+  typename pack::vec_type
+  reduce_term(const typename pack::elem_type* A, const typename pack::elem_type* B, const uword i)
+    {
+    return (use_B) ? pack::mul( pack::load(&A[i]), (B_aligned) ? pack::load(&B[i]) : pack::loadu(&B[i]) ) : pack::load(&A[i]);
+    }
+  
+  
+  
+  //! s += val, using Kahan's compensated summation if required
+  template<bool compensated, typename pack>
+  arma_inline
+  static
+  void
+  reduce_add(typename pack::vec_type& s, typename pack::vec_type& c, const typename pack::vec_type& val)
+    {
+    if(compensated)
+      {
+      const typename pack::vec_type y = pack::sub(val, c);
+      const typename pack::vec_type t = pack::add(s, y);
+      
+      c = pack::sub( pack::sub(t, s), y );
+      s = t;
+      }
+    else
+      {
+      s = pack::add(s, val);
+      }
+    }
+  
+  
+  
+  template<bool compensated, bool use_B, typename pack, bool B_aligned>
+  arma_hot
+  inline
+  static
+  typename pack::elem_type
+  reduce_loop(const typename pack::elem_type* A, const typename pack::elem_type* B, const uword start, const uword end)
+    {
+    typedef typename pack::vec_type vec_type;
+    
+    // four independent accumulators hide the latency of the vector addition
+    vec_type s1 = pack::zeros();  vec_type c1 = pack::zeros();
+    vec_type s2 = pack::zeros();  vec_type c2 = pack::zeros();
+    vec_type s3 = pack::zeros();  vec_type c3 = pack::zeros();
+    vec_type s4 = pack::zeros();  vec_type c4 = pack::zeros();
+    
+    const uword n_block = 4*pack::width;
+    
+    uword i = start;
+    
+    for(; (i + n_block) <= end; i += n_block)
+      {
+      reduce_add<compensated, pack>( s1, c1, reduce_term<use_B, pack, B_aligned>(A, B, i                ) );
+      reduce_add<compensated, pack>( s2, c2, reduce_term<use_B, pack, B_aligned>(A, B, i +   pack::width) );
+      reduce_add<compensated, pack>( s3, c3, reduce_term<use_B, pack, B_aligned>(A, B, i + 2*pack::width) );
+      reduce_add<compensated, pack>( s4, c4, reduce_term<use_B, pack, B_aligned>(A, B, i + 3*pack::width) );
+      }
+    
+    for(; i < end; i += pack::width)
+      {
+      reduce_add<compensated, pack>( s1, c1, reduce_term<use_B, pack, B_aligned>(A, B, i) );
+      }
+    
+    const typename pack::elem_type s = pack::hsum( pack::add( pack::add(s1, s2), pack::add(s3, s4) ) );
+    
+    return (compensated) ? ( s - pack::hsum( pack::add( pack::add(c1, c2), pack::add(c3, c4) ) ) ) : s;
+    }
+  
+  
+  
+  template<typename eop_type, typename op_type, typename pack, bool A_aligned>
+  arma_hot
+  inline
+  static
+  void
+  eop_loop(typename pack::elem_type* out, const typename pack::elem_type* A, const typename pack::elem_type k, const uword start, const uword end)
+    {
+    typedef typename pack::vec_type vec_type;
+    
+    const vec_type kk = pack::fill(k);
+    
+    for(uword i = start; i < end; i += pack::width)
+      {
+      const vec_type val = simd_eop<eop_type>::template process<pack>( (A_aligned) ? pack::load(&A[i]) : pack::loadu(&A[i]), kk );
+      
+      pack::store( &out[i], (op_type::uses_out) ? op_type::template apply<pack>(pack::load(&out[i]), val) : val );
+      }
+    }
+  
+  
+  
+  template<typename eglue_type, typename op_type, typename pack, bool AB_aligned>
+  arma_hot
+  inline
+  static
+  void
+  eglue_loop(typename pack::elem_type* out, const typename pack::elem_type* A, const typename pack::elem_type* B, const uword start, const uword end)
+    {
+    typedef typename pack::vec_type vec_type;
+    
+    for(uword i = start; i < end; i += pack::width)
+      {
+      const vec_type a = (AB_aligned) ? pack::load(&A[i]) : pack::loadu(&A[i]);
+      const vec_type b = (AB_aligned) ? pack::load(&B[i]) : pack::loadu(&B[i]);
+      
+      const vec_type val = simd_eglue<eglue_type>::template process<pack>(a, b);
+      
+      pack::store( &out[i], (op_type::uses_out) ? op_type::template apply<pack>(pack::load(&out[i]), val) : val );
+      }
+    }
+  
+  
+  
+  template<typename op_type, typename pack, bool A_aligned>
+  arma_hot
+  inline
+  static
+  void
+  array_loop(typename pack::elem_type* out, const typename pack::elem_type* A, const uword start, const uword end)
+    {
+    typedef typename pack::vec_type vec_type;
+    
+    for(uword i = start; i < end; i += pack::width)
+      {
+      const vec_type val = (A_aligned) ? pack::load(&A[i]) : pack::loadu(&A[i]);
+      
+      pack::store( &out[i], (op_type::uses_out) ? op_type::template apply<pack>(pack::load(&out[i]), val) : val );
+      }
+    }
+  };
+
+
+
+//! entry points for the vectorised loops.
+//! each function returns false if it did not handle the given arguments
+//! (eg. element type or operation without a vectorised form, or too few elements),
+//! in which case the caller falls back to its generic loop
+class simd
+  {
+  public:
+  
+  template<typename eT>
+  struct worth
+    {
+    static const uword min_n_elem = 4 * simd_pack<eT>::width;
+    };
+  
+  static const uword mp_block_size = 4096;
+  
+  
+  // out op= eop(A, k), where the element accessor of A is not a plain pointer
+  template<typename eop_type, typename op_type, typename eT, typename ea_type>
+  arma_inline
+  static
+  bool
+  eop_apply(eT*, const ea_type&, const eT, const uword)
+    {
+    return false;
+    }
+  
+  
+  // out op= eop(A, k)
+  template<typename eop_type, typename op_type, typename eT>
+  arma_inline
+  static
+  bool
+  eop_apply(eT* out, const eT* A, const eT k, const uword n_elem)
+    {
+    static const bool use_simd = (simd_pack<eT>::available && simd_eop<eop_type>::available);
+    
+    return (n_elem >= worth<eT>::min_n_elem) && simd_engine<use_simd>::template eop_apply<eop_type, op_type>(out, A, k, n_elem);
+    }
+  
+  
+  // out op= eop(A, k) via several threads, where the element accessor of A is not a plain pointer
+  template<typename eop_type, typename op_type, typename eT, typename ea_type>
+  arma_inline
+  static
+  bool
+  eop_apply_mp(eT*, const ea_type&, const eT, const uword)
+    {
+    return false;
+    }
+  
+  
+  // out op= eop(A, k) via several threads;
+  // the elements are divided into blocks of mp_block_size, each of which is processed by the vectorised loop.
+  // the caller is expected to check mp_gate::eval() first
+  template<typename eop_type, typename op_type, typename eT>
+  inline
+  static
+  bool
+  eop_apply_mp(eT* out, const eT* A, const eT k, const uword n_elem)
+    {
+    static const bool use_simd = (simd_pack<eT>::available && simd_eop<eop_type>::available);
+    
+    if(use_simd == false)
+      {
+      return false;
+      }
+    
+    const uword n_blocks = (n_elem + mp_block_size - 1) / mp_block_size;
+    
+    arma_omp_pragma(omp parallel for schedule(static) num_threads(mp_gate::n_threads()))
+    for(uword block=0; block < n_blocks; ++block)
+      {
+      const uword start = block * mp_block_size;
+      const uword n     = ( (n_elem - start) < mp_block_size ) ? (n_elem - start) : uword(mp_block_size);
+      
+      simd_engine<use_simd>::template eop_apply<eop_type, op_type>(&out[start], &A[start], k, n);
+      }
+    
+    return true;
+    }
+  
+  
+  // out op= eglue(A, B), where the element accessor of A or B is not a plain pointer
+  template<typename eglue_type, typename op_type, typename eT, typename ea_type1, typename ea_type2>
+  arma_inline
+  static
+  bool
+  eglue_apply(eT*, const ea_type1&, const ea_type2&, const uword)
+    {
+    return false;
+    }
+  
+  
+  // out op= eglue(A, B)
+  template<typename eglue_type, typename op_type, typename eT>
+  arma_inline
+  static
+  bool
+  eglue_apply(eT* out, const eT* A, const eT* B, const uword n_elem)
+    {
+    static const bool use_simd = (simd_pack<eT>::available && simd_eglue<eglue_type>::available);
+    
+    return (n_elem >= worth<eT>::min_n_elem) && simd_engine<use_simd>::template eglue_apply<eglue_type, op_type>(out, A, B, n_elem);
+    }
+  
+  
+  // out op= eglue(A, B) via several threads, where the element accessor of A or B is not a plain pointer
+  template<typename eglue_type, typename op_type, typename eT, typename ea_type1, typename ea_type2>
+  arma_inline
+  static
+  bool
+  eglue_apply_mp(eT*, const ea_type1&, const ea_type2&, const uword)
+    {
+    return false;
+    }
+  
+  
+  // out op= eglue(A, B) via several threads; see eop_apply_mp()
+  template<typename eglue_type, typename op_type, typename eT>
+  inline
+  static
+  bool
+  eglue_apply_mp(eT* out, const eT* A, const eT* B, const uword n_elem)
+    {
+    static const bool use_simd = (simd_pack<eT>::available && simd_eglue<eglue_type>::available);
+    
+    if(use_simd == false)
+      {
+      return false;
+      }
+    
+    const uword n_blocks = (n_elem + mp_block_size - 1) / mp_block_size;
+    
+    arma_omp_pragma(omp parallel for schedule(static) num_threads(mp_gate::n_threads()))
+    for(uword block=0; block < n_blocks; ++block)
+      {
+      const uword start = block * mp_block_size;
+      const uword n     = ( (n_elem - start) < mp_block_size ) ? (n_elem - start) : uword(mp_block_size);
+      
+      simd_engine<use_simd>::template eglue_apply<eglue_type, op_type>(&out[start], &A[start], &B[start], n);
+      }
+    
+    return true;
+    }
+  
+  
+  // out op= A
+  template<typename op_type, typename eT>
+  arma_inline
+  static
+  bool
+  array_apply(eT* out, const eT* A, const uword n_elem)
+    {
+    return (n_elem >= worth<eT>::min_n_elem) && simd_engine< simd_pack<eT>::available >::template array_apply<op_type>(out, A, n_elem);
+    }
+  
+  
+  // out op= k
+  template<typename eop_type, typename eT>
+  arma_inline
+  static
+  bool
+  scalar_apply(eT* out, const eT k, const uword n_elem)
+    {
+    return simd::eop_apply<eop_type, simd_op_equ>(out, out, k, n_elem);
+    }
+  
+  
+  // out = sum(A)
+  template<bool compensated, typename eT>
+  arma_inline
+  static
+  bool
+  accumulate(eT& out, const eT* A, const uword n_elem)
+    {
+    return (n_elem >= worth<eT>::min_n_elem) && simd_engine< simd_pack<eT>::available >::template accumulate<compensated>(out, A, n_elem);
+    }
+  
+  
+  // out = sum(A % B)
+  template<bool compensated, typename eT>
+  arma_inline
+  static
+  bool
+  dot(eT& out, const eT* A, const eT* B, const uword n_elem)
+    {
+    return (n_elem >= worth<eT>::min_n_elem) && simd_engine< simd_pack<eT>::available >::template dot<compensated>(out, A, B, n_elem);
+    }
+  };
+
+
+
+//! @}
@@ -0,0 +1,497 @@
+// Copyright (C) 2012 NICTA (www.nicta.com.au)
+// Copyright (C) 2012 Conrad Sanderson
+// 
+// This file is part of the Armadillo C++ library.
+// It is provided without any warranty of fitness
+// for any purpose. You can redistribute this file
+// and/or modify it under the terms of the GNU
+// Lesser General Public License (LGPL) as published
+// by the Free Software Foundation, either version 3
+// of the License or (at your option) any later version.
+// (see http://www.opensource.org/licenses for more info)
+
+
+
+//! \addtogroup simd_math
+//! @{
+
+
+
+//! c[0] + c[1]*x + c[2]*x^2 + ... + c[N-1]*x^(N-1), where consecutive coefficients are S elements apart in memory.
+//! the polynomial is evaluated with Estrin's scheme (the even and odd terms are split recursively),
+//! which has a much shorter chain of dependent operations than Horner's rule
+template<uword N, uword S = 1>
+struct simd_estrin
+  {
+  template<typename pack>
+  arma_inline
+  static
+  typename pack::vec_type
+  eval(const typename pack::vec_type& x, const typename pack::elem_type* c)
+    {
+    const typename pack::vec_type x2 = pack::mul(x, x);
+    
+    return pack::add( simd_estrin<(N+1)/2, 2*S>::template eval<pack>(x2, c), pack::mul( x, simd_estrin<N/2, 2*S>::template eval<pack>(x2, c+S) ) );
+    }
+  };
+
+
+
+template<uword S>
+struct simd_estrin<2, S>
+  {
+  template<typename pack>
+  arma_inline
+  static
+  typename pack::vec_type
+  eval(const typename pack::vec_type& x, const typename pack::elem_type* c)
+    {
+    return pack::add( pack::fill(c[0]), pack::mul( x, pack::fill(c[S]) ) );
+    }
+  };
+
+
+
+template<uword S>
+struct simd_estrin<1, S>
+  {
+  template<typename pack>
+  arma_inline
+  static
+  typename pack::vec_type
+  eval(const typename pack::vec_type&, const typename pack::elem_type* c)
+    {
+    return pack::fill(c[0]);
+    }
+  };
+
+
+
+//! constants and polynomials used by simd_math, for each element type.
+//! the coefficients of the polynomials were obtained by interpolation at Chebyshev nodes (which is close to the minimax approximation),
+//! using enough terms for the approximation error to be well below the rounding error over the reduced argument ranges used by simd_math
+template<typename eT>
+struct simd_math_aux
+  {
+  };
+
+
+
+template<>
+struct simd_math_aux<double>
+  {
+  typedef double eT;
+  
+  arma_inline static eT round_magic()  { return 6755399441055744.0;   }  // 1.5 * 2^52
+  arma_inline static eT exponent_bias(){ return 1023.0;                }
+  
+  arma_inline static eT exp_min()      { return -708.0;                }
+  arma_inline static eT exp_max()      { return  709.0;                }
+  arma_inline static eT tanh_max()     { return   40.0;                }  // 2|x| above which tanh(x) rounds to +-1
+  arma_inline static eT trig_max()     { return 1.0e5;                 }
+  
+  arma_inline static eT log2e()        { return 1.4426950408889634;    }
+  arma_inline static eT ln2_hi()       { return 6.93147180369123816490e-01; }
+  arma_inline static eT ln2_lo()       { return 1.90821492927058770002e-10; }
+  arma_inline static eT sqrt2()        { return 1.4142135623730951;    }
+  
+  arma_inline static eT two_over_pi()  { return 0.6366197723675814;    }
+  arma_inline static eT pio2_1()       { return 1.5707963267923333;     }  // pi/2 = pio2_1 + pio2_2 + pio2_3 + pio2_4;
+  arma_inline static eT pio2_2()       { return 2.5633441515839558e-12; }  // the products of pio2_1, pio2_2 and pio2_3
+  arma_inline static eT pio2_3()       { return 1.0562999066944068e-23; }  // with integers below 2^16 are exact
+  arma_inline static eT pio2_4()       { return 4.3359050650618903e-35; }
+  
+  //! exp(x) - 1 for |x| <= log(2)/2
+  template<typename pack>
+  arma_inline
+  static
+  typename pack::vec_type
+  expm1_poly(const typename pack::vec_type& x)
+    {
+    static const eT c[] =
+      {
+      1.0, 0.5000000000000006, 0.1666666666666667, 0.041666666666573086,
+      0.008333333333326136, 0.0013888888932508548, 0.00019841269874815834, 2.4801504321690158e-05,
+      2.7557255406285044e-06, 2.7626367775723217e-07, 2.5105214474751413e-08
+      };
+    
+    // the two leading terms dominate the result, and are added last (Horner's rule) to keep the rounding error small
+    const typename pack::vec_type p = simd_estrin<9>::template eval<pack>(x, &c[2]);
+    
+    return pack::mul( x, pack::add( pack::fill(c[0]), pack::mul( x, pack::add( pack::fill(c[1]), pack::mul(x, p) ) ) ) );
+    }
+  
+  //! (log(1+f) - 2s) / s^3, where s = f/(2+f) and x = s^2 <= (3-2*sqrt(2))^2
+  template<typename pack>
+  arma_inline
+  static
+  typename pack::vec_type
+  log_poly(const typename pack::vec_type& x)
+    {
+    static const eT c[] =
+      {
+      0.666666666666667, 0.3999999999989819, 0.2857142862657045, 0.22222211037788164,
+      0.18182896185090186, 0.15331487192256463, 0.14619343908602436
+      };
+    
+    return simd_estrin<7>::template eval<pack>(x, c);
+    }
+  
+  //! (sin(r) - r) / r^3, where x = r^2 <= (pi/4)^2
+  template<typename pack>
+  arma_inline
+  static
+  typename pack::vec_type
+  sin_poly(const typename pack::vec_type& x)
+    {
+    static const eT c[] =
+      {
+      -0.16666666666666666, 0.008333333333330948, -0.00019841269836758574, 2.75573161025522e-06,
+      -2.505113184496499e-08, 1.5918129292589307e-10
+      };
+    
+    return simd_estrin<6>::template eval<pack>(x, c);
+    }
+  
+  //! (cos(r) - 1 + r^2/2) / r^4, where x = r^2 <= (pi/4)^2
+  template<typename pack>
+  arma_inline
+  static
+  typename pack::vec_type
+  cos_poly(const typename pack::vec_type& x)
+    {
+    static const eT c[] =
+      {
+      0.041666666666666664, -0.0013888888888887398, 2.480158729876569e-05, -2.7557317271729645e-07,
+      2.0876146268379033e-09, -1.1382632424097238e-11
+      };
+    
+    return simd_estrin<6>::template eval<pack>(x, c);
+    }
+  };
+
+
+
+template<>
+struct simd_math_aux<float>
+  {
+  typedef float eT;
+  
+  arma_inline static eT round_magic()  { return 12582912.0f;           }  // 1.5 * 2^23
+  arma_inline static eT exponent_bias(){ return 127.0f;                }
+  
+  arma_inline static eT exp_min()      { return -87.0f;                }
+  arma_inline static eT exp_max()      { return  88.0f;                }
+  arma_inline static eT tanh_max()     { return  20.0f;                }  // 2|x| above which tanh(x) rounds to +-1
+  arma_inline static eT trig_max()     { return 8192.0f;               }
+  
+  arma_inline static eT log2e()        { return 1.44269504f;           }
+  arma_inline static eT ln2_hi()       { return 0.693359375f;          }
+  arma_inline static eT ln2_lo()       { return -2.12194440e-4f;       }
+  arma_inline static eT sqrt2()        { return 1.41421356f;           }
+  
+  arma_inline static eT two_over_pi()  { return 0.636619772f;          }
+  arma_inline static eT pio2_1()       { return 1.5703125f;             }  // pi/2 = pio2_1 + pio2_2 + pio2_3 + pio2_4;
+  arma_inline static eT pio2_2()       { return 4.837512969970703e-4f;  }  // the products of pio2_1, pio2_2 and pio2_3
+  arma_inline static eT pio2_3()       { return 7.549533620476723e-8f;  }  // with integers below 2^13 are exact
+  arma_inline static eT pio2_4()       { return 2.5633440682570896e-12f; }
+  
+  template<typename pack>
+  arma_inline
+  static
+  typename pack::vec_type
+  expm1_poly(const typename pack::vec_type& x)
+    {
+    static const eT c[] =
+      {
+      1.0f, 0.5f, 0.16666504740715027f, 0.04166646674275398f,
+      0.008369154296815395f, 0.001393364742398262f
+      };
+    
+    // the two leading terms dominate the result, and are added last (Horner's rule) to keep the rounding error small
+    const typename pack::vec_type p = simd_estrin<4>::template eval<pack>(x, &c[2]);
+    
+    return pack::mul( x, pack::add( pack::fill(c[0]), pack::mul( x, pack::add( pack::fill(c[1]), pack::mul(x, p) ) ) ) );
+    }
+  
+  template<typename pack>
+  arma_inline
+  static
+  typename pack::vec_type
+  log_poly(const typename pack::vec_type& x)
+    {
+    static const eT c[] =
+      {
+      0.6666668653488159f, 0.3998873233795166f, 0.2958216071128845f
+      };
+    
+    return simd_estrin<3>::template eval<pack>(x, c);
+    }
+  
+  template<typename pack>
+  arma_inline
+  static
+  typename pack::vec_type
+  sin_poly(const typename pack::vec_type& x)
+    {
+    static const eT c[] =
+      {
+      -0.166666641831398f, 0.008332747966051102f, -0.00019587890710681677f
+      };
+    
+    return simd_estrin<3>::template eval<pack>(x, c);
+    }
+  
+  template<typename pack>
+  arma_inline
+  static
+  typename pack::vec_type
+  cos_poly(const typename pack::vec_type& x)
+    {
+    static const eT c[] =
+      {
+      0.0416666641831398f, -0.001388830249197781f, 2.454794230288826e-05f
+      };
+    
+    return simd_estrin<3>::template eval<pack>(x, c);
+    }
+  };
+
+
+
+
+//! vectorised approximations of exp(), log(), sin(), cos() and tanh(), used by the vectorised loops in simd_engine
+//! when ARMA_USE_SIMD_MATH is defined.
+//! each argument is reduced to a small range (eg. x = n*log(2) + r for exp()), where the function is evaluated by a polynomial.
+//! if any element of a vector is outside the range handled by the reduction (including NaN and infinities),
+//! the whole vector is processed by the scalar functions, so that overflow, underflow and special values are handled as in eop_aux
+template<typename pack>
+class simd_math
+  {
+  public:
+  
+  typedef typename pack::elem_type eT;
+  typedef typename pack::vec_type  vec_type;
+  typedef simd_math_aux<eT>        aux;
+  
+  
+  arma_hot
+  arma_inline
+  static
+  vec_type
+  exp(const vec_type& x)
+    {
+    if( pack::all_set( pack::and_( pack::cmp_ge(x, pack::fill(aux::exp_min())), pack::cmp_le(x, pack::fill(aux::exp_max())) ) ) == false )
+      {
+      return scalar<eop_exp>(x);
+      }
+    
+    vec_type n;
+    vec_type r;
+    
+    reduce_ln2(n, r, x);
+    
+    return pack::mul( pack::add( pack::fill(eT(1)), aux::template expm1_poly<pack>(r) ), pack::pow2i(n) );
+    }
+  
+  
+  arma_hot
+  arma_inline
+  static
+  vec_type
+  log(const vec_type& x)
+    {
+    if( pack::all_set( pack::and_( pack::cmp_ge(x, pack::fill(std::numeric_limits<eT>::min())), pack::cmp_le(x, pack::fill(std::numeric_limits<eT>::max())) ) ) == false )
+      {
+      return scalar<eop_log>(x);
+      }
+    
+    // x = m * 2^e, with m in [sqrt(0.5), sqrt(2))
+    
+    vec_type m = pack::or_( pack::andnot(pack::fill(-std::numeric_limits<eT>::infinity()), x), pack::fill(eT(1)) );
+    vec_type e = pack::sub( pack::exponent(x), pack::fill(aux::exponent_bias()) );
+    
+    const vec_type m_big = pack::cmp_gt(m, pack::fill(aux::sqrt2()));
+    
+    m = pack::select( m_big, pack::mul(m, pack::fill(eT(0.5))), m );
+    e = pack::add( e, pack::and_(m_big, pack::fill(eT(1))) );
+    
+    // log(m) = log(1+f) = f - (f^2/2 - s*(f^2/2 + R)), where s = f/(2+f)
+    
+    const vec_type f    = pack::sub(m, pack::fill(eT(1)));
+    const vec_type s    = pack::div(f, pack::add(f, pack::fill(eT(2))));
+    const vec_type z    = pack::mul(s, s);
+    const vec_type R    = pack::mul( z, aux::template log_poly<pack>(z) );
+    const vec_type hfsq = pack::mul( pack::mul(f, f), pack::fill(eT(0.5)) );
+    
+    const vec_type t = pack::add( pack::mul(s, pack::add(hfsq, R)), pack::mul(e, pack::fill(aux::ln2_lo())) );
+    
+    return pack::add( pack::mul(e, pack::fill(aux::ln2_hi())), pack::sub( f, pack::sub(hfsq, t) ) );
+    }
+  
+  
+  arma_hot
+  arma_inline
+  static
+  vec_type
+  sin(const vec_type& x)
+    {
+    return sin_cos<false>(x);
+    }
+  
+  
+  arma_hot
+  arma_inline
+  static
+  vec_type
+  cos(const vec_type& x)
+    {
+    return sin_cos<true>(x);
+    }
+  
+  
+  arma_hot
+  arma_inline
+  static
+  vec_type
+  tanh(const vec_type& x)
+    {
+    // tanh(|x|) = (exp(2|x|) - 1) / (exp(2|x|) + 1);
+    // as min() returns its second argument if either argument is NaN, NaN elements are kept
+    
+    const vec_type ax = pack::abs(x);
+    const vec_type a  = pack::min( pack::fill(aux::tanh_max()), pack::add(ax, ax) );
+    
+    vec_type n;
+    vec_type r;
+    
+    reduce_ln2(n, r, a);
+    
+    // exp(a) - 1 = 2^n * (exp(r) - 1) + (2^n - 1), which is accurate for small a
+    
+    const vec_type p   = pack::pow2i(n);
+    const vec_type em1 = pack::add( pack::mul(p, aux::template expm1_poly<pack>(r)), pack::sub(p, pack::fill(eT(1))) );
+    
+    const vec_type t = pack::div( em1, pack::add(em1, pack::fill(eT(2))) );
+    
+    return pack::or_( t, pack::and_(x, pack::fill(eT(-0.0))) );
+    }
+  
+  
+  private:
+  
+  //! integral value nearest to x, for |x| < 2^51 (double) or 2^22 (float)
+  arma_inline
+  static
+  vec_type
+  round(const vec_type& x)
+    {
+    return pack::sub( pack::add(x, pack::fill(aux::round_magic())), pack::fill(aux::round_magic()) );
+    }
+  
+  
+  //! x = n*log(2) + r, with integral n and |r| <= log(2)/2 (approximately)
+  arma_inline
+  static
+  void
+  reduce_ln2(vec_type& n, vec_type& r, const vec_type& x)
+    {
+    n = round( pack::mul(x, pack::fill(aux::log2e())) );
+    r = pack::sub( pack::sub(x, pack::mul(n, pack::fill(aux::ln2_hi()))), pack::mul(n, pack::fill(aux::ln2_lo())) );
+    }
+  
+  
+  template<bool is_cos>
+  arma_hot
+  arma_inline
+  static
+  vec_type
+  sin_cos(const vec_type& x)
+    {
+    if( pack::all_set( pack::cmp_le(pack::abs(x), pack::fill(aux::trig_max())) ) == false )
+      {
+      return (is_cos) ? scalar<eop_cos>(x) : scalar<eop_sin>(x);
+      }
+    
+    // |x| = q*pi/2 + r, with |r| <= pi/4
+    
+    const vec_type ax = pack::abs(x);
+    const vec_type q  = round( pack::mul(ax, pack::fill(aux::two_over_pi())) );
+    
+    vec_type r = pack::sub( ax, pack::mul(q, pack::fill(aux::pio2_1())) );
+    
+    r = pack::sub( r, pack::mul(q, pack::fill(aux::pio2_2())) );
+    r = pack::sub( r, pack::mul(q, pack::fill(aux::pio2_3())) );
+    r = pack::sub( r, pack::mul(q, pack::fill(aux::pio2_4())) );
+    
+    const vec_type z = pack::mul(r, r);
+    
+    const vec_type sin_r = pack::add( r, pack::mul( pack::mul(r, z), aux::template sin_poly<pack>(z) ) );
+    const vec_type cos_r = pack::sub( pack::fill(eT(1)), pack::sub( pack::mul(z, pack::fill(eT(0.5))), pack::mul( pack::mul(z, z), aux::template cos_poly<pack>(z) ) ) );
+    
+    // cos(x) = sin(|x| + pi/2) and sin(x) = sign(x) * sin(|x|); the quadrant (q mod 4) selects between +-sin(r) and +-cos(r)
+    
+    const vec_type qq = (is_cos) ? pack::add(q, pack::fill(eT(1))) : q;
+    
+    const vec_type quadrant = pack::sub( qq, pack::mul( pack::fill(eT(4)), round( pack::sub( pack::mul(qq, pack::fill(eT(0.25))), pack::fill(eT(0.375)) ) ) ) );
+    const vec_type odd      = pack::sub( quadrant, pack::mul( pack::fill(eT(2)), round( pack::sub( pack::mul(quadrant, pack::fill(eT(0.5))), pack::fill(eT(0.25)) ) ) ) );
+    
+    const vec_type val = pack::select( pack::cmp_gt(odd, pack::fill(eT(0.5))), cos_r, sin_r );
+    
+    const vec_type sign = pack::xor_( pack::and_( pack::cmp_gt(quadrant, pack::fill(eT(1.5))), pack::fill(eT(-0.0)) ), (is_cos) ? pack::zeros() : pack::and_(x, pack::fill(eT(-0.0))) );
+    
+    return pack::xor_(val, sign);
+    }
+  
+  
+  //! the scalar function applied to each element of x
+  template<typename eop_type>
+  inline
+  static
+  vec_type
+  scalar(const vec_type& x)
+    {
+    eT tmp[pack::width];
+    
+    pack::storeu(tmp, x);
+    
+    for(uword i=0; i < pack::width; ++i)
+      {
+      tmp[i] = eop_core<eop_type>::process(tmp[i], eT(0));
+      }
+    
+    return pack::loadu(tmp);
+    }
+  };
+
+
+
+#if defined(ARMA_USE_SIMD_MATH)
+
+#undef  arma_simd_eop_math
+#define arma_simd_eop_math(eop_type, function) \
+  template<>\
+  struct simd_eop<eop_type>\
+    {\
+    static const bool available = true;\
+    \
+    template<typename pack>\
+    arma_inline static typename pack::vec_type process(const typename pack::vec_type& val, const typename pack::vec_type&)\
+      {\
+      return simd_math<pack>::function(val);\
+      }\
+    };
+
+arma_simd_eop_math(eop_exp,  exp )
+arma_simd_eop_math(eop_log,  log )
+arma_simd_eop_math(eop_sin,  sin )
+arma_simd_eop_math(eop_cos,  cos )
+arma_simd_eop_math(eop_tanh, tanh)
+
+#undef arma_simd_eop_math
+
+#endif
+
+
+
+//! @}